@@ -0,0 +1,17 @@
+AC_DEFUN([PDNS_ENABLE_INLINE_DNSNAME_STORAGE],[
+  AC_MSG_CHECKING([whether to store DNS names inline])
+
+  AC_ARG_ENABLE([inline-dnsname-storage],
+    AS_HELP_STRING([--enable-inline-dnsname-storage],
+      [store the wire data of DNS names up to 55 bytes inside the DNSName object, trading memory for fewer allocations @<:@default=no@:>@]
+    ),
+    [enable_inline_dnsname_storage=$enableval],
+    [enable_inline_dnsname_storage=no]
+  )
+
+  AS_IF([test "x$enable_inline_dnsname_storage" != "xno"],
+    [AC_DEFINE([DNSNAME_INLINE_STORAGE], [1], [Define to 1 to store the wire data of short DNS names inside the DNSName object])]
+  )
+
+  AC_MSG_RESULT([$enable_inline_dnsname_storage])
+])
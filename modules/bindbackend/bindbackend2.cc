@@ -575,6 +575,7 @@ void Bind2Backend::parseZoneFile(BB2DomainInfo* bbd)
   ZoneParserTNG zpt(bbd->d_filename, bbd->d_name, s_binddirectory, d_upgradeContent);
   zpt.setMaxGenerateSteps(::arg().asNum("max-generate-steps"));
   zpt.setMaxIncludes(::arg().asNum("max-include-depth"));
+  zpt.setParallelThreads(d_parsingThreads);
   DNSResourceRecord rr;
   string hashed;
   while (zpt.get(rr)) {
@@ -589,7 +590,14 @@ void Bind2Backend::parseZoneFile(BB2DomainInfo* bbd)
   bbd->d_loaded = true;
   bbd->d_checknow = false;
   bbd->d_status = "parsed into memory at " + nowTime();
-  bbd->d_records = LookButDontTouch<recordstorage_t>(std::move(records));
+  if (d_compactStorage) {
+    bbd->d_compactRecords = LookButDontTouch<Bind2CompactRecords>(std::make_shared<Bind2CompactRecords>(*records));
+    bbd->d_records = LookButDontTouch<recordstorage_t>();
+  }
+  else {
+    bbd->d_records = LookButDontTouch<recordstorage_t>(std::move(records));
+    bbd->d_compactRecords = LookButDontTouch<Bind2CompactRecords>();
+  }
   bbd->d_nsec3zone = nsec3zone;
   bbd->d_nsec3param = std::move(ns3pr);
 }
@@ -686,6 +694,17 @@ string Bind2Backend::DLDomStatusHandler(const vector<string>& parts, Utility::pi
   return ret.str();
 }
 
+static size_t getDomainMemoryUsage(const BB2DomainInfo& info)
+{
+  if (auto compact = info.d_compactRecords.get()) {
+    return compact->getMemoryUsage();
+  }
+  if (auto records = info.d_records.get()) {
+    return getRecordStorageMemoryUsage(*records);
+  }
+  return 0;
+}
+
 static void printDomainExtendedStatus(ostringstream& ret, const BB2DomainInfo& info)
 {
   ret << info.d_name << ": " << std::endl;
@@ -712,7 +731,9 @@ static void printDomainExtendedStatus(ostringstream& ret, const BB2DomainInfo& i
   for (const auto& also : info.d_also_notify) {
     ret << "\t\t - " << also << std::endl;
   }
-  ret << "\t Number of records: " << info.d_records.getEntriesCount() << std::endl;
+  ret << "\t Number of records: " << info.d_records.getEntriesCount() + info.d_compactRecords.getEntriesCount() << std::endl;
+  ret << "\t Storage: " << (info.d_compactRecords.get() ? "compact" : "default") << std::endl;
+  ret << "\t Memory usage (estimated): " << getDomainMemoryUsage(info) << std::endl;
   ret << "\t Loaded: " << info.d_loaded << std::endl;
   ret << "\t Check now: " << info.d_checknow << std::endl;
   ret << "\t Check interval: " << info.getCheckInterval() << std::endl;
@@ -822,6 +843,8 @@ Bind2Backend::Bind2Backend(const string& suffix, bool loadZones)
   d_transaction_id = UnknownDomainID;
   s_ignore_broken_records = mustDo("ignore-broken-records");
   d_upgradeContent = ::arg().mustDo("upgrade-unknown-types");
+  d_compactStorage = mustDo("compact-storage");
+  d_parsingThreads = getArgAsNum("parsing-threads");
 
   if (!loadZones && d_hybrid)
     return;
@@ -1125,6 +1148,7 @@ void Bind2Backend::queueReloadAndStore(domainid_t id)
     /* make sure that nothing will be able to alter the existing records,
        we will load them from the zone file instead */
     bbnew.d_records = LookButDontTouch<recordstorage_t>();
+    bbnew.d_compactRecords = LookButDontTouch<Bind2CompactRecords>();
     parseZoneFile(&bbnew);
     bbnew.d_wasRejectedLastReload = false;
     safePutBBDomainInfo(bbnew);
@@ -1189,6 +1213,17 @@ bool Bind2Backend::getBeforeAndAfterNamesAbsolute(domainid_t id, const DNSName&
   if (!safeGetBBDomainInfo(id, &bbd))
     return false;
 
+  if (auto compact = bbd.d_compactRecords.get()) {
+    if (!bbd.d_nsec3zone) {
+      return compact->findBeforeAndAfterUnhashed(qname, before, after);
+    }
+    if (!compact->findBeforeAndAfterHashed(qname.toStringNoDot(), unhashed, before, after)) {
+      return false;
+    }
+    unhashed += bbd.d_name.operator const DNSName&();
+    return true;
+  }
+
   shared_ptr<const recordstorage_t> records = bbd.d_records.get();
   if (!bbd.d_nsec3zone) {
     return findBeforeAndAfterUnhashed(records, qname, unhashed, before, after);
@@ -1273,17 +1308,22 @@ void Bind2Backend::lookup(const QType& qtype, const DNSName& qname, domainid_t z
     throw DBException("Zone for '" + d_handle.domain.toLogString() + "' in '" + bbd.d_filename + "' not loaded (file missing, corrupt or primary dead)"); // fsck
   }
 
+  d_handle.mustlog = mustlog;
+  d_handle.d_list = false;
+
+  if ((d_handle.d_compact = bbd.d_compactRecords.get())) {
+    std::tie(d_handle.d_compact_pos, d_handle.d_compact_end) = d_handle.d_compact->equalRange(d_handle.qname);
+    return;
+  }
+
   d_handle.d_records = bbd.d_records.get();
 
   if (d_handle.d_records->empty())
     DLOG(g_log << "Query with no results" << endl);
 
-  d_handle.mustlog = mustlog;
-
   const auto& hashedidx = boost::multi_index::get<UnorderedNameTag>(*d_handle.d_records);
   auto range = hashedidx.equal_range(d_handle.qname);
 
-  d_handle.d_list = false;
   d_handle.d_iter = range.first;
   d_handle.d_end_iter = range.second;
 }
@@ -1295,7 +1335,7 @@ Bind2Backend::handle::handle()
 
 bool Bind2Backend::get(DNSResourceRecord& r)
 {
-  if (!d_handle.d_records) {
+  if (!d_handle.d_records && !d_handle.d_compact) {
     if (d_handle.mustlog)
       g_log << Logger::Warning << "There were no answers" << endl;
     return false;
@@ -1316,7 +1356,9 @@ bool Bind2Backend::get(DNSResourceRecord& r)
 
 bool Bind2Backend::handle::get(DNSResourceRecord& r)
 {
-  if (d_list)
+  if (d_compact)
+    return get_compact(r);
+  else if (d_list)
     return get_list(r);
   else
     return get_normal(r);
@@ -1325,6 +1367,7 @@ bool Bind2Backend::handle::get(DNSResourceRecord& r)
 void Bind2Backend::handle::reset()
 {
   d_records.reset();
+  d_compact.reset();
   qname.clear();
   mustlog = false;
 }
@@ -1379,9 +1422,17 @@ bool Bind2Backend::list(const ZoneName& /* target */, domainid_t domainId, bool
     throw PDNSException("zone was not loaded, perhaps because of: " + bbd.d_status);
   }
 
-  d_handle.d_records = bbd.d_records.get(); // give it a copy, which will stay around
-  d_handle.d_qname_iter = d_handle.d_records->begin();
-  d_handle.d_qname_end = d_handle.d_records->end(); // iter now points to a vector of pointers to vector<BBResourceRecords>
+  if ((d_handle.d_compact = bbd.d_compactRecords.get())) {
+    d_handle.d_compact_pos = 0;
+    d_handle.d_compact_end = d_handle.d_compact->size();
+    d_handle.d_compact_name_idx = 0;
+    d_handle.d_compact_name_end = 0;
+  }
+  else {
+    d_handle.d_records = bbd.d_records.get(); // give it a copy, which will stay around
+    d_handle.d_qname_iter = d_handle.d_records->begin();
+    d_handle.d_qname_end = d_handle.d_records->end(); // iter now points to a vector of pointers to vector<BBResourceRecords>
+  }
 
   d_handle.id = domainId;
   d_handle.domain = bbd.d_name;
@@ -1405,6 +1456,34 @@ bool Bind2Backend::handle::get_list(DNSResourceRecord& r)
   return false;
 }
 
+bool Bind2Backend::handle::get_compact(DNSResourceRecord& r)
+{
+  while (d_compact_pos != d_compact_end) {
+    if (d_list && d_compact_pos == d_compact_name_end) {
+      // entering the records of the next name
+      qname = d_compact->getName(d_compact_name_idx);
+      d_compact_name_end = d_compact->getNameRange(d_compact_name_idx).second;
+      d_compact_name_idx++;
+    }
+
+    const auto& record = d_compact->getRecord(d_compact_pos);
+    d_compact_pos++;
+    if (!d_list && !(qtype.getCode() == QType::ANY || record.qtype == qtype.getCode())) {
+      continue;
+    }
+
+    const DNSName& domainName(domain);
+    r.qname = qname.empty() ? domainName : (qname + domainName);
+    r.domain_id = id;
+    r.content = d_compact->getContent(record);
+    r.qtype = record.qtype;
+    r.ttl = record.ttl;
+    r.auth = record.auth;
+    return true;
+  }
+  return false;
+}
+
 bool Bind2Backend::autoPrimariesList(std::vector<AutoPrimary>& primaries)
 {
   if (getArg("autoprimary-config").empty())
@@ -1546,6 +1625,31 @@ bool Bind2Backend::searchRecords(const string& pattern, size_t maxResults, vecto
         continue;
       }
 
+      if (auto compact = h.d_compactRecords.get()) {
+        const DNSName& domainName(i.d_name);
+        for (uint32_t nameIdx = 0; result.size() < maxResults && nameIdx < compact->namesCount(); nameIdx++) {
+          DNSName relative = compact->getName(nameIdx);
+          DNSName name = relative.empty() ? domainName : (relative + domainName);
+          auto [first, last] = compact->getNameRange(nameIdx);
+          bool nameMatches = sm.match(name);
+          for (auto recordIdx = first; result.size() < maxResults && recordIdx != last; recordIdx++) {
+            const auto& record = compact->getRecord(recordIdx);
+            auto content = compact->getContent(record);
+            if (nameMatches || sm.match(std::string(content))) {
+              DNSResourceRecord r;
+              r.qname = name;
+              r.domain_id = i.d_id;
+              r.content = content;
+              r.qtype = record.qtype;
+              r.ttl = record.ttl;
+              r.auth = record.auth;
+              result.push_back(std::move(r));
+            }
+          }
+        }
+        continue;
+      }
+
       shared_ptr<const recordstorage_t> rhandle = h.d_records.get();
 
       for (recordstorage_t::const_iterator ri = rhandle->begin(); result.size() < maxResults && ri != rhandle->end(); ri++) {
@@ -1585,6 +1689,8 @@ public:
     declare(suffix, "dnssec-db", "Filename to store & access our DNSSEC metadatabase, empty for none", "");
     declare(suffix, "dnssec-db-journal-mode", "SQLite3 journal mode", "WAL");
     declare(suffix, "hybrid", "Store DNSSEC metadata in other backend", "no");
+    declare(suffix, "compact-storage", "Store the records of loaded zones in a compact, read-only form", "no");
+    declare(suffix, "parsing-threads", "Number of threads to parse large zone files with, 0 for one per CPU", "1");
   }
 
   DNSBackend* make(const string& suffix = "") override
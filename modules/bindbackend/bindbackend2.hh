@@ -103,6 +103,93 @@ typedef multi_index_container<
     ordered_non_unique<tag<NSEC3Tag>, member<Bind2DNSRecord, std::string, &Bind2DNSRecord::nsec3hash>>>>
   recordstorage_t;
 
+/** Immutable, compact alternative to recordstorage_t, built once per zone load
+    when bind-compact-storage is enabled.
+
+    Names are stored relative to the zone, in wire format, back to back in a
+    single buffer and sorted in canonical order. Records are kept in that same
+    order in a flat array, their content is deduplicated into a shared pool,
+    and exact name lookups go through an open addressing hash table of name
+    indexes instead of a node-based index. The NSEC3 index is a sorted array
+    of (hash, name) pairs.
+*/
+class Bind2CompactRecords
+{
+public:
+  struct Record
+  {
+    uint32_t contentOffset;
+    uint32_t contentLength;
+    uint32_t ttl;
+    uint16_t qtype;
+    bool auth;
+  };
+
+  Bind2CompactRecords(const recordstorage_t& records);
+
+  size_t size() const
+  {
+    return d_records.size();
+  }
+  size_t namesCount() const
+  {
+    return d_names.size();
+  }
+  const Record& getRecord(uint32_t recordIdx) const
+  {
+    return d_records.at(recordIdx);
+  }
+  std::string_view getContent(const Record& record) const
+  {
+    return std::string_view(d_pool).substr(record.contentOffset, record.contentLength);
+  }
+  //! Returns the [first, last) range of record indexes for this (relative) name, empty if it does not exist
+  std::pair<uint32_t, uint32_t> equalRange(const DNSName& qname) const;
+  //! Returns the [first, last) range of record indexes for the name at this index
+  std::pair<uint32_t, uint32_t> getNameRange(uint32_t nameIdx) const;
+  uint32_t getNameIndex(uint32_t recordIdx) const;
+  DNSName getName(uint32_t nameIdx) const;
+
+  bool findBeforeAndAfterUnhashed(const DNSName& qname, DNSName& before, DNSName& after) const;
+  bool findBeforeAndAfterHashed(const std::string& hash, DNSName& unhashed, DNSName& before, DNSName& after) const;
+
+  //! Number of bytes used by this object, including its heap allocations
+  size_t getMemoryUsage() const;
+
+private:
+  struct NameEntry
+  {
+    uint32_t offset; //!< into d_wireNames
+    uint32_t firstRecord; //!< into d_records
+  };
+  struct HashEntry
+  {
+    uint32_t offset; //!< into d_pool
+    uint32_t length;
+    uint32_t nameIdx;
+  };
+
+  std::string_view getWireName(uint32_t nameIdx) const;
+  std::string_view getHash(const HashEntry& entry) const
+  {
+    return std::string_view(d_pool).substr(entry.offset, entry.length);
+  }
+  uint32_t getFirstRecordIndex(uint32_t nameIdx) const
+  {
+    return nameIdx < d_names.size() ? d_names[nameIdx].firstRecord : d_records.size();
+  }
+
+  std::string d_wireNames;
+  std::string d_pool;
+  std::vector<NameEntry> d_names;
+  std::vector<Record> d_records;
+  std::vector<HashEntry> d_hashes;
+  std::vector<uint32_t> d_buckets; //!< name index + 1, 0 means empty, size is a power of two
+};
+
+/** Rough estimate of the memory used by a recordstorage_t, so that it can be compared to Bind2CompactRecords::getMemoryUsage() */
+size_t getRecordStorageMemoryUsage(const recordstorage_t& records);
+
 template <typename T>
 class LookButDontTouch
 {
@@ -113,7 +200,7 @@ public:
   {
   }
 
-  shared_ptr<const T> get()
+  shared_ptr<const T> get() const
   {
     return d_records;
   }
@@ -153,6 +240,7 @@ public:
   vector<ComboAddress> d_primaries; //!< IP address of the primary of this domain
   set<string> d_also_notify; //!< IP list of hosts to also notify
   LookButDontTouch<recordstorage_t> d_records; //!< the actual records belonging to this domain
+  LookButDontTouch<Bind2CompactRecords> d_compactRecords; //!< the records in compact form, replacing d_records if bind-compact-storage is set
   time_t d_ctime{0}; //!< last known ctime of the file on disk
   time_t d_lastcheck{0}; //!< last time domain was checked for freshness
   uint32_t d_lastnotified{0}; //!< Last serial number we notified our secondaries of
@@ -265,6 +353,10 @@ private:
 
     recordstorage_t::const_iterator d_qname_iter, d_qname_end;
 
+    shared_ptr<const Bind2CompactRecords> d_compact;
+    uint32_t d_compact_pos{0}, d_compact_end{0};
+    uint32_t d_compact_name_idx{0}, d_compact_name_end{0};
+
     DNSName qname;
     ZoneName domain;
 
@@ -276,6 +368,7 @@ private:
   private:
     bool get_normal(DNSResourceRecord&);
     bool get_list(DNSResourceRecord&);
+    bool get_compact(DNSResourceRecord&);
   };
 
   unique_ptr<SSqlStatement> d_getAllDomainMetadataQuery_stmt;
@@ -306,7 +399,9 @@ private:
   domainid_t d_transaction_id;
   static bool s_ignore_broken_records;
   bool d_hybrid;
+  size_t d_parsingThreads;
   bool d_upgradeContent;
+  bool d_compactStorage;
 
   BB2DomainInfo createDomainEntry(const ZoneName& domain, const string& filename); //!< does not insert in s_state
 
@@ -0,0 +1,281 @@
+/*
+ * This file is part of PowerDNS or dnsdist.
+ * Copyright -- PowerDNS.COM B.V. and its contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of version 2 of the GNU General Public License as
+ * published by the Free Software Foundation.
+ *
+ * In addition, for the avoidance of any doubt, permission is granted to
+ * link this program with OpenSSL and to (re)distribute the binaries
+ * produced as the result of such linking.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <algorithm>
+#include <unordered_map>
+
+#include "bindbackend2.hh"
+#include "pdns/burtle.hh"
+
+// Same ordering as DNSName::canonCompare_three_way(), but on raw wire format names
+static int canonCompareWire(std::string_view lhs, std::string_view rhs)
+{
+  std::array<uint8_t, 128> lhsPos{};
+  std::array<uint8_t, 128> rhsPos{};
+  size_t lhsCount = 0;
+  size_t rhsCount = 0;
+
+  for (size_t pos = 0; pos < lhs.size() && lhs[pos] != 0 && lhsCount < lhsPos.size(); pos += static_cast<uint8_t>(lhs[pos]) + 1) {
+    lhsPos.at(lhsCount++) = pos;
+  }
+  for (size_t pos = 0; pos < rhs.size() && rhs[pos] != 0 && rhsCount < rhsPos.size(); pos += static_cast<uint8_t>(rhs[pos]) + 1) {
+    rhsPos.at(rhsCount++) = pos;
+  }
+
+  for (;;) {
+    if (lhsCount == 0 && rhsCount != 0) {
+      return -1;
+    }
+    if (rhsCount == 0) {
+      return lhsCount == 0 ? 0 : 1;
+    }
+    lhsCount--;
+    rhsCount--;
+
+    auto lhsLabel = lhs.substr(lhsPos.at(lhsCount) + 1, static_cast<uint8_t>(lhs[lhsPos.at(lhsCount)]));
+    auto rhsLabel = rhs.substr(rhsPos.at(rhsCount) + 1, static_cast<uint8_t>(rhs[rhsPos.at(rhsCount)]));
+    if (int res = pdns_ilexicographical_compare_three_way(lhsLabel, rhsLabel); res != 0) {
+      return res;
+    }
+  }
+}
+
+static bool iequalsWire(std::string_view lhs, std::string_view rhs)
+{
+  if (lhs.size() != rhs.size()) {
+    return false;
+  }
+  for (size_t idx = 0; idx < lhs.size(); idx++) {
+    if (dns_tolower(lhs[idx]) != dns_tolower(rhs[idx])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+Bind2CompactRecords::Bind2CompactRecords(const recordstorage_t& records)
+{
+  if (records.size() >= std::numeric_limits<uint32_t>::max()) {
+    throw PDNSException("Too many records in zone for the compact storage");
+  }
+
+  std::unordered_map<std::string_view, uint32_t> contents;
+  d_records.reserve(records.size());
+
+  const DNSName* previous = nullptr;
+  for (const auto& bdr : records) {
+    /* records are sorted in canonical order, so records sharing a name are contiguous */
+    if (previous == nullptr || !(bdr.qname == *previous)) {
+      const auto& storage = bdr.qname.getStorage();
+      d_names.push_back({static_cast<uint32_t>(d_wireNames.size()), static_cast<uint32_t>(d_records.size())});
+      d_wireNames.append(storage.data(), storage.size());
+      previous = &bdr.qname;
+    }
+
+    Record record{};
+    auto [content, inserted] = contents.emplace(bdr.content, d_pool.size());
+    if (inserted) {
+      d_pool.append(bdr.content);
+    }
+    record.contentOffset = content->second;
+    record.contentLength = bdr.content.size();
+    record.ttl = bdr.ttl;
+    record.qtype = bdr.qtype;
+    record.auth = bdr.auth;
+    d_records.push_back(record);
+
+    if (!bdr.nsec3hash.empty()) {
+      d_hashes.push_back({static_cast<uint32_t>(d_pool.size()), static_cast<uint32_t>(bdr.nsec3hash.size()), static_cast<uint32_t>(d_names.size() - 1)});
+      d_pool.append(bdr.nsec3hash);
+    }
+    if (d_pool.size() >= std::numeric_limits<uint32_t>::max()) {
+      throw PDNSException("Zone content too large for the compact storage");
+    }
+  }
+
+  std::stable_sort(d_hashes.begin(), d_hashes.end(), [this](const HashEntry& lhs, const HashEntry& rhs) {
+    return getHash(lhs) < getHash(rhs);
+  });
+  /* every record of a given name carries the same hash, we only need one of them */
+  d_hashes.erase(std::unique(d_hashes.begin(), d_hashes.end(), [this](const HashEntry& lhs, const HashEntry& rhs) {
+                   return lhs.nameIdx == rhs.nameIdx && getHash(lhs) == getHash(rhs);
+                 }),
+                 d_hashes.end());
+
+  size_t bucketsCount = 16;
+  while (bucketsCount < d_names.size() * 2) {
+    bucketsCount *= 2;
+  }
+  d_buckets.resize(bucketsCount, 0);
+  const size_t mask = bucketsCount - 1;
+  for (uint32_t nameIdx = 0; nameIdx < d_names.size(); nameIdx++) {
+    size_t bucket = burtleCI(getWireName(nameIdx), 0) & mask;
+    while (d_buckets[bucket] != 0) {
+      bucket = (bucket + 1) & mask;
+    }
+    d_buckets[bucket] = nameIdx + 1;
+  }
+
+  d_wireNames.shrink_to_fit();
+  d_pool.shrink_to_fit();
+  d_names.shrink_to_fit();
+  d_hashes.shrink_to_fit();
+}
+
+std::string_view Bind2CompactRecords::getWireName(uint32_t nameIdx) const
+{
+  const auto start = d_names.at(nameIdx).offset;
+  const auto end = nameIdx + 1 < d_names.size() ? d_names.at(nameIdx + 1).offset : d_wireNames.size();
+  return std::string_view(d_wireNames).substr(start, end - start);
+}
+
+DNSName Bind2CompactRecords::getName(uint32_t nameIdx) const
+{
+  auto wire = getWireName(nameIdx);
+  if (wire.empty()) {
+    /* the zone apex */
+    return DNSName();
+  }
+  return DNSName(wire.data(), wire.size(), 0, false);
+}
+
+std::pair<uint32_t, uint32_t> Bind2CompactRecords::getNameRange(uint32_t nameIdx) const
+{
+  return {getFirstRecordIndex(nameIdx), getFirstRecordIndex(nameIdx + 1)};
+}
+
+uint32_t Bind2CompactRecords::getNameIndex(uint32_t recordIdx) const
+{
+  auto iter = std::upper_bound(d_names.begin(), d_names.end(), recordIdx, [](uint32_t idx, const NameEntry& entry) {
+    return idx < entry.firstRecord;
+  });
+  return std::distance(d_names.begin(), iter) - 1;
+}
+
+std::pair<uint32_t, uint32_t> Bind2CompactRecords::equalRange(const DNSName& qname) const
+{
+  const auto& storage = qname.getStorage();
+  const std::string_view wire(storage.data(), storage.size());
+  const size_t mask = d_buckets.size() - 1;
+
+  for (size_t bucket = burtleCI(wire, 0) & mask; d_buckets[bucket] != 0; bucket = (bucket + 1) & mask) {
+    uint32_t nameIdx = d_buckets[bucket] - 1;
+    if (iequalsWire(getWireName(nameIdx), wire)) {
+      return getNameRange(nameIdx);
+    }
+  }
+  return {0, 0};
+}
+
+bool Bind2CompactRecords::findBeforeAndAfterUnhashed(const DNSName& qname, DNSName& before, DNSName& after) const
+{
+  if (d_records.empty()) {
+    return false;
+  }
+
+  const auto& storage = qname.getStorage();
+  const std::string_view wire(storage.data(), storage.size());
+  auto nameIter = std::upper_bound(d_names.begin(), d_names.end(), wire, [this](std::string_view lhs, const NameEntry& entry) {
+    return canonCompareWire(lhs, getWireName(&entry - d_names.data())) < 0;
+  });
+  uint32_t iterBefore = getFirstRecordIndex(std::distance(d_names.begin(), nameIter));
+  uint32_t iterAfter = iterBefore;
+
+  auto skip = [](const Record& record) {
+    return (!record.auth && record.qtype != QType::NS) || record.qtype == 0;
+  };
+
+  if (iterBefore != 0) {
+    --iterBefore;
+  }
+  while (iterBefore != 0 && skip(d_records.at(iterBefore))) {
+    --iterBefore;
+  }
+  before = getName(getNameIndex(iterBefore));
+
+  if (iterAfter == d_records.size()) {
+    iterAfter = 0;
+  }
+  else {
+    while (skip(d_records.at(iterAfter))) {
+      ++iterAfter;
+      if (iterAfter == d_records.size()) {
+        iterAfter = 0;
+        break;
+      }
+    }
+  }
+  after = getName(getNameIndex(iterAfter));
+
+  return true;
+}
+
+bool Bind2CompactRecords::findBeforeAndAfterHashed(const std::string& hash, DNSName& unhashed, DNSName& before, DNSName& after) const
+{
+  if (d_hashes.empty()) {
+    return false;
+  }
+
+  auto iter = std::upper_bound(d_hashes.begin(), d_hashes.end(), std::string_view(hash), [this](std::string_view lhs, const HashEntry& entry) {
+    return lhs < getHash(entry);
+  });
+
+  if (iter == d_hashes.end()) {
+    --iter;
+    before = DNSName(std::string(getHash(*iter)));
+    after = DNSName(std::string(getHash(d_hashes.front())));
+  }
+  else {
+    after = DNSName(std::string(getHash(*iter)));
+    if (iter != d_hashes.begin()) {
+      --iter;
+    }
+    else {
+      iter = --d_hashes.end();
+    }
+    before = DNSName(std::string(getHash(*iter)));
+  }
+  unhashed = getName(iter->nameIdx);
+
+  return true;
+}
+
+size_t Bind2CompactRecords::getMemoryUsage() const
+{
+  return sizeof(*this) + d_wireNames.capacity() + d_pool.capacity() + d_names.capacity() * sizeof(NameEntry) + d_records.capacity() * sizeof(Record) + d_hashes.capacity() * sizeof(HashEntry) + d_buckets.capacity() * sizeof(uint32_t);
+}
+
+size_t getRecordStorageMemoryUsage(const recordstorage_t& records)
+{
+  /* knowingly approximate: each element lives in its own node, linked into two
+     ordered indexes (three pointers each) and one hashed index (two pointers),
+     and we count the name, content and hash as if they were all heap-allocated */
+  static const size_t nodeOverhead = 8 * sizeof(void*);
+  size_t result = sizeof(records);
+  for (const auto& record : records) {
+    result += sizeof(record) + nodeOverhead + record.qname.sizeEstimate() + record.content.size() + record.nsec3hash.size();
+  }
+  return result;
+}
@@ -311,6 +311,7 @@ static void declareArguments()
 
   ::arg().setSwitch("expand-alias", "Expand ALIAS records") = "no";
   ::arg().set("outgoing-axfr-expand-alias", "Expand ALIAS records during outgoing AXFR") = "no";
+  ::arg().setSwitch("outgoing-axfr-streaming", "Send the records of unsigned zones during outgoing AXFR as they are read from the backend, instead of collecting the whole zone first") = "no";
   ::arg().setSwitch("resolve-across-zones", "Resolve CNAME targets and other referrals across local zones") = "yes";
   ::arg().setSwitch("8bit-dns", "Allow 8bit dns queries") = "no";
 #ifdef HAVE_LUA_RECORDS
@@ -452,6 +453,8 @@ static void declareStats()
   S.declare("tcp6-queries", "Number of IPv6 TCP queries received");
   S.declare("tcp6-answers", "Number of IPv6 answers sent out over TCP");
 
+  S.declare("xfr-out-peak-records", "Highest number of records held in memory at once by a single outgoing AXFR", StatType::gauge);
+
   S.declare("open-tcp-connections", "Number of currently open TCP connections", getTCPConnectionCount, StatType::gauge);
 
   S.declare("qsize-q", "Number of questions waiting for database attention", getQCount, StatType::gauge);
@@ -738,6 +741,7 @@ static void mainthread()
   PacketHandler::s_SVCAutohints = ::arg().mustDo("svc-autohints");
 
   g_proxyProtocolACL.toMasks(::arg()["proxy-protocol-from"]);
+  g_proxyProtocolACL.compile();
   g_proxyProtocolMaximumSize = ::arg().asNum("proxy-protocol-maximum-size");
 
   if (::arg()["edns-cookie-secret"].size() != 0) {
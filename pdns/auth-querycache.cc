@@ -35,11 +35,13 @@ AuthQueryCache::AuthQueryCache(size_t mapsCount): d_maps(mapsCount), d_lastclean
 {
   S.declare("query-cache-hit","Number of hits on the query cache");
   S.declare("query-cache-miss","Number of misses on the query cache");
+  S.declare("query-cache-local-hit","Number of hits on the query cache that were served from a thread-local copy");
   S.declare("query-cache-size", "Number of entries in the query cache", StatType::gauge);
   S.declare("deferred-cache-inserts","Amount of cache inserts that were deferred because of maintenance");
   S.declare("deferred-cache-lookup","Amount of cache lookups that were deferred because of maintenance");
 
   d_statnumhit=S.getPointer("query-cache-hit");
+  d_statnumlocalhit=S.getPointer("query-cache-local-hit");
   d_statnummiss=S.getPointer("query-cache-miss");
   d_statnumentries=S.getPointer("query-cache-size");
 }
@@ -51,13 +53,67 @@ void AuthQueryCache::MapCombo::reserve(size_t numberOfEntries)
 #endif /* BOOST_VERSION >= 105600 */
 }
 
+AuthQueryCache::LocalCache::LocalCache(size_t size): d_size(size)
+{
+  // the size needs to be a power of two, and we only allocate on first use
+  if (d_size == 0 || (d_size & (d_size - 1)) != 0) {
+    throw std::invalid_argument("The size of a local query cache has to be a power of two");
+  }
+}
+
+AuthQueryCache::LocalCache::Entry& AuthQueryCache::LocalCache::getSlot(const DNSName& qname, uint16_t qtype, domainid_t zoneID)
+{
+  if (d_entries.empty()) {
+    d_entries.resize(d_size);
+  }
+  size_t hash = qname.hash(qtype);
+  hash ^= static_cast<size_t>(zoneID) * 0x9e3779b1U;
+  return d_entries[hash & (d_size - 1)];
+}
+
 // called from ueberbackend
 bool AuthQueryCache::getEntry(const DNSName &qname, const QType& qtype, vector<DNSZoneRecord>& value, domainid_t zoneID)
 {
   cleanupIfNeeded();
 
+  time_t now = time(nullptr);
+  return getSharedEntry(qname, qtype.getCode(), value, zoneID, now, nullptr);
+}
+
+bool AuthQueryCache::getEntry(LocalCache& local, const DNSName &qname, const QType& qtype, vector<DNSZoneRecord>& value, domainid_t zoneID)
+{
   time_t now = time(nullptr);
   uint16_t qt = qtype.getCode();
+  /* read the generation before looking into the shared cache, so that an entry we copy
+     while a purge is in progress is not considered valid afterwards */
+  uint64_t generation = d_generation.load();
+
+  auto& slot = local.getSlot(qname, qt, zoneID);
+  if (slot.generation == generation && slot.ttd >= now && slot.qtype == qt && slot.zoneID == zoneID && slot.qname == qname) {
+    value = slot.drs;
+    (*d_statnumhit)++;
+    (*d_statnumlocalhit)++;
+    return true;
+  }
+
+  cleanupIfNeeded();
+
+  time_t ttd{0};
+  if (!getSharedEntry(qname, qt, value, zoneID, now, &ttd)) {
+    return false;
+  }
+
+  slot.qname = qname;
+  slot.drs = value;
+  slot.ttd = ttd;
+  slot.generation = generation;
+  slot.qtype = qt;
+  slot.zoneID = zoneID;
+  return true;
+}
+
+bool AuthQueryCache::getSharedEntry(const DNSName &qname, uint16_t qtype, vector<DNSZoneRecord>& value, domainid_t zoneID, time_t now, time_t* ttd)
+{
   auto& mc = getMap(qname);
   {
     auto map = mc.d_map.try_read_lock();
@@ -66,7 +122,7 @@ bool AuthQueryCache::getEntry(const DNSName &qname, const QType& qtype, vector<D
       return false;
     }
 
-    return getEntryLocked(*map, qname, qt, value, zoneID, now);
+    return getEntryLocked(*map, qname, qtype, value, zoneID, now, ttd);
   }
 }
 
@@ -115,7 +171,26 @@ void AuthQueryCache::insert(const DNSName &qname, const QType& qtype, vector<DNS
   }
 }
 
-bool AuthQueryCache::getEntryLocked(const cmap_t& map, const DNSName &qname, uint16_t qtype, vector<DNSZoneRecord>& value, domainid_t zoneID, time_t now)
+void AuthQueryCache::insert(LocalCache& local, const DNSName &qname, const QType& qtype, vector<DNSZoneRecord>&& value, uint32_t ttl, domainid_t zoneID)
+{
+  if(!ttl) {
+    insert(qname, qtype, std::move(value), ttl, zoneID);
+    return;
+  }
+
+  uint64_t generation = d_generation.load();
+  auto& slot = local.getSlot(qname, qtype.getCode(), zoneID);
+  slot.qname = qname;
+  slot.drs = value;
+  slot.ttd = time(nullptr) + ttl;
+  slot.generation = generation;
+  slot.qtype = qtype.getCode();
+  slot.zoneID = zoneID;
+
+  insert(qname, qtype, std::move(value), ttl, zoneID);
+}
+
+bool AuthQueryCache::getEntryLocked(const cmap_t& map, const DNSName &qname, uint16_t qtype, vector<DNSZoneRecord>& value, domainid_t zoneID, time_t now, time_t* ttd)
 {
   auto& idx = boost::multi_index::get<HashTag>(map);
   auto iter = idx.find(std::tie(qname, qtype, zoneID));
@@ -131,6 +206,9 @@ bool AuthQueryCache::getEntryLocked(const cmap_t& map, const DNSName &qname, uin
   }
 
   value = iter->drs;
+  if (ttd != nullptr) {
+    *ttd = iter->ttd;
+  }
   (*d_statnumhit)++;
   return true;
 }
@@ -160,6 +238,7 @@ map<char,uint64_t> AuthQueryCache::getCounts()
 uint64_t AuthQueryCache::purge()
 {
   d_statnumentries->store(0);
+  ++d_generation;
 
   return purgeLockedCollectionsVector(d_maps);
 }
@@ -168,6 +247,7 @@ uint64_t AuthQueryCache::purgeExact(const DNSName& qname)
 {
   auto& mc = getMap(qname);
   uint64_t delcount = purgeExactLockedCollection<NameTag>(mc, qname);
+  ++d_generation;
 
   *d_statnumentries -= delcount;
 
@@ -182,6 +262,7 @@ uint64_t AuthQueryCache::purge(const string &match)
   if(boost::ends_with(match, "$")) {
     delcount = purgeLockedCollectionsVector<NameTag>(d_maps, match);
     *d_statnumentries -= delcount;
+    ++d_generation;
   }
   else {
     delcount = purgeExact(DNSName(match));
@@ -42,9 +42,39 @@ class AuthQueryCache : public boost::noncopyable
 public:
   AuthQueryCache(size_t mapsCount=1024);
 
+  /* A small direct-mapped cache, meant to be owned by a single thread and consulted
+     before the shared cache, so that hot entries can be served without taking any lock.
+     Entries carry the generation of the shared cache they were copied from, and are
+     ignored once the shared cache has been purged. */
+  class LocalCache
+  {
+  public:
+    LocalCache(size_t size = 4096);
+
+  private:
+    friend class AuthQueryCache;
+
+    struct Entry
+    {
+      DNSName qname;
+      vector<DNSZoneRecord> drs;
+      time_t ttd{0};
+      uint64_t generation{0};
+      uint16_t qtype{0};
+      domainid_t zoneID{UnknownDomainID};
+    };
+
+    Entry& getSlot(const DNSName& qname, uint16_t qtype, domainid_t zoneID);
+
+    vector<Entry> d_entries;
+    size_t d_size;
+  };
+
   void insert(const DNSName &qname, const QType& qtype, vector<DNSZoneRecord>&& value, uint32_t ttl, domainid_t zoneID);
+  void insert(LocalCache& local, const DNSName &qname, const QType& qtype, vector<DNSZoneRecord>&& value, uint32_t ttl, domainid_t zoneID);
 
   bool getEntry(const DNSName &qname, const QType& qtype, vector<DNSZoneRecord>& value, domainid_t zoneID);
+  bool getEntry(LocalCache& local, const DNSName &qname, const QType& qtype, vector<DNSZoneRecord>& value, domainid_t zoneID);
 
   size_t size() { return *d_statnumentries; } //!< number of entries in the cache
   void cleanup(); //!< force the cache to preen itself from expired queries
@@ -108,11 +138,14 @@ private:
     return d_maps[qname.hash() % d_maps.size()];
   }
 
-  bool getEntryLocked(const cmap_t& map, const DNSName &qname, uint16_t qtype, vector<DNSZoneRecord>& value, domainid_t zoneID, time_t now);
+  bool getEntryLocked(const cmap_t& map, const DNSName &qname, uint16_t qtype, vector<DNSZoneRecord>& value, domainid_t zoneID, time_t now, time_t* ttd = nullptr);
+  bool getSharedEntry(const DNSName &qname, uint16_t qtype, vector<DNSZoneRecord>& value, domainid_t zoneID, time_t now, time_t* ttd);
   void cleanupIfNeeded();
 
   AtomicCounter d_ops{0};
+  std::atomic<uint64_t> d_generation{1}; //!< bumped on every purge, invalidating the local caches
   AtomicCounter *d_statnumhit;
+  AtomicCounter *d_statnumlocalhit;
   AtomicCounter *d_statnummiss;
   AtomicCounter *d_statnumentries;
 
@@ -43,18 +43,21 @@ AuthZoneCache::AuthZoneCache(size_t mapsCount) :
   d_statnumentries = S.getPointer("zone-cache-size");
 }
 
-bool AuthZoneCache::getEntry(const ZoneName& zone, domainid_t& zoneId)
+bool AuthZoneCache::findEntry(const ZoneName& zone, domainid_t& zoneId)
 {
   auto& mc = getMap(zone);
-  bool found = false;
-  {
-    auto map = mc.d_map.read_lock();
-    auto iter = map->find(zone);
-    if (iter != map->end()) {
-      found = true;
-      zoneId = iter->second.zoneId;
-    }
+  auto map = mc.d_map.read_lock();
+  auto iter = map->find(zone);
+  if (iter == map->end()) {
+    return false;
   }
+  zoneId = iter->second.zoneId;
+  return true;
+}
+
+bool AuthZoneCache::getEntry(const ZoneName& zone, domainid_t& zoneId)
+{
+  bool found = findEntry(zone, zoneId);
 
   if (found) {
     (*d_statnumhit)++;
@@ -116,6 +119,49 @@ void AuthZoneCache::setZoneVariant(DNSPacket& packet)
   string variant = getVariantFromView(packet.qdomainzone, view);
   packet.qdomainzone.setVariant(variant);
 }
+
+bool AuthZoneCache::getClosestEntry(LocalStateHolder<ZoneSuffixTree>& tree, ZoneName& zone, domainid_t& zoneId, const std::string& view)
+{
+  DNSName name(zone.operator const DNSName&());
+
+  if (d_suffixesStale) {
+    // Zones were added or removed since the last replace(), which is the
+    // only place the tree is rebuilt. Probe every name in the maps instead.
+    do {
+      ZoneName candidate(name, getVariantFromView(ZoneName(name), view));
+      if (findEntry(candidate, zoneId)) {
+        zone = std::move(candidate);
+        (*d_statnumhit)++;
+        return true;
+      }
+    } while (name.chopOff());
+
+    (*d_statnummiss)++;
+    return false;
+  }
+
+  for (;;) {
+    const auto* suffix = tree->lookup(name);
+    if (suffix == nullptr) {
+      break;
+    }
+    // A zone exists at that name, but maybe not in the variant matching our view
+    std::string variant = getVariantFromView(ZoneName(suffix->zone), view);
+    if (auto iter = suffix->variants.find(variant); iter != suffix->variants.end()) {
+      zone = ZoneName(suffix->zone, variant);
+      zoneId = iter->second;
+      (*d_statnumhit)++;
+      return true;
+    }
+    name = suffix->zone;
+    if (!name.chopOff()) {
+      break;
+    }
+  }
+
+  (*d_statnummiss)++;
+  return false;
+}
 #endif // ] PDNS_AUTH
 
 bool AuthZoneCache::isEnabled() const
@@ -126,6 +172,11 @@ bool AuthZoneCache::isEnabled() const
 void AuthZoneCache::clear()
 {
   purgeLockedCollectionsVector(d_maps);
+  {
+    auto pending = d_pending.lock();
+    d_suffixes.setState(ZoneSuffixTree());
+    d_suffixesStale = false;
+  }
   {
     d_nets.write_lock()->clear();
   }
@@ -180,11 +231,20 @@ void AuthZoneCache::replace(const vector<std::tuple<ZoneName, domainid_t>>& zone
       }
     }
 
+    ZoneSuffixTree newTree;
+    for (const auto& map : newMaps) {
+      for (const auto& [zone, val] : map) {
+        addToSuffixTree(newTree, zone, val.zoneId);
+      }
+    }
+
     for (size_t mapIndex = 0; mapIndex < d_maps.size(); mapIndex++) {
       auto& mc = d_maps[mapIndex];
       auto map = mc.d_map.write_lock();
       *map = std::move(newMaps[mapIndex]);
     }
+    d_suffixes.setState(std::move(newTree));
+    d_suffixesStale = false;
 
     pending->d_pendingUpdates.clear();
     pending->d_replacePending = false;
@@ -215,6 +275,9 @@ void AuthZoneCache::add(const ZoneName& zone, const domainid_t zoneId)
     if (pending->d_replacePending) {
       pending->d_pendingUpdates.emplace_back(zone, zoneId, true);
     }
+    // Rebuilding the suffix tree for each added zone would make adding many
+    // zones quadratic, leave that to the next replace()
+    d_suffixesStale = true;
   }
 
   CacheValue val;
@@ -245,6 +308,7 @@ void AuthZoneCache::remove(const ZoneName& zone)
     if (pending->d_replacePending) {
       pending->d_pendingUpdates.emplace_back(zone, UnknownDomainID, false);
     }
+    d_suffixesStale = true;
   }
 
   auto mapIndex = getMapIndex(zone);
@@ -257,6 +321,19 @@ void AuthZoneCache::remove(const ZoneName& zone)
   }
 }
 
+void AuthZoneCache::addToSuffixTree(ZoneSuffixTree& tree, const ZoneName& zone, domainid_t zoneId)
+{
+  const DNSName& name = zone.operator const DNSName&();
+  ZoneSuffix suffix;
+  // lookup() returns the closest match, which is only ours if it has the exact same name
+  if (const auto* existing = tree.lookup(name); existing != nullptr && existing->zone == name) {
+    suffix = *existing;
+  }
+  suffix.zone = name;
+  suffix.variants[zone.getVariant()] = zoneId;
+  tree.add(name, std::move(suffix));
+}
+
 void AuthZoneCache::setReplacePending()
 {
   if (!d_refreshinterval)
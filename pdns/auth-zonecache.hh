@@ -20,12 +20,14 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 #pragma once
+#include <atomic>
 #include <string>
 #include <unordered_map>
 #include <vector>
 #include "dnsname.hh"
 #include "lock.hh"
 #include "misc.hh"
+#include "sholder.hh"
 #include "iputils.hh"
 #include "dnspacket.hh"
 
@@ -36,6 +38,13 @@ public:
 
   using ViewsMap = std::map<std::string, std::map<DNSName, std::string>>;
 
+  struct ZoneSuffix
+  {
+    DNSName zone;
+    std::map<std::string, domainid_t> variants; //!< zone id for each variant of this zone, the empty variant being the zone itself
+  };
+  using ZoneSuffixTree = SuffixMatchTree<ZoneSuffix>;
+
   // Zone maintainance
   void replace(const vector<std::tuple<ZoneName, domainid_t>>& zone);
   void replace(NetmaskTree<string> nettree);
@@ -53,6 +62,12 @@ public:
 
   // Zone lookup
   bool getEntry(const ZoneName& zone, domainid_t& zoneId);
+  //! Finds the closest zone enclosing (or equal to) zone, visible from view. Only takes a lock when the set of zones has changed since the last call with this tree, and probes every name in the maps if zones were added or removed since the last replace().
+  bool getClosestEntry(LocalStateHolder<ZoneSuffixTree>& tree, ZoneName& zone, domainid_t& zoneId, const std::string& view);
+  LocalStateHolder<ZoneSuffixTree> getLocalSuffixTree()
+  {
+    return d_suffixes.getLocal();
+  }
 
   // View lookup
   std::string getViewFromNetwork(Netmask* net);
@@ -100,6 +115,11 @@ private:
   };
 
   vector<MapCombo> d_maps;
+  GlobalStateHolder<ZoneSuffixTree> d_suffixes;
+  std::atomic<bool> d_suffixesStale{false}; //!< set by add() and remove(), d_suffixes is only rebuilt by replace()
+
+  static void addToSuffixTree(ZoneSuffixTree& tree, const ZoneName& zone, domainid_t zoneId);
+  bool findEntry(const ZoneName& zone, domainid_t& zoneId);
   size_t getMapIndex(const ZoneName& zone)
   {
     return zone.hash() % d_maps.size();
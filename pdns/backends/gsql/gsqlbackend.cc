@@ -31,11 +31,14 @@
 #include "pdns/arguments.hh"
 #include "pdns/base32.hh"
 #include "pdns/dnssecinfra.hh"
+#include "pdns/statbag.hh"
 #include <boost/algorithm/string.hpp>
 #include <sstream>
 #include <boost/format.hpp>
 #include <boost/scoped_ptr.hpp>
 
+extern StatBag S;
+
 #define ASSERT_ROW_COLUMNS(query, row, num) { if (row.size() != num) { throw PDNSException(std::string(query) + " returned wrong number of columns, expected "  #num  ", got " + std::to_string(row.size())); } }
 
 GSQLBackend::GSQLBackend(const string &mode, const string &suffix)
@@ -62,6 +65,7 @@ GSQLBackend::GSQLBackend(const string &mode, const string &suffix)
   d_IdQuery=getArg("id-query");
   d_ANYNoIdQuery=getArg("any-query");
   d_ANYIdQuery=getArg("any-id-query");
+  d_GetAuthQuery=getArg("get-auth-query");
 
   d_APIIdQuery=getArg("api-id-query");
   d_APIANYIdQuery=getArg("api-any-id-query");
@@ -143,6 +147,7 @@ GSQLBackend::GSQLBackend(const string &mode, const string &suffix)
   d_IdQuery_stmt = nullptr;
   d_ANYNoIdQuery_stmt = nullptr;
   d_ANYIdQuery_stmt = nullptr;
+  d_GetAuthQuery_stmt = nullptr;
   d_APIIdQuery_stmt = nullptr;
   d_APIANYIdQuery_stmt = nullptr;
   d_listQuery_stmt = nullptr;
@@ -1463,6 +1468,79 @@ void GSQLBackend::lookup(const QType& qtype, const DNSName& qname, domainid_t do
   d_qname=qname;
 }
 
+/* Instead of being asked for the SOA of each shorter name in turn, look up
+   all the names target is part of in one go, s_getAuthQueryNames at a time,
+   and return the closest enclosing zone. UeberBackend::getAuth() knows it will
+   not have to ask us again for the names between target and that zone. */
+bool GSQLBackend::getAuth(const ZoneName& target, SOAData* soaData)
+{
+  if (d_GetAuthQuery.empty() || target.hasVariant()) {
+    return DNSBackend::getAuth(target, soaData);
+  }
+
+  vector<DNSName> names;
+  DNSName shorter(target.operator const DNSName&());
+  do {
+    names.push_back(shorter);
+  } while (shorter.chopOff());
+
+  try {
+    reconnectIfNeeded();
+
+    for (auto batch = names.cbegin(); batch != names.cend();) {
+      auto batchEnd = names.cend() - batch > static_cast<ptrdiff_t>(s_getAuthQueryNames) ? batch + s_getAuthQueryNames : names.cend();
+
+      for (size_t idx = 0; idx < s_getAuthQueryNames; ++idx) {
+        // unused parameters get the last name of the batch again
+        const auto& name = batch + idx < batchEnd ? *(batch + idx) : *(batchEnd - 1);
+        d_GetAuthQuery_stmt->bind("qname" + std::to_string(idx + 1), name);
+      }
+      d_GetAuthQuery_stmt->execute();
+      S.inc("backend-queries");
+
+      d_qname.clear();
+      DNSResourceRecord best;
+      SSqlStatement::row_t row;
+      while (d_GetAuthQuery_stmt->hasNextRow()) {
+        d_GetAuthQuery_stmt->nextRow(row);
+        ASSERT_ROW_COLUMNS("get-auth-query", row, 8);
+        DNSResourceRecord resourceRecord;
+        try {
+          extractRecord(row, resourceRecord);
+        }
+        catch (const PDNSException& e) {
+          g_log << Logger::Warning << __PRETTY_FUNCTION__ << " skipping invalid record for '" << row[6] << "' while looking for the zone of '" << target.toLogString() << "': " << e.reason << endl;
+          continue;
+        }
+        catch (const std::exception& e) {
+          g_log << Logger::Warning << __PRETTY_FUNCTION__ << " skipping invalid record for '" << row[6] << "' while looking for the zone of '" << target.toLogString() << "': " << e.what() << endl;
+          continue;
+        }
+        if (resourceRecord.qtype == QType::SOA && (best.qname.empty() || best.qname.countLabels() < resourceRecord.qname.countLabels())) {
+          best = std::move(resourceRecord);
+        }
+      }
+      d_GetAuthQuery_stmt->reset();
+
+      if (!best.qname.empty()) {
+        soaData->zonename = ZoneName(best.qname).makeLowerCase();
+        soaData->ttl = best.ttl;
+        soaData->db = this;
+        soaData->domain_id = best.domain_id;
+        fillSOAData(best.content, *soaData);
+        return true;
+      }
+
+      batch = batchEnd;
+    }
+  }
+  catch (SSqlException &e) {
+    throw PDNSException("GSQLBackend unable to get the zone of '" + target.toLogString() + "': " + e.txtReason());
+  }
+
+  return false;
+}
+
 void GSQLBackend::APILookup(const QType& qtype, const DNSName& qname, domainid_t domain_id, bool include_disabled)
 {
   try {
@@ -59,6 +59,7 @@ protected:
       d_IdQuery_stmt = d_db->prepare(d_IdQuery, 3);
       d_ANYNoIdQuery_stmt = d_db->prepare(d_ANYNoIdQuery, 1);
       d_ANYIdQuery_stmt = d_db->prepare(d_ANYIdQuery, 2);
+      d_GetAuthQuery_stmt = d_db->prepare(d_GetAuthQuery, s_getAuthQueryNames);
       d_APIIdQuery_stmt = d_db->prepare(d_APIIdQuery, 4);
       d_APIANYIdQuery_stmt = d_db->prepare(d_APIANYIdQuery, 3);
       d_listQuery_stmt = d_db->prepare(d_listQuery, 2);
@@ -131,6 +132,7 @@ protected:
     d_IdQuery_stmt.reset();
     d_ANYNoIdQuery_stmt.reset();
     d_ANYIdQuery_stmt.reset();
+    d_GetAuthQuery_stmt.reset();
     d_APIIdQuery_stmt.reset();
     d_APIANYIdQuery_stmt.reset();
     d_listQuery_stmt.reset();
@@ -203,6 +205,9 @@ public:
   void APILookup(const QType &qtype, const DNSName &qname, domainid_t domain_id, bool include_disabled = false) override;
   bool list(const ZoneName &target, domainid_t domain_id, bool include_disabled=false) override;
   bool get(DNSResourceRecord &r) override;
+  bool getAuth(const ZoneName& target, SOAData* soaData) override;
+  //! Number of names get-auth-query looks up at once
+  static constexpr size_t s_getAuthQueryNames = 8;
   void getAllDomains(vector<DomainInfo>* domains, bool getSerial, bool include_disabled) override;
   bool startTransaction(const ZoneName &domain, domainid_t domain_id=UnknownDomainID) override;
   bool commitTransaction() override;
@@ -298,6 +303,7 @@ private:
   string d_IdQuery;
   string d_ANYNoIdQuery;
   string d_ANYIdQuery;
+  string d_GetAuthQuery;
 
   string d_APIIdQuery;
   string d_APIANYIdQuery;
@@ -383,6 +389,7 @@ private:
   unique_ptr<SSqlStatement> d_IdQuery_stmt;
   unique_ptr<SSqlStatement> d_ANYNoIdQuery_stmt;
   unique_ptr<SSqlStatement> d_ANYIdQuery_stmt;
+  unique_ptr<SSqlStatement> d_GetAuthQuery_stmt;
   unique_ptr<SSqlStatement> d_APIIdQuery_stmt;
   unique_ptr<SSqlStatement> d_APIANYIdQuery_stmt;
   unique_ptr<SSqlStatement> d_listQuery_stmt;
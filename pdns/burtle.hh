@@ -22,6 +22,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cinttypes>
 
 inline void burtlemix(uint32_t& a, uint32_t& b, uint32_t& c)
@@ -117,9 +118,18 @@ inline uint32_t burtle(const unsigned char* k, uint32_t length, uint32_t initval
   return c;
 }
 
+/* Lowercases up to 8 bytes and returns them as a little-endian word, the first byte being the least significant one,
+   which is the order in which burtle() consumes the key. */
+inline uint64_t burtleLoadLower(const unsigned char* k, size_t len)
+{
+  return dns_tolower8(dns_loadpartial8(k, len));
+}
+
+/* Same as burtle() on the lowercased key, without copying it */
 inline uint32_t burtleCI(const unsigned char* k, uint32_t length, uint32_t initval)
 {
   uint32_t a, b, c, len;
+  uint64_t word;
 
   /* Set up the internal state */
   len = length;
@@ -128,9 +138,10 @@ inline uint32_t burtleCI(const unsigned char* k, uint32_t length, uint32_t initv
 
   /*---------------------------------------- handle most of the key */
   while (len >= 12) {
-    a += (dns_tolower(k[0]) + ((uint32_t)dns_tolower(k[1]) << 8) + ((uint32_t)dns_tolower(k[2]) << 16) + ((uint32_t)dns_tolower(k[3]) << 24));
-    b += (dns_tolower(k[4]) + ((uint32_t)dns_tolower(k[5]) << 8) + ((uint32_t)dns_tolower(k[6]) << 16) + ((uint32_t)dns_tolower(k[7]) << 24));
-    c += (dns_tolower(k[8]) + ((uint32_t)dns_tolower(k[9]) << 8) + ((uint32_t)dns_tolower(k[10]) << 16) + ((uint32_t)dns_tolower(k[11]) << 24));
+    word = burtleLoadLower(k, 8);
+    a += static_cast<uint32_t>(word);
+    b += static_cast<uint32_t>(word >> 32);
+    c += static_cast<uint32_t>(burtleLoadLower(k + 8, 4));
     burtlemix(a, b, c);
     k += 12;
     len -= 12;
@@ -138,41 +149,14 @@ inline uint32_t burtleCI(const unsigned char* k, uint32_t length, uint32_t initv
 
   /*------------------------------------- handle the last 11 bytes */
   c += length;
-  switch (len) { /* all the case statements fall through */
-  case 11:
-    c += ((uint32_t)dns_tolower(k[10]) << 24);
-    /* fall-through */
-  case 10:
-    c += ((uint32_t)dns_tolower(k[9]) << 16);
-    /* fall-through */
-  case 9:
-    c += ((uint32_t)dns_tolower(k[8]) << 8);
+  if (len > 8) {
     /* the first byte of c is reserved for the length */
-    /* fall-through */
-  case 8:
-    b += ((uint32_t)dns_tolower(k[7]) << 24);
-    /* fall-through */
-  case 7:
-    b += ((uint32_t)dns_tolower(k[6]) << 16);
-    /* fall-through */
-  case 6:
-    b += ((uint32_t)dns_tolower(k[5]) << 8);
-    /* fall-through */
-  case 5:
-    b += dns_tolower(k[4]);
-    /* fall-through */
-  case 4:
-    a += ((uint32_t)dns_tolower(k[3]) << 24);
-    /* fall-through */
-  case 3:
-    a += ((uint32_t)dns_tolower(k[2]) << 16);
-    /* fall-through */
-  case 2:
-    a += ((uint32_t)dns_tolower(k[1]) << 8);
-    /* fall-through */
-  case 1:
-    a += dns_tolower(k[0]);
-    /* case 0: nothing left to add */
+    c += static_cast<uint32_t>(burtleLoadLower(k + 8, len - 8) << 8);
+  }
+  if (len > 0) {
+    word = burtleLoadLower(k, std::min(len, static_cast<uint32_t>(8)));
+    a += static_cast<uint32_t>(word);
+    b += static_cast<uint32_t>(word >> 32);
   }
   burtlemix(a, b, c);
   /*-------------------------------------------- report the result */
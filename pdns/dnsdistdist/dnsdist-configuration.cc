@@ -35,9 +35,24 @@ const RuntimeConfiguration& getCurrentRuntimeConfiguration()
   return *t_threadLocalConfiguration;
 }
 
+static void compileACLs(RuntimeConfiguration& config)
+{
+  /* these are checked for every incoming query, and compiling is a no-op when they did not change.
+     Very large ACLs are not compiled and keep using the tree */
+  config.d_ACL.compile();
+  config.d_proxyProtocolACL.compile();
+}
+
 void updateRuntimeConfiguration(const std::function<void(RuntimeConfiguration&)>& mutator)
 {
-  s_currentRuntimeConfiguration.modify(mutator);
+  s_currentRuntimeConfiguration.modify([&mutator](RuntimeConfiguration& config) {
+    mutator(config);
+    /* the configuration file usually adds ACL entries one by one, so only compile them
+       once it has been fully parsed */
+    if (isImmutableConfigurationDone()) {
+      compileACLs(config);
+    }
+  });
 }
 
 void updateImmutableConfiguration(const std::function<void(ImmutableConfiguration&)>& mutator)
@@ -64,5 +79,6 @@ void setImmutableConfigurationDone()
   if (s_immutableConfigurationDone.exchange(true)) {
     throw std::runtime_error("Trying to seal the runtime-immutable configuration a second time");
   }
+  s_currentRuntimeConfiguration.modify(compileACLs);
 }
 }
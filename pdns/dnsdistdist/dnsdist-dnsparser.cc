@@ -31,29 +31,18 @@ DNSPacketOverlay::DNSPacketOverlay(const std::string_view& packet)
   }
 
   memcpy(&d_header, packet.data(), sizeof(dnsheader));
-  uint64_t numRecords = ntohs(d_header.ancount) + ntohs(d_header.nscount) + ntohs(d_header.arcount);
-  d_records.reserve(numRecords);
 
   try {
-    PacketReader reader(std::string_view(reinterpret_cast<const char*>(packet.data()), packet.size()));
-
-    for (uint16_t n = 0; n < ntohs(d_header.qdcount); ++n) {
-      reader.xfrName(d_qname);
-      reader.xfrType(d_qtype);
-      reader.xfrType(d_qclass);
+    DNSMessageView view(false, packet);
+    if (view.hasQuestion()) {
+      d_qname = view.getQName();
+      d_qtype = view.getQType();
+      d_qclass = view.getQClass();
     }
 
-    for (uint64_t n = 0; n < numRecords; ++n) {
-      Record rec;
-      reader.xfrName(rec.d_name);
-      rec.d_place = n < ntohs(d_header.ancount) ? DNSResourceRecord::ANSWER : (n < (ntohs(d_header.ancount) + ntohs(d_header.nscount)) ? DNSResourceRecord::AUTHORITY : DNSResourceRecord::ADDITIONAL);
-      reader.xfrType(rec.d_type);
-      reader.xfrType(rec.d_class);
-      reader.xfr32BitInt(rec.d_ttl);
-      reader.xfr16BitInt(rec.d_contentLength);
-      rec.d_contentOffset = reader.getPosition();
-      reader.skip(rec.d_contentLength);
-      d_records.push_back(std::move(rec));
+    d_records.reserve(view.getRecords().size());
+    for (const auto& record : view.getRecords()) {
+      d_records.push_back({view.getName(record.d_nameOffset), record.d_ttl, record.d_type, record.d_class, record.d_contentLength, record.d_contentOffset, record.d_place});
     }
   }
   catch (const std::exception& e) {
@@ -227,6 +227,7 @@ public:
   NetmaskGroupRule(const NetmaskGroup& nmg, bool src, bool quiet = false) :
     d_nmg(nmg)
   {
+    d_nmg.compile();
     d_src = src;
     d_quiet = quiet;
   }
@@ -624,6 +625,7 @@ public:
   SuffixMatchNodeRule(const SuffixMatchNode& smn, bool quiet = false) :
     d_smn(smn), d_quiet(quiet)
   {
+    d_smn.compile();
   }
   bool matches(const DNSQuestion* dq) const override
   {
@@ -157,7 +157,7 @@ void TCPConnectionToBackend::release(bool removeFromCache)
   }
 }
 
-static uint32_t getSerialFromRawSOAContent(const std::vector<uint8_t>& raw)
+static uint32_t getSerialFromRawSOAContent(const std::string_view& raw)
 {
   /* minimal size for a SOA record, as defined by rfc1035:
      MNAME (root): 1
@@ -201,7 +201,8 @@ static bool getSerialFromIXFRQuery(TCPQuery& query)
         return false;
       }
       const auto& raw = unknownContent->getRawContent();
-      query.d_ixfrQuerySerial = getSerialFromRawSOAContent(raw);
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+      query.d_ixfrQuerySerial = getSerialFromRawSOAContent(std::string_view(reinterpret_cast<const char*>(raw.data()), raw.size()));
       return true;
     }
   }
@@ -814,23 +815,23 @@ bool TCPConnectionToBackend::isXFRFinished(const TCPResponse& response, TCPQuery
   bool done = false;
 
   try {
-    MOADNSParser parser(true, reinterpret_cast<const char*>(response.d_buffer.data()), response.d_buffer.size());
-
-    if (parser.d_header.rcode != 0U) {
+    /* XFR messages can be large, and we only care about the content of the SOA records */
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    DNSMessageView view(true, std::string_view(reinterpret_cast<const char*>(response.d_buffer.data()), response.d_buffer.size()));
+    if (view.getHeader().rcode != 0U) {
       done = true;
     }
     else {
-      for (const auto& record : parser.d_answers) {
+      for (const auto& record : view.getRecords()) {
         if (record.d_class != QClass::IN || record.d_type != QType::SOA) {
           continue;
         }
 
-        auto unknownContent = getRR<UnknownRecordContent>(record);
-        if (!unknownContent) {
+        /* SOA records in the authority section of IXFR messages are ignored */
+        if (view.getQType() == QType::IXFR && record.d_place == DNSResourceRecord::AUTHORITY) {
           continue;
         }
-        const auto& raw = unknownContent->getRawContent();
-        auto serial = getSerialFromRawSOAContent(raw);
+        auto serial = getSerialFromRawSOAContent(view.getRawContent(record));
         if (query.d_xfrPrimarySerial == 0) {
           // store the first SOA in our client's connection metadata
           query.d_xfrPrimarySerial = serial;
@@ -23,8 +23,10 @@
 #include <boost/format.hpp>
 #include <string>
 #include <cinttypes>
+#include <unordered_map>
 
 #include "dnswriter.hh"
+#include "lock.hh"
 #include "misc.hh"
 
 #include <boost/functional/hash.hpp>
@@ -82,7 +84,7 @@ DNSName::DNSName(const std::string_view sw)
       unsigned char labellen=0;
       const char* const pbegin=p, *pend=p+length;
 
-      d_storage.reserve(length+1);
+      d_storage.reserve(length + 2); // one more length byte than there are dots, and the root label
       for(auto iter = pbegin; iter != pend; ) {
         lenpos = d_storage.size();
         if(*iter=='.')
@@ -823,6 +825,102 @@ bool DNSName::RawLabelsVisitor::empty() const
   return d_position == 0;
 }
 
+const DNSName InternedDNSName::s_emptyName;
+
+namespace
+{
+struct InternedNamesShard
+{
+  // the keys point to the storage of the name of the entry they are associated with
+  std::unordered_map<std::string_view, InternedDNSName::Entry*> d_names;
+};
+
+constexpr size_t s_internedNamesShards = 64;
+std::atomic<bool> s_interning{false};
+std::atomic<uint64_t> s_internedCount{0};
+
+std::array<LockGuarded<InternedNamesShard>, s_internedNamesShards>& getInternedNamesShards()
+{
+  // deliberately never destroyed, as handles held by static objects can outlive it otherwise
+  static auto* shards = new std::array<LockGuarded<InternedNamesShard>, s_internedNamesShards>();
+  return *shards;
+}
+}
+
+InternedDNSName::InternedDNSName(const DNSName& name)
+{
+  if (name.empty()) {
+    return;
+  }
+  if (!s_interning.load(std::memory_order_relaxed)) {
+    d_entry = new Entry(name);
+    return;
+  }
+
+  const auto& storage = name.getStorage();
+  // not burtleCI(), names differing only by their case are distinct
+  const auto hash = burtle(reinterpret_cast<const unsigned char*>(storage.data()), storage.size(), 0); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+  auto shard = getInternedNamesShards().at(hash % s_internedNamesShards).lock();
+  auto existing = shard->d_names.find(std::string_view(storage));
+  if (existing != shard->d_names.end()) {
+    auto* entry = existing->second;
+    /* a count of zero means that the last handle is going away and is waiting for the lock
+       to remove this entry, which cannot be handed out anymore, so we replace it */
+    auto count = entry->d_refcount.load(std::memory_order_relaxed);
+    while (count != 0) {
+      if (entry->d_refcount.compare_exchange_weak(count, count + 1, std::memory_order_relaxed)) {
+        d_entry = entry;
+        return;
+      }
+    }
+    shard->d_names.erase(existing);
+    --s_internedCount;
+  }
+
+  auto entry = std::make_unique<Entry>(name);
+  entry->d_hash = hash;
+  entry->d_interned = true;
+  shard->d_names.emplace(std::string_view(entry->d_name.getStorage()), entry.get());
+  ++s_internedCount;
+  d_entry = entry.release();
+}
+
+void InternedDNSName::release(Entry* entry)
+{
+  if (entry->d_interned) {
+    auto shard = getInternedNamesShards().at(entry->d_hash % s_internedNamesShards).lock();
+    auto existing = shard->d_names.find(std::string_view(entry->d_name.getStorage()));
+    if (existing != shard->d_names.end() && existing->second == entry) {
+      shard->d_names.erase(existing);
+      --s_internedCount;
+    }
+  }
+  delete entry; // NOLINT(cppcoreguidelines-owning-memory)
+}
+
+size_t InternedDNSName::sizeEstimate() const
+{
+  if (d_entry == nullptr) {
+    return 0;
+  }
+  auto size = sizeof(Entry) + d_entry->d_name.sizeEstimate();
+  if (d_entry->d_interned) {
+    // the key and value of the map entry, and roughly the overhead of the node and of the bucket
+    size += sizeof(std::string_view) + sizeof(Entry*) + 3 * sizeof(void*);
+  }
+  return size / std::max(d_entry->d_refcount.load(std::memory_order_relaxed), static_cast<uint32_t>(1));
+}
+
+void InternedDNSName::setInterning(bool enabled)
+{
+  s_interning = enabled;
+}
+
+uint64_t InternedDNSName::getInternedCount()
+{
+  return s_internedCount.load();
+}
+
 #if defined(PDNS_AUTH) // [
 std::ostream & operator<<(std::ostream &ostr, const ZoneName& zone)
 {
@@ -21,7 +21,10 @@
  */
 #pragma once
 #include <array>
+#include <atomic>
 #include <cstring>
+#include <limits>
+#include <memory>
 #include <optional>
 #include <string>
 #include <utility>
@@ -37,7 +40,6 @@
 using namespace std::string_view_literals;
 
 #include <boost/version.hpp>
-#include <boost/container/string.hpp>
 
 inline bool dns_isspace(char chr) __attribute__((const));
 inline bool dns_isspace(char chr)
@@ -59,9 +61,462 @@ inline unsigned char dns_tolower(unsigned char chr)
   return dns_tolower_table[chr];
 }
 
+/* The functions below process 8 bytes at a time in a 64-bit word instead of doing one table lookup
+   per byte, lowercasing exactly what dns_tolower() lowercases: 'A' to 'Z'. Names are short enough
+   (and their lengths varied enough) that this beats dispatching to vector instructions. */
+
+//! Lowercases the 8 bytes packed in word
+inline uint64_t dns_tolower8(uint64_t word) __attribute__((const));
+inline uint64_t dns_tolower8(uint64_t word)
+{
+  constexpr uint64_t ones = 0x0101010101010101ULL;
+  const uint64_t heptets = word & (0x7f * ones);
+  // bit 7 of every byte is set in the first word if that byte is >= 'A', in the second one if it is > 'Z'
+  const uint64_t geA = heptets + (0x80 - 'A') * ones;
+  const uint64_t gtZ = heptets + (0x7f - 'Z') * ones;
+  const uint64_t upper = (geA ^ gtZ) & ~word & (0x80 * ones);
+  return word | (upper >> 2);
+}
+
+//! Loads 8 bytes so that the byte at ptr[n] ends up in bits 8n to 8n+7, whatever the host byte order
+inline uint64_t dns_load8(const unsigned char* ptr)
+{
+  uint64_t word{0};
+  memcpy(&word, ptr, sizeof(word));
+#if __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+  word = __builtin_bswap64(word);
+#endif
+  return word;
+}
+
+//! Same as dns_load8() for 0 to 8 bytes, the missing ones being zero, without a variable-length copy
+inline uint64_t dns_loadpartial8(const unsigned char* ptr, size_t len)
+{
+  // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+  if (len >= 8) {
+    return dns_load8(ptr);
+  }
+  if (len >= 4) {
+    // two possibly overlapping 4-byte loads
+    uint32_t low{0};
+    uint32_t high{0};
+    memcpy(&low, ptr, sizeof(low));
+    memcpy(&high, ptr + len - 4, sizeof(high));
+#if __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+    low = __builtin_bswap32(low);
+    high = __builtin_bswap32(high);
+#endif
+    return low | (static_cast<uint64_t>(high) << (8 * (len - 4)));
+  }
+  if (len > 0) {
+    return ptr[0] | (static_cast<uint64_t>(ptr[len / 2]) << (8 * (len / 2))) | (static_cast<uint64_t>(ptr[len - 1]) << (8 * (len - 1)));
+  }
+  return 0;
+  // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+}
+
+//! Returns the difference between the first differing bytes of two words loaded by dns_load8(), which have to differ
+inline int dns_firstdiff8(uint64_t lhs, uint64_t rhs) __attribute__((const));
+inline int dns_firstdiff8(uint64_t lhs, uint64_t rhs)
+{
+  const int shift = __builtin_ctzll(lhs ^ rhs) & ~7;
+  return static_cast<int>((lhs >> shift) & 0xff) - static_cast<int>((rhs >> shift) & 0xff);
+}
+
+//! Case-insensitive three-way comparison of len bytes, returning the difference between the first differing lowercased bytes
+inline int dns_icompare(const unsigned char* lhs, const unsigned char* rhs, size_t len) __attribute__((pure));
+inline int dns_icompare(const unsigned char* lhs, const unsigned char* rhs, size_t len)
+{
+  // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+  if (len < 8) {
+    // short labels like 'www' or 'com' are very common, and faster to compare one byte at a time
+    for (size_t pos = 0; pos < len; pos++) {
+      if (lhs[pos] != rhs[pos]) {
+        if (int res = dns_tolower(lhs[pos]) - dns_tolower(rhs[pos]); res != 0) {
+          return res;
+        }
+      }
+    }
+    return 0;
+  }
+  // the last block overlaps the previous one, whose bytes are known to be equal by then
+  for (size_t pos = 0;; pos += 8) {
+    if (pos + 8 > len) {
+      pos = len - 8;
+    }
+    uint64_t left = dns_load8(lhs + pos);
+    uint64_t right = dns_load8(rhs + pos);
+    if (left != right) {
+      left = dns_tolower8(left);
+      right = dns_tolower8(right);
+      if (left != right) {
+        return dns_firstdiff8(left, right);
+      }
+    }
+    if (pos + 8 == len) {
+      return 0;
+    }
+  }
+  // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+}
+
+//! Lowercases len bytes in place
+inline void dns_tolower_inplace(unsigned char* data, size_t len)
+{
+  // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+  size_t pos = 0;
+  for (; pos + 8 <= len; pos += 8) {
+    uint64_t word{0};
+    memcpy(&word, data + pos, sizeof(word));
+    word = dns_tolower8(word);
+    memcpy(data + pos, &word, sizeof(word));
+  }
+  // not overlapping the last block with the previous one, as reading back what was just written is slow
+  for (; pos < len; pos++) {
+    data[pos] = dns_tolower(data[pos]);
+  }
+  // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+}
+
 #include "burtle.hh"
 #include "views.hh"
 
+#if defined(DNSNAME_INLINE_STORAGE) // [
+/* Storage for the wire representation of a DNSName, with the subset of the std::string interface
+   we need. Up to s_inlineCapacity bytes are stored inside the object itself, which is 64 bytes
+   large, so that the vast majority of names, including almost every name seen in queries, never
+   cause a memory allocation when they are created, copied or destroyed. Longer ones are stored on
+   the heap. The content is always followed by a NUL byte, so that c_str() works.
+   Only used when built with --enable-inline-dnsname-storage (-Dinline-dnsname-storage=true), since
+   it makes every DNSName, including the short ones kept in caches, 40 bytes larger. */
+class DNSNameStorage
+{
+public:
+  using value_type = char;
+  using size_type = size_t;
+  using iterator = char*;
+  using const_iterator = const char*;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+  static constexpr size_t npos = std::numeric_limits<size_t>::max();
+  static constexpr size_t s_inlineCapacity = 55;
+
+  DNSNameStorage() noexcept
+  {
+    d_inline[0] = 0;
+  }
+  DNSNameStorage(size_t count, char chr)
+  {
+    d_inline[0] = 0;
+    append(count, chr);
+  }
+  DNSNameStorage(const char* str, size_t len)
+  {
+    d_inline[0] = 0;
+    append(str, len);
+  }
+  DNSNameStorage(const DNSNameStorage& rhs)
+  {
+    d_inline[0] = 0;
+    append(rhs.data(), rhs.size());
+  }
+  DNSNameStorage(DNSNameStorage&& rhs) noexcept
+  {
+    steal(rhs);
+  }
+  DNSNameStorage& operator=(const DNSNameStorage& rhs)
+  {
+    if (this != &rhs) {
+      assign(rhs.data(), rhs.size());
+    }
+    return *this;
+  }
+  DNSNameStorage& operator=(DNSNameStorage&& rhs) noexcept
+  {
+    if (this != &rhs) {
+      release();
+      steal(rhs);
+    }
+    return *this;
+  }
+  ~DNSNameStorage()
+  {
+    release();
+  }
+
+  // NOLINTBEGIN(cppcoreguidelines-pro-type-union-access,cppcoreguidelines-pro-bounds-pointer-arithmetic)
+  [[nodiscard]] char* data() noexcept
+  {
+    return d_onHeap ? d_heap.d_ptr : d_inline.data();
+  }
+  [[nodiscard]] const char* data() const noexcept
+  {
+    return d_onHeap ? d_heap.d_ptr : d_inline.data();
+  }
+  [[nodiscard]] const char* c_str() const noexcept
+  {
+    return data();
+  }
+  [[nodiscard]] size_t size() const noexcept
+  {
+    return d_size;
+  }
+  [[nodiscard]] size_t length() const noexcept
+  {
+    return d_size;
+  }
+  [[nodiscard]] size_t capacity() const noexcept
+  {
+    return d_onHeap ? d_heap.d_capacity : s_inlineCapacity;
+  }
+  [[nodiscard]] bool empty() const noexcept
+  {
+    return d_size == 0;
+  }
+  //! Whether the content is stored inside the object
+  [[nodiscard]] bool isInline() const noexcept
+  {
+    return !d_onHeap;
+  }
+
+  char& operator[](size_t pos) noexcept
+  {
+    return data()[pos];
+  }
+  const char& operator[](size_t pos) const noexcept
+  {
+    return data()[pos];
+  }
+  char& at(size_t pos)
+  {
+    if (pos >= d_size) {
+      throw std::out_of_range("Out of bounds access to a DNS name storage");
+    }
+    return data()[pos];
+  }
+  [[nodiscard]] const char& at(size_t pos) const
+  {
+    if (pos >= d_size) {
+      throw std::out_of_range("Out of bounds access to a DNS name storage");
+    }
+    return data()[pos];
+  }
+
+  iterator begin() noexcept
+  {
+    return data();
+  }
+  iterator end() noexcept
+  {
+    return data() + d_size;
+  }
+  [[nodiscard]] const_iterator begin() const noexcept
+  {
+    return data();
+  }
+  [[nodiscard]] const_iterator end() const noexcept
+  {
+    return data() + d_size;
+  }
+  [[nodiscard]] const_iterator cbegin() const noexcept
+  {
+    return begin();
+  }
+  [[nodiscard]] const_iterator cend() const noexcept
+  {
+    return end();
+  }
+  reverse_iterator rbegin() noexcept
+  {
+    return reverse_iterator(end());
+  }
+  reverse_iterator rend() noexcept
+  {
+    return reverse_iterator(begin());
+  }
+  [[nodiscard]] const_reverse_iterator rbegin() const noexcept
+  {
+    return const_reverse_iterator(end());
+  }
+  [[nodiscard]] const_reverse_iterator rend() const noexcept
+  {
+    return const_reverse_iterator(begin());
+  }
+
+  void clear() noexcept
+  {
+    setSize(0);
+  }
+  void reserve(size_t newCapacity)
+  {
+    if (newCapacity > capacity()) {
+      grow(newCapacity);
+    }
+  }
+  void resize(size_t newSize, char chr = '\0')
+  {
+    if (newSize > d_size) {
+      append(newSize - d_size, chr);
+    }
+    else {
+      setSize(newSize);
+    }
+  }
+
+  DNSNameStorage& assign(size_t count, char chr)
+  {
+    clear();
+    return append(count, chr);
+  }
+  DNSNameStorage& assign(const char* str, size_t len)
+  {
+    clear();
+    return append(str, len);
+  }
+  DNSNameStorage& append(size_t count, char chr)
+  {
+    const size_t oldSize = d_size;
+    makeRoomFor(count);
+    memset(data() + oldSize, chr, count);
+    setSize(oldSize + count);
+    return *this;
+  }
+  DNSNameStorage& append(const char* str, size_t len)
+  {
+    const size_t oldSize = d_size;
+    makeRoomFor(len);
+    if (len > 0) {
+      memmove(data() + oldSize, str, len);
+    }
+    setSize(oldSize + len);
+    return *this;
+  }
+  DNSNameStorage& append(const char* first, const char* last)
+  {
+    return append(first, static_cast<size_t>(last - first));
+  }
+  DNSNameStorage& append(const DNSNameStorage& rhs)
+  {
+    return append(rhs.data(), rhs.size());
+  }
+  DNSNameStorage& operator+=(const DNSNameStorage& rhs)
+  {
+    return append(rhs);
+  }
+
+  DNSNameStorage& erase(size_t pos = 0, size_t count = npos)
+  {
+    if (pos > d_size) {
+      throw std::out_of_range("Out of bounds erase in a DNS name storage");
+    }
+    count = std::min(count, d_size - pos);
+    memmove(data() + pos, data() + pos + count, d_size - pos - count);
+    setSize(d_size - count);
+    return *this;
+  }
+  DNSNameStorage& replace(size_t pos, size_t count, const DNSNameStorage& rhs)
+  {
+    if (pos > d_size) {
+      throw std::out_of_range("Out of bounds replace in a DNS name storage");
+    }
+    count = std::min(count, d_size - pos);
+    DNSNameStorage result;
+    result.reserve(d_size - count + rhs.size());
+    result.append(data(), pos);
+    result.append(rhs);
+    result.append(data() + pos + count, d_size - pos - count);
+    *this = std::move(result);
+    return *this;
+  }
+
+  [[nodiscard]] int compare(size_t pos, size_t count, const DNSNameStorage& rhs) const
+  {
+    return std::string_view(*this).substr(pos, count).compare(std::string_view(rhs));
+  }
+  operator std::string_view() const noexcept
+  {
+    return {data(), d_size};
+  }
+
+  friend DNSNameStorage operator+(const DNSNameStorage& lhs, const DNSNameStorage& rhs)
+  {
+    DNSNameStorage result;
+    result.reserve(lhs.size() + rhs.size());
+    result.append(lhs);
+    result.append(rhs);
+    return result;
+  }
+  friend bool operator==(const DNSNameStorage& lhs, const DNSNameStorage& rhs) noexcept
+  {
+    return std::string_view(lhs) == std::string_view(rhs);
+  }
+  friend bool operator!=(const DNSNameStorage& lhs, const DNSNameStorage& rhs) noexcept
+  {
+    return !(lhs == rhs);
+  }
+
+private:
+  void setSize(size_t newSize) noexcept
+  {
+    d_size = static_cast<uint32_t>(newSize);
+    data()[newSize] = '\0';
+  }
+  void makeRoomFor(size_t count)
+  {
+    if (d_size + count > capacity()) {
+      grow(std::max(d_size + count, 2 * capacity()));
+    }
+  }
+  void grow(size_t newCapacity)
+  {
+    // one extra byte for the trailing NUL
+    auto* ptr = new char[newCapacity + 1];
+    memcpy(ptr, data(), d_size + 1);
+    release();
+    d_heap.d_ptr = ptr;
+    d_heap.d_capacity = newCapacity;
+    d_onHeap = true;
+  }
+  void release() noexcept
+  {
+    if (d_onHeap) {
+      delete[] d_heap.d_ptr;
+      d_onHeap = false;
+    }
+  }
+  void steal(DNSNameStorage& rhs) noexcept
+  {
+    d_size = rhs.d_size;
+    d_onHeap = rhs.d_onHeap;
+    if (rhs.d_onHeap) {
+      d_heap = rhs.d_heap;
+    }
+    else {
+      memcpy(d_inline.data(), rhs.d_inline.data(), d_size + 1);
+    }
+    rhs.d_onHeap = false;
+    rhs.d_size = 0;
+    rhs.d_inline[0] = '\0';
+  }
+  // NOLINTEND(cppcoreguidelines-pro-type-union-access,cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+  struct HeapStorage
+  {
+    char* d_ptr;
+    size_t d_capacity;
+  };
+  union
+  {
+    std::array<char, s_inlineCapacity + 1> d_inline;
+    HeapStorage d_heap;
+  };
+  uint32_t d_size{0};
+  bool d_onHeap{false};
+};
+#else // ] [
+#include <boost/container/string.hpp>
+#endif // ]
+
 /* Quest in life:
      accept escaped ascii presentations of DNS names and store them "natively"
      accept a DNS packet with an offset, and extract a DNS name from it
@@ -139,9 +594,7 @@ public:
   }
   void makeUsLowerCase()
   {
-    for(auto & c : d_storage) {
-      c=dns_tolower(c);
-    }
+    dns_tolower_inplace(reinterpret_cast<unsigned char*>(d_storage.data()), d_storage.size()); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
   }
   void makeUsRelative(const DNSName& zone);
   DNSName getCommonLabels(const DNSName& other) const; //!< Return the list of common labels from the top, for example 'c.d' for 'a.b.c.d' and 'x.y.c.d'
@@ -193,7 +646,11 @@ public:
   int canonCompare_three_way(const DNSName& rhs) const;
   inline bool canonCompare(const DNSName& rhs) const { return canonCompare_three_way(rhs) < 0; }
 
+#if defined(DNSNAME_INLINE_STORAGE)
+  typedef DNSNameStorage string_t;
+#else
   typedef boost::container::string string_t;
+#endif
 
   const string_t& getStorage() const {
     return d_storage;
@@ -286,6 +743,90 @@ extern const DNSName g_hmacsha256dnsname;    // hmac-sha256
 extern const DNSName g_hmacsha384dnsname;    // hmac-sha384
 extern const DNSName g_hmacsha512dnsname;    // hmac-sha512
 
+/* A handle on an immutable, reference-counted DNSName, the size of a pointer. Copying a handle
+   only increments a counter. When interning is enabled via setInterning(), every handle created
+   from names with the same wire representation, case included, shares a single copy of that name,
+   so that caches holding the same name server or zone names many times only store them once.
+   Otherwise every handle created from a DNSName gets a copy of its own. */
+class InternedDNSName
+{
+public:
+  InternedDNSName() noexcept = default; //!< Refers to an *empty* DNSName
+  explicit InternedDNSName(const DNSName& name);
+  InternedDNSName(const InternedDNSName& rhs) noexcept :
+    d_entry(rhs.d_entry)
+  {
+    if (d_entry != nullptr) {
+      d_entry->d_refcount.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+  InternedDNSName(InternedDNSName&& rhs) noexcept :
+    d_entry(rhs.d_entry)
+  {
+    rhs.d_entry = nullptr;
+  }
+  InternedDNSName& operator=(const InternedDNSName& rhs) noexcept
+  {
+    InternedDNSName copy(rhs);
+    std::swap(d_entry, copy.d_entry);
+    return *this;
+  }
+  InternedDNSName& operator=(InternedDNSName&& rhs) noexcept
+  {
+    std::swap(d_entry, rhs.d_entry);
+    return *this;
+  }
+  ~InternedDNSName()
+  {
+    if (d_entry != nullptr && d_entry->d_refcount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      release(d_entry);
+    }
+  }
+
+  const DNSName& operator*() const noexcept
+  {
+    return d_entry != nullptr ? d_entry->d_name : s_emptyName;
+  }
+  const DNSName* operator->() const noexcept
+  {
+    return &**this;
+  }
+  bool operator==(const InternedDNSName& rhs) const
+  {
+    return d_entry == rhs.d_entry || **this == *rhs;
+  }
+  bool operator!=(const InternedDNSName& rhs) const
+  {
+    return !(*this == rhs);
+  }
+
+  //! Memory used by the name, divided between all the handles sharing it
+  [[nodiscard]] size_t sizeEstimate() const;
+
+  //! Whether names are shared between handles from now on. Existing handles are not affected.
+  static void setInterning(bool enabled);
+  //! Number of distinct names currently shared
+  static uint64_t getInternedCount();
+
+  struct Entry
+  {
+    explicit Entry(const DNSName& name) :
+      d_name(name)
+    {
+    }
+    const DNSName d_name;
+    std::atomic<uint32_t> d_refcount{1};
+    uint32_t d_hash{0};
+    bool d_interned{false};
+  };
+
+private:
+  static void release(Entry* entry);
+  static const DNSName s_emptyName;
+
+  Entry* d_entry{nullptr};
+};
+
 #if defined(PDNS_AUTH) // [
 // ZoneName: this is equivalent to DNSName, but intended to only store zone
 // names. In addition to the name, an optional variant is allowed. The
@@ -652,6 +1193,129 @@ private:
   }
 };
 
+/* Immutable, flattened form of a SuffixMatchTree. Nodes are stored in a single vector, their labels
+   in a single string, and the edges in an open-addressing hash table keyed on the parent node and the
+   case-insensitive hash of the label, so that a lookup walks the labels of the wire-format name
+   from the root without allocating or chasing pointers through std::set nodes. */
+template <typename T>
+class CompiledSuffixMatchTree
+{
+public:
+  CompiledSuffixMatchTree() = default;
+
+  explicit CompiledSuffixMatchTree(const SuffixMatchTree<T>& tree)
+  {
+    std::vector<const SuffixMatchTree<T>*> pending{&tree};
+    d_nodes.push_back({tree.d_value, 0, 0, tree.endNode});
+    size_t edgesCount = 0;
+    for (size_t idx = 0; idx < pending.size(); idx++) {
+      edgesCount += pending.at(idx)->children.size();
+      for (const auto& child : pending.at(idx)->children) {
+        pending.push_back(&child);
+      }
+    }
+    if (pending.size() >= std::numeric_limits<uint32_t>::max()) {
+      throw std::runtime_error("Too many nodes to compile a suffix match tree");
+    }
+
+    size_t edgesSize = 16;
+    while (edgesSize < edgesCount * 2) {
+      edgesSize *= 2;
+    }
+    d_edges.resize(edgesSize);
+    d_nodes.reserve(pending.size());
+
+    /* pending is in breadth-first order, so every node is numbered before its children */
+    for (uint32_t parentIdx = 0; parentIdx < pending.size(); parentIdx++) {
+      for (const auto& child : pending.at(parentIdx)->children) {
+        const auto childIdx = static_cast<uint32_t>(d_nodes.size());
+        d_nodes.push_back({child.d_value, static_cast<uint32_t>(d_labels.size()), static_cast<uint8_t>(child.d_name.size()), child.endNode});
+        d_labels.append(child.d_name);
+        const uint32_t hash = burtleCI(child.d_name, parentIdx);
+        size_t slot = hash & (d_edges.size() - 1);
+        while (d_edges[slot].child != 0) {
+          slot = (slot + 1) & (d_edges.size() - 1);
+        }
+        d_edges[slot] = {hash, parentIdx, childIdx};
+      }
+    }
+    d_labels.shrink_to_fit();
+  }
+
+  const T* lookup(const DNSName& name) const
+  {
+    if (d_nodes.empty()) {
+      return nullptr;
+    }
+
+    /* the labels of a name of at most 255 bytes start within the first 255 bytes */
+    const auto& storage = name.getStorage();
+    std::array<uint8_t, 128> labels{};
+    size_t labelsCount = 0;
+    for (size_t pos = 0; pos < storage.size() && storage[pos] != 0 && labelsCount < labels.size(); pos += static_cast<uint8_t>(storage[pos]) + 1) {
+      labels.at(labelsCount++) = pos;
+    }
+
+    uint32_t nodeIdx = 0;
+    const T* best = d_nodes[0].endNode ? &d_nodes[0].value : nullptr;
+    while (labelsCount > 0) {
+      --labelsCount;
+      const char* label = &storage[labels.at(labelsCount)];
+      nodeIdx = findChild(nodeIdx, label + 1, static_cast<uint8_t>(*label));
+      if (nodeIdx == 0) {
+        break;
+      }
+      if (d_nodes[nodeIdx].endNode) {
+        best = &d_nodes[nodeIdx].value;
+      }
+    }
+    return best;
+  }
+
+  size_t size() const
+  {
+    return d_nodes.size();
+  }
+
+private:
+  struct Node
+  {
+    T value;
+    uint32_t labelOffset;
+    uint8_t labelLength;
+    bool endNode;
+  };
+
+  struct Edge
+  {
+    uint32_t hash{0};
+    uint32_t parent{0};
+    uint32_t child{0}; // the root is never a child, so 0 marks an empty slot
+  };
+
+  // returns 0 if there is no such child
+  uint32_t findChild(uint32_t parent, const char* label, uint8_t labelLength) const
+  {
+    const uint32_t hash = burtleCI(reinterpret_cast<const unsigned char*>(label), labelLength, parent); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    const size_t mask = d_edges.size() - 1;
+    for (size_t slot = hash & mask; d_edges[slot].child != 0; slot = (slot + 1) & mask) {
+      const auto& edge = d_edges[slot];
+      if (edge.hash != hash || edge.parent != parent) {
+        continue;
+      }
+      const auto& node = d_nodes[edge.child];
+      if (node.labelLength == labelLength && strncasecmp(&d_labels[node.labelOffset], label, labelLength) == 0) {
+        return edge.child;
+      }
+    }
+    return 0;
+  }
+
+  std::vector<Node> d_nodes;
+  std::vector<Edge> d_edges;
+  std::string d_labels;
+};
+
 /* Quest in life: serve as a rapid block list. If you add a DNSName to a root SuffixMatchNode,
    anything part of that domain will return 'true' in check */
 struct SuffixMatchNode
@@ -664,6 +1328,7 @@ struct SuffixMatchNode
     {
       d_tree.add(dnsname, true);
       d_nodes.insert(dnsname);
+      d_compiled.reset();
     }
 
     void add(const std::string& name)
@@ -674,6 +1339,7 @@ struct SuffixMatchNode
     void add(std::vector<std::string> labels)
     {
       d_tree.add(labels, true);
+      d_compiled.reset();
       DNSName tmp;
       while (!labels.empty()) {
         tmp.appendRawLabel(labels.back());
@@ -686,11 +1352,13 @@ struct SuffixMatchNode
     {
       d_tree.remove(name);
       d_nodes.erase(name);
+      d_compiled.reset();
     }
 
     void remove(std::vector<std::string> labels)
     {
       d_tree.remove(labels);
+      d_compiled.reset();
       DNSName tmp;
       while (!labels.empty()) {
         tmp.appendRawLabel(labels.back());
@@ -701,9 +1369,19 @@ struct SuffixMatchNode
 
     bool check(const DNSName& dnsname) const
     {
+      if (d_compiled) {
+        return d_compiled->lookup(dnsname) != nullptr;
+      }
       return d_tree.lookup(dnsname) != nullptr;
     }
 
+    /* Builds the compiled form used by check() until the next add() or remove(). Meant
+       to be called once a node that is going to be looked up a lot is fully built */
+    void compile()
+    {
+      d_compiled = std::make_shared<const CompiledSuffixMatchTree<bool>>(d_tree);
+    }
+
     std::optional<DNSName> getBestMatch(const DNSName& name) const
     {
       return d_tree.getBestMatch(name);
@@ -725,6 +1403,7 @@ struct SuffixMatchNode
 
   private:
     mutable std::set<DNSName> d_nodes; // Only used for string generation
+    std::shared_ptr<const CompiledSuffixMatchTree<bool>> d_compiled; // immutable, so it can be shared between copies
 };
 
 std::ostream & operator<<(std::ostream &os, const DNSName& d);
@@ -743,14 +1422,8 @@ bool DNSName::operator==(const DNSName& rhs) const
     return false;
   }
 
-  const auto* us = d_storage.cbegin();
-  const auto* p = rhs.d_storage.cbegin();
-  for (; us != d_storage.cend() && p != rhs.d_storage.cend(); ++us, ++p) {
-    if (dns_tolower(*p) != dns_tolower(*us)) {
-      return false;
-    }
-  }
-  return true;
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  return dns_icompare(reinterpret_cast<const unsigned char*>(d_storage.data()), reinterpret_cast<const unsigned char*>(rhs.d_storage.data()), d_storage.size()) == 0;
 }
 
 struct DNSNameSet: public std::unordered_set<DNSName> {
@@ -227,6 +227,14 @@ DNSResourceRecord DNSResourceRecord::fromWire(const DNSRecord& wire)
   return resourceRecord;
 }
 
+// in queries, we only care about the content of a few records in the additional section
+static bool isContentParsed(bool query, uint16_t qtype, DNSResourceRecord::Place place, uint16_t type, uint16_t qclass)
+{
+  return !(query &&
+           !(qtype == QType::IXFR && place == DNSResourceRecord::AUTHORITY && type == QType::SOA) && // IXFR queries have a SOA in their AUTHORITY section
+           (place == DNSResourceRecord::ANSWER || place == DNSResourceRecord::AUTHORITY || (type != QType::OPT && type != QType::TSIG && type != QType::SIG && type != QType::TKEY) || ((type == QType::TSIG || type == QType::SIG || type == QType::TKEY) && qclass != QClass::ANY)));
+}
+
 void MOADNSParser::init(bool query, const std::string_view& packet)
 {
   if (packet.size() < sizeof(dnsheader))
@@ -285,9 +293,7 @@ void MOADNSParser::init(bool query, const std::string_view& packet)
       dr.d_name = std::move(name);
       dr.d_clen = ah.d_clen;
 
-      if (query &&
-          !(d_qtype == QType::IXFR && dr.d_place == DNSResourceRecord::AUTHORITY && dr.d_type == QType::SOA) && // IXFR queries have a SOA in their AUTHORITY section
-          (dr.d_place == DNSResourceRecord::ANSWER || dr.d_place == DNSResourceRecord::AUTHORITY || (dr.d_type != QType::OPT && dr.d_type != QType::TSIG && dr.d_type != QType::SIG && dr.d_type != QType::TKEY) || ((dr.d_type == QType::TSIG || dr.d_type == QType::SIG || dr.d_type == QType::TKEY) && dr.d_class != QClass::ANY))) {
+      if (!isContentParsed(query, d_qtype, dr.d_place, dr.d_type, dr.d_class)) {
 //        cerr<<"discarding RR, query is "<<query<<", place is "<<dr.d_place<<", type is "<<dr.d_type<<", class is "<<dr.d_class<<endl;
         dr.setContent(std::make_shared<UnknownRecordContent>(dr, pr));
       }
@@ -353,6 +359,259 @@ bool MOADNSParser::hasEDNS() const
   return false;
 }
 
+/* skip over the name starting at pos, checking it like DNSName's packet parser would,
+   and return the position right after it */
+static uint16_t skipName(const std::string_view& packet, uint16_t pos)
+{
+  size_t current = pos;
+  size_t segmentStart = pos;
+  size_t end = 0;
+  size_t nameLength = 0;
+  unsigned int depth = 0;
+
+  for (;;) {
+    if (current >= packet.size()) {
+      throw std::out_of_range("dnsname issue: Trying to read past the end of the buffer");
+    }
+    const auto labelLength = static_cast<uint8_t>(packet[current]);
+    if (labelLength == 0) {
+      if (end == 0) {
+        end = current + 1;
+      }
+      break;
+    }
+    if (labelLength >= 0xc0) {
+      if (current + 1 >= packet.size()) {
+        throw std::out_of_range("dnsname issue: Trying to read past the end of the buffer");
+      }
+      const size_t target = ((labelLength & ~0xc0) << 8) + static_cast<uint8_t>(packet[current + 1]);
+      if (target >= segmentStart) {
+        throw std::out_of_range("dnsname issue: Found a forward reference during label decompression");
+      }
+      if (target < sizeof(dnsheader)) {
+        throw std::out_of_range("dnsname issue: Invalid label position during decompression");
+      }
+      if (++depth > 100) {
+        throw std::out_of_range("dnsname issue: Abort label decompression after 100 redirects");
+      }
+      if (end == 0) {
+        end = current + 2;
+      }
+      current = segmentStart = target;
+      continue;
+    }
+    if ((labelLength & 0xc0) != 0) {
+      throw std::out_of_range("dnsname issue: Found an invalid label length in qname (only one of the first two bits is set)");
+    }
+    if (nameLength + labelLength > 254) {
+      throw std::out_of_range("dnsname issue: name too long");
+    }
+    if (current + 1 + labelLength >= packet.size()) {
+      throw std::out_of_range("dnsname issue: Found an invalid label length in qname");
+    }
+    nameLength += labelLength + 1;
+    current += labelLength + 1;
+  }
+
+  return end;
+}
+
+DNSMessageView::DNSMessageView(bool query, const std::string_view& packet) :
+  d_packet(packet), d_query(query)
+{
+  if (packet.size() < sizeof(dnsheader)) {
+    throw MOADNSException("Packet shorter than minimal header");
+  }
+  if (packet.size() > std::numeric_limits<uint16_t>::max()) {
+    throw std::out_of_range("packet too large");
+  }
+
+  memcpy(&d_header, packet.data(), sizeof(dnsheader));
+  d_header.qdcount = ntohs(d_header.qdcount);
+  d_header.ancount = ntohs(d_header.ancount);
+  d_header.nscount = ntohs(d_header.nscount);
+  d_header.arcount = ntohs(d_header.arcount);
+
+  if (query && d_header.qdcount > 1) {
+    throw MOADNSException("Query with QD > 1 (" + std::to_string(d_header.qdcount) + ")");
+  }
+
+  const auto readUInt16 = [&packet](size_t pos) {
+    return static_cast<uint16_t>(static_cast<uint8_t>(packet.at(pos)) * 256 + static_cast<uint8_t>(packet.at(pos + 1)));
+  };
+
+  size_t idx = 0;
+  bool validPacket = false;
+  uint16_t pos = sizeof(dnsheader);
+  try {
+    for (idx = 0; idx < d_header.qdcount; ++idx) {
+      d_qnameOffset = pos;
+      pos = skipName(packet, pos);
+      d_qtype = readUInt16(pos);
+      d_qclass = readUInt16(pos + 2);
+      pos += 4;
+    }
+
+    validPacket = true;
+    const size_t recordsCount = d_header.ancount + d_header.nscount + d_header.arcount;
+    bool seenTSIG = false;
+    d_records.reserve(recordsCount);
+    for (idx = 0; idx < recordsCount; ++idx) {
+      Record record{};
+      if (idx < d_header.ancount) {
+        record.d_place = DNSResourceRecord::ANSWER;
+      }
+      else if (idx < d_header.ancount + d_header.nscount) {
+        record.d_place = DNSResourceRecord::AUTHORITY;
+      }
+      else {
+        record.d_place = DNSResourceRecord::ADDITIONAL;
+      }
+
+      record.d_nameOffset = pos;
+      pos = skipName(packet, pos);
+      if (pos + sizeof(dnsrecordheader) > packet.size()) {
+        throw std::out_of_range("Attempt to read a record header outside of packet");
+      }
+      record.d_type = readUInt16(pos);
+      record.d_class = readUInt16(pos + 2);
+      record.d_ttl = (static_cast<uint32_t>(readUInt16(pos + 4)) << 16) + readUInt16(pos + 6);
+      record.d_contentLength = readUInt16(pos + 8);
+      record.d_contentOffset = pos + sizeof(dnsrecordheader);
+      if (static_cast<size_t>(record.d_contentOffset) + record.d_contentLength > packet.size()) {
+        throw std::out_of_range("Attempt to read a record content outside of packet");
+      }
+      pos = record.d_contentOffset + record.d_contentLength;
+
+      if (record.d_place == DNSResourceRecord::ADDITIONAL && seenTSIG) {
+        throw MOADNSException("Packet (" + getQName().toString() + "|#" + std::to_string(d_qtype) + ") has an unexpected record (" + std::to_string(record.d_type) + ") after a TSIG one.");
+      }
+
+      if (record.d_type == QType::TSIG && record.d_class == QClass::ANY) {
+        if (seenTSIG || record.d_place != DNSResourceRecord::ADDITIONAL) {
+          throw MOADNSException("Packet (" + getQName().toLogString() + "|#" + std::to_string(d_qtype) + ") has a TSIG record in an invalid position.");
+        }
+        seenTSIG = true;
+        d_tsigPos = record.d_nameOffset;
+      }
+
+      d_records.push_back(record);
+    }
+  }
+  catch (const std::out_of_range& exp) {
+    if (validPacket && d_header.tc) { // don't sweat it over truncated packets, but do adjust an, ns and arcount
+      if (idx < d_header.ancount) {
+        d_header.ancount = idx;
+        d_header.nscount = d_header.arcount = 0;
+      }
+      else if (idx < d_header.ancount + d_header.nscount) {
+        d_header.nscount = idx - d_header.ancount;
+        d_header.arcount = 0;
+      }
+      else {
+        d_header.arcount = idx - d_header.ancount - d_header.nscount;
+      }
+    }
+    else {
+      throw MOADNSException("Error parsing packet of " + std::to_string(packet.size()) + " bytes (rd=" + std::to_string(d_header.rd) + "), out of bounds: " + string(exp.what()));
+    }
+  }
+}
+
+DNSName DNSMessageView::getQName() const
+{
+  if (!hasQuestion()) {
+    return {};
+  }
+  return getName(d_qnameOffset);
+}
+
+bool DNSMessageView::isQName(const DNSName& name) const
+{
+  if (!hasQuestion()) {
+    return name.empty();
+  }
+  return nameEquals(d_qnameOffset, name);
+}
+
+DNSName DNSMessageView::getName(uint16_t offset) const
+{
+  return DNSName(d_packet.data(), d_packet.size(), offset, true, nullptr, nullptr, nullptr, sizeof(dnsheader));
+}
+
+bool DNSMessageView::nameEquals(uint16_t offset, const DNSName& name) const
+{
+  const auto& storage = name.getStorage();
+  size_t current = offset;
+  size_t namePos = 0;
+
+  /* the name has already been validated when we built the index */
+  for (;;) {
+    const auto labelLength = static_cast<uint8_t>(d_packet.at(current));
+    if (labelLength >= 0xc0) {
+      current = ((labelLength & ~0xc0) << 8) + static_cast<uint8_t>(d_packet.at(current + 1));
+      continue;
+    }
+    if (namePos >= storage.size() || static_cast<uint8_t>(storage[namePos]) != labelLength) {
+      return false;
+    }
+    if (labelLength == 0) {
+      return true;
+    }
+    for (size_t idx = 1; idx <= labelLength; idx++) {
+      if (dns_tolower(d_packet.at(current + idx)) != dns_tolower(storage[namePos + idx])) {
+        return false;
+      }
+    }
+    current += labelLength + 1;
+    namePos += labelLength + 1;
+  }
+}
+
+std::shared_ptr<DNSRecordContent> DNSMessageView::getContent(const Record& record, const DNSRecord& dnsRecord) const
+{
+  /* readers are not allowed to go past the content of the record */
+  PacketReader reader(d_packet.substr(0, record.d_contentOffset + record.d_contentLength), record.d_contentOffset - sizeof(dnsrecordheader));
+  dnsrecordheader header{};
+  reader.getDnsrecordheader(header);
+
+  if (!isContentParsed(d_query, d_qtype, record.d_place, record.d_type, record.d_class)) {
+    return std::make_shared<UnknownRecordContent>(dnsRecord, reader);
+  }
+  return DNSRecordContent::make(dnsRecord, reader, d_header.opcode);
+}
+
+std::shared_ptr<DNSRecordContent> DNSMessageView::getContent(const Record& record) const
+{
+  DNSRecord dnsRecord;
+  dnsRecord.d_type = record.d_type;
+  dnsRecord.d_class = record.d_class;
+  dnsRecord.d_ttl = record.d_ttl;
+  dnsRecord.d_clen = record.d_contentLength;
+  dnsRecord.d_place = record.d_place;
+  return getContent(record, dnsRecord);
+}
+
+DNSRecord DNSMessageView::getRecord(const Record& record) const
+{
+  DNSRecord dnsRecord;
+  dnsRecord.d_name = getName(record.d_nameOffset);
+  dnsRecord.d_type = record.d_type;
+  dnsRecord.d_class = record.d_class;
+  dnsRecord.d_ttl = record.d_ttl;
+  dnsRecord.d_clen = record.d_contentLength;
+  dnsRecord.d_place = record.d_place;
+  dnsRecord.setContent(getContent(record, dnsRecord));
+  return dnsRecord;
+}
+
+bool DNSMessageView::hasEDNS() const
+{
+  return std::any_of(d_records.begin(), d_records.end(), [](const Record& record) {
+    return record.d_place == DNSResourceRecord::ADDITIONAL && record.d_type == QType::OPT;
+  });
+}
+
 void PacketReader::getDnsrecordheader(struct dnsrecordheader &ah)
 {
   unsigned char *p = reinterpret_cast<unsigned char*>(&ah);
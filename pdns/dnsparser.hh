@@ -30,6 +30,7 @@
 #include <vector>
 #include <cerrno>
 // #include <netinet/in.h>
+#include <boost/container/small_vector.hpp>
 #include "misc.hh"
 
 #include "dns.hh"
@@ -527,6 +528,93 @@ private:
   uint16_t d_tsigPos;
 };
 
+/* A read-only view of a DNS message, for callers that only need a few of its fields or records.
+   The constructor indexes the question and records in a single pass, checking names and record
+   headers the way MOADNSParser does but without allocating for messages of up to 64 records.
+   Names are only materialized, and record contents decoded, on request. Contrary to MOADNSParser
+   the opcode is not checked. The packet has to outlive the view. */
+class DNSMessageView : public boost::noncopyable
+{
+public:
+  struct Record
+  {
+    uint32_t d_ttl;
+    uint16_t d_nameOffset; // in the packet, might be a compression pointer
+    uint16_t d_contentOffset;
+    uint16_t d_contentLength;
+    uint16_t d_type;
+    uint16_t d_class;
+    DNSResourceRecord::Place d_place;
+  };
+  using records_t = boost::container::small_vector<Record, 64>;
+
+  DNSMessageView(bool query, const std::string_view& packet);
+
+  //! The counts are in host byte order, and reflect what was actually parsed for truncated answers
+  const dnsheader& getHeader() const
+  {
+    return d_header;
+  }
+
+  bool hasQuestion() const
+  {
+    return d_header.qdcount > 0;
+  }
+
+  //! Like for MOADNSParser, the last question is used when there is more than one
+  DNSName getQName() const;
+  bool isQName(const DNSName& name) const;
+
+  uint16_t getQType() const
+  {
+    return d_qtype;
+  }
+
+  uint16_t getQClass() const
+  {
+    return d_qclass;
+  }
+
+  //! Everything but the question section
+  const records_t& getRecords() const
+  {
+    return d_records;
+  }
+
+  //! The offset has to be one of the name offsets we handed out
+  DNSName getName(uint16_t offset) const;
+  bool nameEquals(uint16_t offset, const DNSName& name) const;
+
+  std::string_view getRawContent(const Record& record) const
+  {
+    return d_packet.substr(record.d_contentOffset, record.d_contentLength);
+  }
+
+  //! Decodes the content of the record, might throw std::out_of_range or MOADNSException on invalid content
+  std::shared_ptr<DNSRecordContent> getContent(const Record& record) const;
+  //! Same as above, but also materializes the name, returning what MOADNSParser would have put into d_answers
+  DNSRecord getRecord(const Record& record) const;
+
+  uint16_t getTSIGPos() const
+  {
+    return d_tsigPos;
+  }
+
+  bool hasEDNS() const;
+
+private:
+  std::shared_ptr<DNSRecordContent> getContent(const Record& record, const DNSRecord& dnsRecord) const;
+
+  std::string_view d_packet;
+  records_t d_records;
+  dnsheader d_header{};
+  uint16_t d_qnameOffset{0};
+  uint16_t d_qtype{0};
+  uint16_t d_qclass{0};
+  uint16_t d_tsigPos{0};
+  bool d_query;
+};
+
 string simpleCompress(const string& label, const string& root="");
 void ageDNSPacket(char* packet, size_t length, uint32_t seconds, const dnsheader_aligned&);
 void ageDNSPacket(std::string& packet, uint32_t seconds, const dnsheader_aligned&);
@@ -143,9 +143,35 @@ void ARecordContent::doRecordCheck(const DNSRecord& dr)
 
 boilerplate_conv(AAAA, conv.xfrIP6(d_ip6); );
 
-boilerplate_conv(NS, conv.xfrName(d_content, true));
+// the names of NS and CNAME targets are repeated many times in caches, so they are interned
+template <class Reader>
+static void readInternedName(Reader& reader, InternedDNSName& name)
+{
+  DNSName parsed;
+  reader.xfrName(parsed, true);
+  name = InternedDNSName(parsed);
+}
+
+static void xfrInternedName(PacketReader& reader, InternedDNSName& name)
+{
+  readInternedName(reader, name);
+}
+
+static void xfrInternedName(RecordTextReader& reader, InternedDNSName& name)
+{
+  readInternedName(reader, name);
+}
+
+// writers, which getZoneRepresentation() also calls through the non-const xfrPacket()
+template <class Writer>
+static void xfrInternedName(Writer& writer, const InternedDNSName& name)
+{
+  writer.xfrName(*name, true);
+}
+
+boilerplate_conv(NS, xfrInternedName(conv, d_content));
 boilerplate_conv(PTR, conv.xfrName(d_content, true));
-boilerplate_conv(CNAME, conv.xfrName(d_content, true));
+boilerplate_conv(CNAME, xfrInternedName(conv, d_content));
 #if !defined(RECURSOR)
 boilerplate_conv(ALIAS, conv.xfrName(d_content, false));
 #endif
@@ -878,6 +904,24 @@ uint16_t DNSKEYRecordContent::getTag() const
 }
 
 
+static bool fillEDNSOpts(uint16_t qclass, uint32_t ttl, const std::shared_ptr<const OPTRecordContent>& orc, EDNSOpts* eo)
+{
+  eo->d_packetsize=qclass;
+
+  EDNS0Record stuff;
+  ttl=ntohl(ttl);
+  static_assert(sizeof(EDNS0Record) == sizeof(uint32_t), "sizeof(EDNS0Record) must match sizeof(uint32_t)");
+  memcpy(&stuff, &ttl, sizeof(stuff));
+
+  eo->d_extRCode=stuff.extRCode;
+  eo->d_version=stuff.version;
+  eo->d_extFlags = ntohs(stuff.extFlags);
+  if(orc == nullptr)
+    return false;
+  orc->getData(eo->d_options);
+  return true;
+}
+
 /*
  * Fills `eo` by parsing the EDNS(0) OPT RR (RFC 6891)
  */
@@ -887,27 +931,24 @@ bool getEDNSOpts(const MOADNSParser& mdp, EDNSOpts* eo)
   if(mdp.d_header.arcount && !mdp.d_answers.empty()) {
     for(const MOADNSParser::answers_t::value_type& val :  mdp.d_answers) {
       if(val.d_place == DNSResourceRecord::ADDITIONAL && val.d_type == QType::OPT) {
-        eo->d_packetsize=val.d_class;
-
-        EDNS0Record stuff;
-        uint32_t ttl=ntohl(val.d_ttl);
-        static_assert(sizeof(EDNS0Record) == sizeof(uint32_t), "sizeof(EDNS0Record) must match sizeof(uint32_t)");
-        memcpy(&stuff, &ttl, sizeof(stuff));
-
-        eo->d_extRCode=stuff.extRCode;
-        eo->d_version=stuff.version;
-        eo->d_extFlags = ntohs(stuff.extFlags);
-        auto orc = getRR<OPTRecordContent>(val);
-        if(orc == nullptr)
-          return false;
-        orc->getData(eo->d_options);
-        return true;
+        return fillEDNSOpts(val.d_class, val.d_ttl, getRR<OPTRecordContent>(val), eo);
       }
     }
   }
   return false;
 }
 
+bool getEDNSOpts(const DNSMessageView& view, EDNSOpts* eo)
+{
+  eo->d_extFlags=0;
+  for (const auto& record : view.getRecords()) {
+    if (record.d_place == DNSResourceRecord::ADDITIONAL && record.d_type == QType::OPT) {
+      return fillEDNSOpts(record.d_class, record.d_ttl, std::dynamic_pointer_cast<const OPTRecordContent>(view.getContent(record)), eo);
+    }
+  }
+  return false;
+}
+
 static void reportBasicTypes(const ReportIsOnlyCallableByReportAllTypes& guard)
 {
   ARecordContent::report(guard);
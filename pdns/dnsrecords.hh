@@ -290,9 +290,9 @@ private:
 class NSRecordContent : public DNSRecordContent
 {
 public:
-  includeboilerplate(NS) explicit NSRecordContent(DNSName content) :
-    d_content(std::move(content)) {}
-  const DNSName& getNS() const { return d_content; }
+  includeboilerplate(NS) explicit NSRecordContent(const DNSName& content) :
+    d_content(content) {}
+  const DNSName& getNS() const { return *d_content; }
   bool operator==(const DNSRecordContent& rhs) const override
   {
     if(typeid(*this) != typeid(rhs))
@@ -305,7 +305,7 @@ public:
     return sizeof(*this) + d_content.sizeEstimate();
   }
 private:
-  DNSName d_content;
+  InternedDNSName d_content;
 };
 
 class PTRRecordContent : public DNSRecordContent
@@ -326,15 +326,15 @@ class CNAMERecordContent : public DNSRecordContent
 {
 public:
   includeboilerplate(CNAME)
-    CNAMERecordContent(DNSName content) :
-    d_content(std::move(content)) {}
-  DNSName getTarget() const { return d_content; }
+    CNAMERecordContent(const DNSName& content) :
+    d_content(content) {}
+  DNSName getTarget() const { return *d_content; }
   [[nodiscard]] size_t sizeEstimate() const override
   {
     return sizeof(*this) + d_content.sizeEstimate();
   }
 private:
-  DNSName d_content;
+  InternedDNSName d_content;
 };
 
 #if !defined(RECURSOR)
@@ -1306,6 +1306,8 @@ struct EDNSOpts
 
 class MOADNSParser;
 bool getEDNSOpts(const MOADNSParser& mdp, EDNSOpts* eo);
+class DNSMessageView;
+bool getEDNSOpts(const DNSMessageView& view, EDNSOpts* eo);
 void reportAllTypes();
 ComboAddress getAddr(const DNSRecord& dr, uint16_t defport=0);
 void checkHostnameCorrectness(const DNSResourceRecord& rr);
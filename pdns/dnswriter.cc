@@ -22,10 +22,7 @@
 #ifdef HAVE_CONFIG_H
 #include "config.h"
 #endif
-#include <boost/version.hpp>
-#if BOOST_VERSION >= 105400
-#include <boost/container/static_vector.hpp>
-#endif
+#include <array>
 #include "dnswriter.hh"
 #include "misc.hh"
 #include "dnsparser.hh"
@@ -206,115 +203,211 @@ template <typename Container> void GenericDNSPacketWriter<Container>::xfrUnquote
 
 static constexpr bool l_verbose=false;
 static constexpr uint16_t maxCompressionOffset=16384;
-template <typename Container> uint16_t GenericDNSPacketWriter<Container>::lookupName(const DNSName& name, uint16_t* matchLen)
+/* names with more labels than that are neither compressed nor used as compression targets */
+using labelpositions_t = boost::container::static_vector<uint16_t, 34>;
+
+/* below that number of names in the packet, scanning them is cheaper than building the compression table */
+static constexpr size_t compressionTableThreshold = 8;
+
+static bool labelsEqual(const uint8_t* lhsBase, const labelpositions_t& lhs, size_t lhsStart, const uint8_t* rhsBase, const labelpositions_t& rhs, size_t rhsStart)
 {
-  // iterate over the written labels, see if we find a match
-  const auto& raw = name.getStorage();
+  if (lhs.size() - lhsStart != rhs.size() - rhsStart) {
+    return false;
+  }
+  for (size_t idx = 0; idx < lhs.size() - lhsStart; idx++) {
+    const uint8_t* lhsLabel = lhsBase + lhs[lhsStart + idx];
+    const uint8_t* rhsLabel = rhsBase + rhs[rhsStart + idx];
+    if (*lhsLabel != *rhsLabel || strncasecmp(reinterpret_cast<const char*>(lhsLabel) + 1, reinterpret_cast<const char*>(rhsLabel) + 1, *lhsLabel) != 0) {
+      return false;
+    }
+  }
+  return true;
+}
 
-  /* name might be a.root-servers.net, we need to be able to benefit from finding:
-     b.root-servers.net, or even:
-     b\xc0\x0c
-  */
-  unsigned int bestpos=0;
-  *matchLen=0;
-  boost::container::static_vector<uint16_t, 34> nvect;
-  boost::container::static_vector<uint16_t, 34> pvect;
-
-  try {
-    for(auto riter= raw.cbegin(); riter < raw.cend(); ) {
-      if(!*riter)
-        break;
-      nvect.push_back(riter - raw.cbegin());
-      riter+=*riter+1;
+// get the positions of the labels of the name starting at pos in the packet, following compression pointers
+template <typename Container> bool GenericDNSPacketWriter<Container>::getLabelPositions(uint16_t pos, labelpositions_t& labels) const
+{
+  labels.clear();
+  for (;;) {
+    if (pos >= d_content.size()) {
+      return false;
+    }
+    const uint8_t labelLen = d_content[pos];
+    if (labelLen & 0xc0) {
+      if (pos + 1U >= d_content.size()) {
+        return false;
+      }
+      const uint16_t target = 0x100 * (labelLen & ~0xc0) + d_content[pos + 1];
+      if (target >= pos) {
+        // we only ever point backwards
+        return false;
+      }
+      pos = target;
+      continue;
+    }
+    if (labelLen == 0) {
+      return true;
     }
+    // compression pointers cannot point here, nor can they point to the labels of a name going over that limit
+    if (pos >= maxCompressionOffset || labels.size() == labels.capacity() || pos + labelLen + 1U > d_content.size()) {
+      return false;
+    }
+    labels.push_back(pos);
+    pos += labelLen + 1;
   }
-  catch(std::bad_alloc& ba) {
-    if(l_verbose)
-      cout<<"Domain "<<name<<" too large to compress"<<endl;
+}
+
+template <typename Container> uint16_t GenericDNSPacketWriter<Container>::findInCompressionTable(uint32_t hash, const uint8_t* base, const labelpositions_t& labels, size_t start) const
+{
+  if (d_compressionTable.empty()) {
     return 0;
   }
-
-  if(l_verbose) {
-    cout<<"Input vector for lookup "<<name<<": ";
-    for(const auto n : nvect)
-      cout << n<<" ";
-    cout<<endl;
-    cout<<makeHexDump(string(raw.c_str(), raw.c_str()+raw.size()))<<endl;
+  const size_t mask = d_compressionTable.size() - 1;
+  labelpositions_t existing;
+  for (size_t slot = hash & mask; d_compressionTable[slot].second != 0; slot = (slot + 1) & mask) {
+    const auto& [entryHash, entryPos] = d_compressionTable[slot];
+    if (entryHash == hash && getLabelPositions(entryPos, existing) && labelsEqual(base, labels, start, d_content.data(), existing, 0)) {
+      return entryPos;
+    }
   }
+  return 0;
+}
 
-  if(l_verbose)
-    cout<<"Have "<<d_namepositions.size()<<" to ponder"<<endl;
-  int counter=1;
-  for(auto p : d_namepositions) {
-    if(l_verbose) {
-      cout<<"Pos: "<<p<<", "<<d_content.size()<<endl;
-      DNSName pname((const char*)&d_content[0], d_content.size(), p, true); // only for debugging
-      cout<<"Looking at '"<<pname<<"' in packet at position "<<p<<"/"<<d_content.size()<<", option "<<counter<<"/"<<d_namepositions.size()<<endl;
-      ++counter;
-    }
-    // memcmp here makes things _slower_
-    pvect.clear();
-    try {
-      for(auto iter = d_content.cbegin() + p; iter < d_content.cend();) {
-        uint8_t c=*iter;
-        if(l_verbose)
-          cout<<"Found label length: "<<(int)c<<endl;
-        if(c & 0xc0) {
-          uint16_t npos = 0x100*(c & (~0xc0)) + *++iter;
-          iter = d_content.begin() + npos;
-          if(l_verbose)
-            cout<<"Is compressed label to newpos "<<npos<<", going there"<<endl;
-          // check against going forward here
-          continue;
+template <typename Container> void GenericDNSPacketWriter<Container>::addToCompressionTable(uint32_t hash, uint16_t pos)
+{
+  if ((d_compressionTableEntries + 1) * 2 > d_compressionTable.size()) {
+    std::vector<std::pair<uint32_t, uint16_t>> table(d_compressionTable.empty() ? 64 : d_compressionTable.size() * 2);
+    const size_t mask = table.size() - 1;
+    for (const auto& entry : d_compressionTable) {
+      if (entry.second != 0) {
+        size_t slot = entry.first & mask;
+        while (table[slot].second != 0) {
+          slot = (slot + 1) & mask;
         }
-        if(!c)
-          break;
-        auto offset = iter - d_content.cbegin();
-        if (offset >= maxCompressionOffset) break; // compression pointers cannot point here
-        pvect.push_back(offset);
-        iter+=*iter+1;
+        table[slot] = entry;
       }
     }
-    catch(std::bad_alloc& ba) {
-      if(l_verbose)
-        cout<<"Domain "<<name<<" too large to compress"<<endl;
+    d_compressionTable = std::move(table);
+  }
+  const size_t mask = d_compressionTable.size() - 1;
+  size_t slot = hash & mask;
+  while (d_compressionTable[slot].second != 0) {
+    slot = (slot + 1) & mask;
+  }
+  d_compressionTable[slot] = {hash, pos};
+  ++d_compressionTableEntries;
+}
+
+/* the hash of a name suffix is derived from the one of its parent, so that we can hash the
+   suffixes of a name in a single pass from the root, whether it is contiguous or not */
+static void hashSuffixes(const uint8_t* base, const labelpositions_t& labels, std::array<uint32_t, 34>& hashes)
+{
+  uint32_t hash = 0;
+  for (size_t idx = labels.size(); idx > 0; idx--) {
+    const uint8_t* label = base + labels[idx - 1];
+    hash = burtleCI(label, *label + 1, hash);
+    hashes.at(idx - 1) = hash;
+  }
+}
+
+// add the suffixes of the names written since the last call to the compression table
+template <typename Container> void GenericDNSPacketWriter<Container>::indexNamePositions()
+{
+  labelpositions_t labels;
+  std::array<uint32_t, 34> hashes{};
+  for (; d_indexedNamePositions < d_namepositions.size(); ++d_indexedNamePositions) {
+    if (!getLabelPositions(d_namepositions[d_indexedNamePositions], labels)) {
       continue;
     }
-    if(l_verbose) {
-      cout<<"Packet vector: "<<endl;
-      for(const auto n : pvect)
-        cout << n<<" ";
-      cout<<endl;
+    hashSuffixes(d_content.data(), labels, hashes);
+    /* the first occurrence of a suffix is the one we point to. When a suffix is
+       already known, so are all of its own suffixes */
+    for (size_t idx = 0; idx < labels.size(); idx++) {
+      if (findInCompressionTable(hashes.at(idx), d_content.data(), labels, idx) != 0) {
+        break;
+      }
+      addToCompressionTable(hashes.at(idx), labels[idx]);
     }
-    auto niter=nvect.crbegin(), piter=pvect.crbegin();
-    unsigned int cmatchlen=1;
-    for(; niter != nvect.crend() && piter != pvect.crend(); ++niter, ++piter) {
-      // niter is an offset in raw, pvect an offset in packet
-      uint8_t nlen = raw[*niter], plen=d_content[*piter];
-      if(l_verbose)
-        cout<<"nlnen="<<(int)nlen<<", plen="<<(int)plen<<endl;
-      if(nlen != plen)
+  }
+}
+
+// compare the name with every name written so far, returns the index in labels of the longest suffix found, and its position
+template <typename Container> std::pair<size_t, uint16_t> GenericDNSPacketWriter<Container>::scanNamePositions(const uint8_t* base, const labelpositions_t& labels) const
+{
+  size_t bestIdx = labels.size();
+  uint16_t bestPos = 0;
+  labelpositions_t existing;
+  for (const auto namePos : d_namepositions) {
+    if (!getLabelPositions(namePos, existing)) {
+      continue;
+    }
+    size_t matched = 0;
+    for (auto liter = labels.crbegin(), eiter = existing.crbegin(); liter != labels.crend() && eiter != existing.crend(); ++liter, ++eiter) {
+      const uint8_t llen = base[*liter];
+      const uint8_t elen = d_content[*eiter];
+      if (llen != elen || strncasecmp(reinterpret_cast<const char*>(base) + *liter + 1, reinterpret_cast<const char*>(&d_content[*eiter]) + 1, llen) != 0) {
         break;
-      if(strncasecmp(raw.c_str()+*niter+1, (const char*)&d_content[*piter]+1, nlen)) {
-        if(l_verbose)
-          cout<<"Mismatch: "<<string(raw.c_str()+*niter+1, raw.c_str()+*niter+nlen+1)<< " != "<<string((const char*)&d_content[*piter]+1, (const char*)&d_content[*piter]+nlen+1)<<endl;
+      }
+      ++matched;
+    }
+    // on a tie the first occurrence wins, as with the compression table
+    if (matched > 0 && labels.size() - matched < bestIdx) {
+      bestIdx = labels.size() - matched;
+      bestPos = existing[existing.size() - matched];
+      if (bestIdx == 0) {
         break;
       }
-      cmatchlen+=nlen+1;
-      if(cmatchlen == raw.length()) { // have matched all of it, can't improve
-        if(l_verbose)
-          cout<<"Stopping search, matched whole name"<<endl;
-        *matchLen = cmatchlen;
-        return *piter;
+    }
+  }
+  return {bestIdx, bestPos};
+}
+
+/* Find the longest suffix of name that we already have in the packet, for example a.root-servers.net
+   can benefit from b.root-servers.net, or even from b\xc0\x0c. Small packets are scanned name by name.
+   Once they hold enough names, a table holding for every suffix of the names written so far the
+   position of its first occurrence is built, so this is O(labels) and yields the same position
+   the scan would. */
+template <typename Container> uint16_t GenericDNSPacketWriter<Container>::lookupName(const DNSName& name, uint16_t* matchLen)
+{
+  const auto& raw = name.getStorage();
+  const auto* base = reinterpret_cast<const uint8_t*>(raw.c_str());
+  *matchLen = 0;
+
+  labelpositions_t nvect;
+  for (size_t pos = 0; pos < raw.size() && raw[pos] != 0; pos += static_cast<uint8_t>(raw[pos]) + 1) {
+    if (nvect.size() == nvect.capacity()) {
+      if (l_verbose) {
+        cout << "Domain " << name << " too large to compress" << endl;
       }
+      return 0;
+    }
+    nvect.push_back(pos);
+  }
+
+  if (d_namepositions.size() < compressionTableThreshold) {
+    auto [idx, pos] = scanNamePositions(base, nvect);
+    if (pos != 0) {
+      *matchLen = raw.size() - nvect[idx];
     }
-    if(piter != pvect.crbegin() && *matchLen < cmatchlen) {
-      *matchLen = cmatchlen;
-      bestpos=*--piter;
+    return pos;
+  }
+
+  indexNamePositions();
+
+  std::array<uint32_t, 34> hashes{};
+  hashSuffixes(base, nvect, hashes);
+  for (size_t idx = 0; idx < nvect.size(); idx++) {
+    if (auto pos = findInCompressionTable(hashes.at(idx), base, nvect, idx); pos != 0) {
+      *matchLen = raw.size() - nvect[idx];
+      if (l_verbose) {
+        cout << "Found a match of " << *matchLen << " bytes for " << name << " at position " << pos << endl;
+      }
+      return pos;
     }
   }
-  return bestpos;
+  return 0;
 }
+
 // this is the absolute hottest function in the pdns recursor
 template <typename Container> void GenericDNSPacketWriter<Container>::xfrName(const DNSName& name, bool compress)
 {
@@ -468,15 +561,26 @@ template <typename Container> uint32_t GenericDNSPacketWriter<Container>::size()
   return d_content.size();
 }
 
+template <typename Container> void GenericDNSPacketWriter<Container>::forgetNamePositions(size_t size)
+{
+  // the names written past that point are gone, rebuild the compression table on the next lookup
+  d_namepositions.erase(std::remove_if(d_namepositions.begin(), d_namepositions.end(), [size](uint16_t pos) { return pos >= size; }), d_namepositions.end());
+  d_compressionTable.clear();
+  d_compressionTableEntries = 0;
+  d_indexedNamePositions = 0;
+}
+
 template <typename Container> void GenericDNSPacketWriter<Container>::rollback()
 {
   d_content.resize(d_rollbackmarker);
+  forgetNamePositions(d_rollbackmarker);
   d_sor = 0;
 }
 
 template <typename Container> void GenericDNSPacketWriter<Container>::truncate()
 {
   d_content.resize(d_truncatemarker);
+  forgetNamePositions(d_truncatemarker);
   dnsheader* dh=reinterpret_cast<dnsheader*>( &*d_content.begin());
   dh->ancount = dh->nscount = dh->arcount = 0;
 }
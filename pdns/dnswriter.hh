@@ -23,6 +23,7 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <boost/container/static_vector.hpp>
 #include "dns.hh"
 #include "dnsname.hh"
 #include "namespaces.hh"
@@ -162,8 +163,21 @@ public:
   size_t getSizeWithOpts(const optvect_t& options) const;
 
 private:
+  using labelpositions_t = boost::container::static_vector<uint16_t, 34>;
+
   uint16_t lookupName(const DNSName& name, uint16_t* matchlen);
+  bool getLabelPositions(uint16_t pos, labelpositions_t& labels) const;
+  std::pair<size_t, uint16_t> scanNamePositions(const uint8_t* base, const labelpositions_t& labels) const;
+  uint16_t findInCompressionTable(uint32_t hash, const uint8_t* base, const labelpositions_t& labels, size_t start) const;
+  void addToCompressionTable(uint32_t hash, uint16_t pos);
+  void indexNamePositions();
+  void forgetNamePositions(size_t size);
+
   vector<uint16_t> d_namepositions;
+  // hash of a name suffix -> position of its first occurrence in the packet, open addressing, only built for larger packets
+  vector<pair<uint32_t, uint16_t>> d_compressionTable;
+  size_t d_compressionTableEntries{0};
+  size_t d_indexedNamePositions{0};
   // We declare 1 uint_16 in the public section, these 3 align on a 8-byte boundary
   uint16_t d_sor;
   uint16_t d_rollbackmarker; // start of last complete packet, for rollback
@@ -27,6 +27,10 @@
 #include <iostream>
 #include <cstdio>
 #include <functional>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
 #include "pdnsexception.hh"
 #include "misc.hh"
 #include <netdb.h>
@@ -1693,6 +1697,141 @@ private:
   size_type d_size{0};
 };
 
+/* Immutable, compiled form of a NetmaskTree, for longest-prefix matching on read-mostly paths.
+   It is a multibit trie with a stride of 8 bits, so a lookup needs at most 4 (IPv4) or 16 (IPv6)
+   dependent loads instead of up to 32 or 128. Prefixes are expanded to the stride boundary and
+   shorter prefixes are pushed down into the nodes created below them (leaf pushing), so every
+   slot holds either the index of the best matching entry for that path or a child node. */
+template <typename T>
+class CompiledNetmaskTree
+{
+public:
+  using node_type = typename NetmaskTree<T>::node_type;
+
+  /* every node of the trie costs s_fanout slots (1 kB), so a single /128 can need up to 15 of them.
+     Compiling throws std::length_error instead of using more than maxMemory bytes */
+  static constexpr size_t s_defaultMaxMemory = 4 * 1024 * 1024;
+
+  explicit CompiledNetmaskTree(const NetmaskTree<T>& tree, size_t maxMemory = s_defaultMaxMemory)
+  {
+    const size_t entriesMemory = tree.size() * sizeof(node_type);
+    if (tree.size() >= s_childFlag || entriesMemory + 2 * s_fanout * sizeof(uint32_t) > maxMemory) {
+      throw std::length_error("Too many entries to compile a netmask tree");
+    }
+    d_maxSlots = (maxMemory - entriesMemory) / sizeof(uint32_t);
+    d_entries.reserve(tree.size());
+    for (const auto& entry : tree) {
+      d_entries.push_back(entry);
+    }
+
+    /* inserting shorter prefixes first means that a more specific prefix always overwrites
+       the slots of a less specific one, and that no child node exists yet below the slots
+       covered by a prefix when it is inserted */
+    std::vector<uint32_t> order(d_entries.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [this](uint32_t lhs, uint32_t rhs) {
+      return d_entries[lhs].first.getBits() < d_entries[rhs].first.getBits();
+    });
+
+    /* nodes 0 and 1 are the IPv4 and IPv6 roots */
+    d_slots.resize(2 * s_fanout, 0);
+    for (const auto idx : order) {
+      insert(d_entries[idx].first, idx + 1);
+    }
+    d_slots.shrink_to_fit();
+  }
+
+  //<! Returns the most specific entry matching address, or nullptr
+  [[nodiscard]] const node_type* lookup(const ComboAddress& address) const
+  {
+    const uint8_t* bytes = nullptr;
+    size_t len = 0;
+    uint32_t node = getRoot(address, bytes, len);
+
+    for (size_t idx = 0; idx < len; idx++) {
+      const uint32_t slot = d_slots[node * s_fanout + bytes[idx]]; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      if ((slot & s_childFlag) == 0) {
+        return slot == 0 ? nullptr : &d_entries[slot - 1];
+      }
+      node = slot & ~s_childFlag;
+    }
+    return nullptr;
+  }
+
+  [[nodiscard]] size_t size() const
+  {
+    return d_entries.size();
+  }
+
+  //<! Approximate number of bytes used by the entries and the trie
+  [[nodiscard]] size_t getMemoryUsage() const
+  {
+    return d_entries.capacity() * sizeof(node_type) + d_slots.capacity() * sizeof(uint32_t);
+  }
+
+private:
+  static uint32_t getRoot(const ComboAddress& address, const uint8_t*& bytes, size_t& len)
+  {
+    if (address.isIPv4()) {
+      bytes = reinterpret_cast<const uint8_t*>(&address.sin4.sin_addr.s_addr); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+      len = sizeof(address.sin4.sin_addr.s_addr);
+      return 0;
+    }
+    if (address.isIPv6()) {
+      bytes = reinterpret_cast<const uint8_t*>(&address.sin6.sin6_addr.s6_addr); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+      len = sizeof(address.sin6.sin6_addr.s6_addr);
+      return 1;
+    }
+    throw NetmaskException("invalid address family");
+  }
+
+  void insert(const Netmask& key, uint32_t result)
+  {
+    const uint8_t* bytes = nullptr;
+    size_t len = 0;
+    uint32_t node = getRoot(key.getNetwork(), bytes, len);
+    const unsigned int bits = key.getBits();
+    unsigned int depth = 0;
+
+    while (bits - depth > s_stride) {
+      const size_t pos = node * s_fanout + bytes[depth / s_stride]; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      const uint32_t slot = d_slots[pos];
+      if ((slot & s_childFlag) != 0) {
+        node = slot & ~s_childFlag;
+      }
+      else {
+        const auto child = static_cast<uint32_t>(d_slots.size() / s_fanout);
+        if (child >= s_childFlag || d_slots.size() + s_fanout > d_maxSlots) {
+          throw std::length_error("Too many nodes to compile a netmask tree");
+        }
+        if (d_slots.size() + s_fanout > d_slots.capacity()) {
+          /* do not let the usual doubling go over the limit */
+          d_slots.reserve(std::min(d_maxSlots, std::max(d_slots.capacity() * 2, d_slots.size() + s_fanout)));
+        }
+        /* the new node inherits the (less specific) match of the slot it replaces */
+        d_slots.resize(d_slots.size() + s_fanout, slot);
+        d_slots[pos] = child | s_childFlag;
+        node = child;
+      }
+      depth += s_stride;
+    }
+
+    /* keys are normalized, so the bits past the prefix length are already zero */
+    const size_t first = bytes[depth / s_stride]; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    const size_t count = 1U << (s_stride - (bits - depth));
+    std::fill_n(d_slots.begin() + static_cast<std::ptrdiff_t>(node * s_fanout + first), count, result);
+  }
+
+  static constexpr unsigned int s_stride = 8;
+  static constexpr size_t s_fanout = 1U << s_stride;
+  static constexpr uint32_t s_childFlag = 0x80000000U;
+
+  size_t d_maxSlots;
+  std::vector<node_type> d_entries;
+  /* s_fanout slots per node: 0 for no match, the index of the entry plus one, or a child node with s_childFlag set */
+  std::vector<uint32_t> d_slots;
+};
+
 /** This class represents a group of supplemental Netmask classes. An IP address matches
     if it is matched by one or more of the Netmask objects within.
 */
@@ -1705,7 +1844,7 @@ public:
 
   bool match(const ComboAddress* address) const
   {
-    const auto& ret = tree.lookup(*address);
+    const auto* ret = lookupNode(*address);
     if (ret != nullptr) {
       return ret->second;
     }
@@ -1719,7 +1858,7 @@ public:
 
   bool lookup(const ComboAddress* address, Netmask* nmp) const
   {
-    const auto& ret = tree.lookup(*address);
+    const auto* ret = lookupNode(*address);
     if (ret != nullptr) {
       if (nmp != nullptr) {
         *nmp = ret->first;
@@ -1749,6 +1888,7 @@ public:
   void addMask(const Netmask& netmask, bool positive = true)
   {
     tree.insert(netmask).second = positive;
+    d_compiled.reset();
   }
 
   void addMasks(const NetmaskGroup& group, boost::optional<bool> positive)
@@ -1762,6 +1902,7 @@ public:
   void deleteMask(const Netmask& netmask)
   {
     tree.erase(netmask);
+    d_compiled.reset();
   }
 
   void deleteMasks(const NetmaskGroup& group)
@@ -1781,6 +1922,29 @@ public:
   void clear()
   {
     tree.clear();
+    d_compiled.reset();
+  }
+
+  /* Builds the compiled form used by match() and lookup() until the next change to the group.
+     Meant to be called once a group that is going to be looked up a lot is fully built.
+     Groups whose compiled form would need more than maxMemory bytes keep using the tree,
+     in which case false is returned */
+  bool compile(size_t maxMemory = CompiledNetmaskTree<bool>::s_defaultMaxMemory)
+  {
+    if (!d_compiled) {
+      try {
+        d_compiled = std::make_shared<const CompiledNetmaskTree<bool>>(tree, maxMemory);
+      }
+      catch (const std::length_error&) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  [[nodiscard]] bool isCompiled() const
+  {
+    return d_compiled != nullptr;
   }
 
   [[nodiscard]] bool empty() const
@@ -1829,7 +1993,16 @@ public:
   }
 
 private:
+  [[nodiscard]] const NetmaskTree<bool>::node_type* lookupNode(const ComboAddress& address) const
+  {
+    if (d_compiled) {
+      return d_compiled->lookup(address);
+    }
+    return tree.lookup(address);
+  }
+
   NetmaskTree<bool> tree;
+  std::shared_ptr<const CompiledNetmaskTree<bool>> d_compiled; // immutable, so it can be shared between copies
 };
 
 struct SComboAddress
@@ -284,14 +284,7 @@ inline int DTime::udiff(bool reset)
 
 inline void toLowerInPlace(string& str)
 {
-  const size_t length = str.length();
-  char c;
-  for (size_t i = 0; i < length; ++i) {
-    c = dns_tolower(str[i]);
-    if (c != str[i]) {
-      str[i] = c;
-    }
-  }
+  dns_tolower_inplace(reinterpret_cast<unsigned char*>(str.data()), str.length()); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
 }
 
 inline const string toLower(const string &upper)
@@ -375,25 +368,16 @@ inline int pdns_ilexicographical_compare_three_way(std::string_view a, std::stri
 inline int pdns_ilexicographical_compare_three_way(std::string_view a, std::string_view b)
 {
   const unsigned char *aPtr = (const unsigned char*)a.data(), *bPtr = (const unsigned char*)b.data();
-  const unsigned char *aEptr = aPtr + a.length(), *bEptr = bPtr + b.length();
-  while(aPtr != aEptr && bPtr != bEptr) {
-    if (*aPtr != *bPtr) {
-      if (int rc = dns_tolower(*aPtr) - dns_tolower(*bPtr); rc != 0) {
-        return rc;
-      }
-    }
-    aPtr++;
-    bPtr++;
+  if (int rc = dns_icompare(aPtr, bPtr, std::min(a.length(), b.length())); rc != 0) {
+    return rc;
   }
   // At this point, one of the strings has been completely processed.
   // Either both have the same length, and they are equal, or one of them
   // is larger, and compares as higher.
-  if (aPtr == aEptr) {
-    if (bPtr != bEptr) {
-      return -1; // a < b
-    }
+  if (a.length() < b.length()) {
+    return -1; // a < b
   }
-  else {
+  if (a.length() > b.length()) {
     return 1; // a > b
   }
   return 0; // a == b
@@ -0,0 +1 @@
+../dnspcap.hh
\ No newline at end of file
@@ -42,6 +42,214 @@ static const std::string rpzClientIPName("rpz-client-ip"),
 
 DNSFilterEngine::DNSFilterEngine() = default;
 
+const DNSFilterEngine::Policy* DNSFilterEngine::NamePolicyMap::find(const DNSName& name) const
+{
+  if (d_size == 0) {
+    return nullptr;
+  }
+  const auto& shard = *d_shards[getShardIndex(name)];
+  auto iter = shard.find(name);
+  if (iter == shard.end()) {
+    return nullptr;
+  }
+  return &iter->second;
+}
+
+DNSFilterEngine::NamePolicyMap::map_t& DNSFilterEngine::NamePolicyMap::getWritableShard(size_t index)
+{
+  auto& shard = d_shards[index];
+  if (shard.use_count() > 1) {
+    /* shared with a copy of this map, which might be in use right now */
+    shard = std::make_shared<map_t>(*shard);
+  }
+  return *shard;
+}
+
+DNSFilterEngine::Policy* DNSFilterEngine::NamePolicyMap::findMutable(const DNSName& name)
+{
+  if (d_size == 0) {
+    return nullptr;
+  }
+  auto index = getShardIndex(name);
+  if (d_shards[index]->count(name) == 0) {
+    return nullptr;
+  }
+  return &getWritableShard(index).find(name)->second;
+}
+
+DNSFilterEngine::Policy& DNSFilterEngine::NamePolicyMap::insert(const DNSName& name, Policy&& pol)
+{
+  if (d_shards.empty() || d_size >= d_shards.size() * s_maxAverageShardSize) {
+    resize(d_shards.empty() ? 1 : d_shards.size() * 4);
+  }
+  auto& shard = getWritableShard(getShardIndex(name));
+  auto [iter, inserted] = shard.insert({name, std::move(pol)});
+  if (inserted) {
+    ++d_size;
+    ++d_generation;
+  }
+  return iter->second;
+}
+
+bool DNSFilterEngine::NamePolicyMap::erase(const DNSName& name)
+{
+  if (d_size == 0) {
+    return false;
+  }
+  auto index = getShardIndex(name);
+  if (d_shards[index]->count(name) == 0) {
+    return false;
+  }
+  getWritableShard(index).erase(name);
+  --d_size;
+  ++d_generation;
+  return true;
+}
+
+void DNSFilterEngine::NamePolicyMap::clear()
+{
+  /* the shards might be shared, just let go of them */
+  d_shards.clear();
+  d_size = 0;
+  ++d_generation;
+}
+
+void DNSFilterEngine::NamePolicyMap::reserve(size_t entriesCount)
+{
+  size_t shardsCount = d_shards.empty() ? 1 : d_shards.size();
+  while (entriesCount > shardsCount * s_maxAverageShardSize) {
+    shardsCount *= 4;
+  }
+  if (shardsCount != d_shards.size()) {
+    resize(shardsCount);
+  }
+}
+
+void DNSFilterEngine::NamePolicyMap::resize(size_t shardsCount)
+{
+  /* this copies every entry, but only happens when the map grows by a factor of 4 */
+  std::vector<std::shared_ptr<map_t>> shards(shardsCount);
+  for (auto& shard : shards) {
+    shard = std::make_shared<map_t>();
+  }
+  for (const auto& shard : d_shards) {
+    for (const auto& pair : *shard) {
+      shards[pair.first.hash() & (shardsCount - 1)]->insert(pair);
+    }
+  }
+  d_shards = std::move(shards);
+}
+
+void DNSFilterEngine::NamePolicyMap::diff(const NamePolicyMap& before, const NamePolicyMap& after, const std::function<void(const DNSName&)>& removed, const std::function<void(const DNSName&)>& added)
+{
+  if (before.d_shards.size() == after.d_shards.size()) {
+    for (size_t idx = 0; idx < before.d_shards.size(); idx++) {
+      const auto& beforeShard = *before.d_shards[idx];
+      const auto& afterShard = *after.d_shards[idx];
+      if (&beforeShard == &afterShard) {
+        /* shared shards are never modified in place */
+        continue;
+      }
+      for (const auto& pair : beforeShard) {
+        if (afterShard.count(pair.first) == 0) {
+          removed(pair.first);
+        }
+      }
+      for (const auto& pair : afterShard) {
+        if (beforeShard.count(pair.first) == 0) {
+          added(pair.first);
+        }
+      }
+    }
+    return;
+  }
+
+  before.visit([&after, &removed](const DNSName& name, const Policy& /* pol */) {
+    if (after.find(name) == nullptr) {
+      removed(name);
+    }
+  });
+  after.visit([&before, &added](const DNSName& name, const Policy& /* pol */) {
+    if (before.find(name) == nullptr) {
+      added(name);
+    }
+  });
+}
+
+DNSFilterEngine::NameIndex::shard_t& DNSFilterEngine::NameIndex::getWritableShard(uint32_t hash)
+{
+  auto& shard = d_shards[hash & (d_shards.size() - 1)];
+  if (shard.use_count() > 1) {
+    /* shared with a copy of this index, which might be in use right now */
+    shard = std::make_shared<shard_t>(*shard);
+  }
+  return *shard;
+}
+
+void DNSFilterEngine::NameIndex::add(uint32_t hash, Priority zoneIdx)
+{
+  if (d_shards.empty() || d_size >= d_shards.size() * s_maxAverageShardSize) {
+    resize(d_shards.empty() ? 1 : d_shards.size() * 4);
+  }
+  auto& shard = getWritableShard(hash);
+  const entry_t entry{hash, zoneIdx};
+  shard.insert(std::upper_bound(shard.begin(), shard.end(), entry), entry);
+  ++d_size;
+}
+
+void DNSFilterEngine::NameIndex::remove(uint32_t hash, Priority zoneIdx)
+{
+  if (d_size == 0) {
+    return;
+  }
+  const entry_t entry{hash, zoneIdx};
+  const auto& shard = *d_shards[hash & (d_shards.size() - 1)];
+  auto iter = std::lower_bound(shard.begin(), shard.end(), entry);
+  if (iter == shard.end() || *iter != entry) {
+    return;
+  }
+  auto offset = std::distance(shard.begin(), iter);
+  auto& writable = getWritableShard(hash);
+  writable.erase(writable.begin() + offset);
+  --d_size;
+}
+
+void DNSFilterEngine::NameIndex::removeZone(Priority zoneIdx)
+{
+  for (auto& shard : d_shards) {
+    auto matches = std::count_if(shard->begin(), shard->end(), [zoneIdx](const entry_t& entry) { return entry.second == zoneIdx; });
+    if (matches == 0) {
+      continue;
+    }
+    if (shard.use_count() > 1) {
+      shard = std::make_shared<shard_t>(*shard);
+    }
+    shard->erase(std::remove_if(shard->begin(), shard->end(), [zoneIdx](const entry_t& entry) { return entry.second == zoneIdx; }), shard->end());
+    d_size -= matches;
+  }
+}
+
+void DNSFilterEngine::NameIndex::clear()
+{
+  d_shards.clear();
+  d_size = 0;
+}
+
+void DNSFilterEngine::NameIndex::resize(size_t shardsCount)
+{
+  /* the entries of a given new shard all come from the same existing shard, so they stay sorted */
+  std::vector<std::shared_ptr<shard_t>> shards(shardsCount);
+  for (auto& shard : shards) {
+    shard = std::make_shared<shard_t>();
+  }
+  for (const auto& shard : d_shards) {
+    for (const auto& entry : *shard) {
+      shards[entry.first & (shardsCount - 1)]->push_back(entry);
+    }
+  }
+  d_shards = std::move(shards);
+}
+
 bool DNSFilterEngine::Zone::findExactQNamePolicy(const DNSName& qname, DNSFilterEngine::Policy& pol) const
 {
   return findExactNamedPolicy(d_qpolName, qname, pol);
@@ -59,7 +267,7 @@ bool DNSFilterEngine::Zone::findExactNSPolicy(const DNSName& qname, DNSFilterEng
 
 bool DNSFilterEngine::Zone::findNSIPPolicy(const ComboAddress& addr, DNSFilterEngine::Policy& pol) const
 {
-  if (const auto* fnd = d_propolNSAddr.lookup(addr)) {
+  if (const auto* fnd = d_propolNSAddr->lookup(addr)) {
     pol = fnd->second;
     pol.setHitData(Zone::maskToRPZ(fnd->first), addr.toString());
     pol.d_hitdata->d_trigger.appendRawLabel(rpzNSIPName);
@@ -70,7 +278,7 @@ bool DNSFilterEngine::Zone::findNSIPPolicy(const ComboAddress& addr, DNSFilterEn
 
 bool DNSFilterEngine::Zone::findResponsePolicy(const ComboAddress& addr, DNSFilterEngine::Policy& pol) const
 {
-  if (const auto* fnd = d_postpolAddr.lookup(addr)) {
+  if (const auto* fnd = d_postpolAddr->lookup(addr)) {
     pol = fnd->second;
     pol.setHitData(Zone::maskToRPZ(fnd->first), addr.toString());
     pol.d_hitdata->d_trigger.appendRawLabel(rpzIPName);
@@ -81,7 +289,7 @@ bool DNSFilterEngine::Zone::findResponsePolicy(const ComboAddress& addr, DNSFilt
 
 bool DNSFilterEngine::Zone::findClientPolicy(const ComboAddress& addr, DNSFilterEngine::Policy& pol) const
 {
-  if (const auto* fnd = d_qpolAddr.lookup(addr)) {
+  if (const auto* fnd = d_qpolAddr->lookup(addr)) {
     pol = fnd->second;
     pol.setHitData(Zone::maskToRPZ(fnd->first), addr.toString());
     pol.d_hitdata->d_trigger.appendRawLabel(rpzClientIPName);
@@ -90,7 +298,7 @@ bool DNSFilterEngine::Zone::findClientPolicy(const ComboAddress& addr, DNSFilter
   return false;
 }
 
-bool DNSFilterEngine::Zone::findNamedPolicy(const std::unordered_map<DNSName, DNSFilterEngine::Policy>& polmap, const DNSName& qname, DNSFilterEngine::Policy& pol)
+bool DNSFilterEngine::Zone::findNamedPolicy(const NamePolicyMap& polmap, const DNSName& qname, DNSFilterEngine::Policy& pol)
 {
   if (polmap.empty()) {
     return false;
@@ -103,35 +311,31 @@ bool DNSFilterEngine::Zone::findNamedPolicy(const std::unordered_map<DNSName, DN
                     *.
    */
 
-  std::unordered_map<DNSName, DNSFilterEngine::Policy>::const_iterator iter;
-  iter = polmap.find(qname);
-
-  if (iter != polmap.end()) {
-    pol = iter->second;
+  if (const auto* found = polmap.find(qname); found != nullptr) {
+    pol = *found;
     return true;
   }
 
   DNSName sub(qname);
   while (sub.chopOff()) {
-    iter = polmap.find(g_wildcarddnsname + sub);
-    if (iter != polmap.end()) {
-      pol = iter->second;
-      pol.setHitData(iter->first, qname.toStringNoDot());
+    DNSName wildcard = g_wildcarddnsname + sub;
+    if (const auto* found = polmap.find(wildcard); found != nullptr) {
+      pol = *found;
+      pol.setHitData(wildcard, qname.toStringNoDot());
       return true;
     }
   }
   return false;
 }
 
-bool DNSFilterEngine::Zone::findExactNamedPolicy(const std::unordered_map<DNSName, DNSFilterEngine::Policy>& polmap, const DNSName& qname, DNSFilterEngine::Policy& pol)
+bool DNSFilterEngine::Zone::findExactNamedPolicy(const NamePolicyMap& polmap, const DNSName& qname, DNSFilterEngine::Policy& pol)
 {
   if (polmap.empty()) {
     return false;
   }
 
-  const auto iter = polmap.find(qname);
-  if (iter != polmap.end()) {
-    pol = iter->second;
+  if (const auto* found = polmap.find(qname); found != nullptr) {
+    pol = *found;
     pol.setHitData(qname, qname.toStringNoDot());
     return true;
   }
@@ -139,6 +343,76 @@ bool DNSFilterEngine::Zone::findExactNamedPolicy(const std::unordered_map<DNSNam
   return false;
 }
 
+bool DNSFilterEngine::areIndexesCurrent() const
+{
+  for (size_t zoneIdx = 0; zoneIdx < d_zones.size(); zoneIdx++) {
+    if (d_zones[zoneIdx] && d_zones[zoneIdx]->getNamesGeneration() != d_indexedGenerations.at(zoneIdx)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool DNSFilterEngine::findNamedPolicyIndexed(const NameIndex& index, const NamePolicyMap& (Zone::*getPolicies)() const, const DNSName& qname, const std::vector<bool>& zoneEnabled, size_t& zoneIdx, DNSName& wildcard) const
+{
+  const auto& storage = qname.getStorage();
+  if (storage.empty()) {
+    return false;
+  }
+
+  /* the first enabled zone having a match wins, and within that zone an exact match wins over
+     a wildcard one, and a more specific wildcard over a less specific one */
+  size_t best = d_zones.size();
+  index.lookup(static_cast<uint32_t>(qname.hash()), [&](Priority candidate) {
+    if (candidate >= best) {
+      return false;
+    }
+    if (zoneEnabled.at(candidate) && (*d_zones[candidate].*getPolicies)().find(qname) != nullptr) {
+      best = candidate;
+      return false;
+    }
+    return true;
+  });
+
+  /* for www.powerdns.com, we need to check *.powerdns.com., *.com. and *.
+     We build these in wire format in a single buffer, from the most specific to the least specific,
+     writing the '*' label over the end of the label we just removed */
+  std::array<char, DNSName::s_maxDNSNameLength + 3> wire{};
+  std::copy(storage.begin(), storage.end(), wire.begin() + 2);
+  for (size_t pos = static_cast<uint8_t>(storage[0]) + 1; pos < storage.size() && best > 0; pos += static_cast<uint8_t>(storage[pos]) + 1) {
+    const size_t length = storage.size() - pos + 2;
+    if (length <= DNSName::s_maxDNSNameLength) {
+      wire.at(pos) = 1;
+      wire.at(pos + 1) = '*';
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast): burtleCI wants unsigned chars
+      auto hash = burtleCI(reinterpret_cast<const unsigned char*>(&wire.at(pos)), length, 0);
+      index.lookup(hash, [&](Priority candidate) {
+        if (candidate >= best) {
+          return false;
+        }
+        if (zoneEnabled.at(candidate)) {
+          DNSName name(&wire.at(pos), length, 0, false);
+          if ((*d_zones[candidate].*getPolicies)().find(name) != nullptr) {
+            best = candidate;
+            wildcard = std::move(name);
+            return false;
+          }
+        }
+        return true;
+      });
+    }
+    if (storage[pos] == 0) {
+      break;
+    }
+  }
+
+  if (best == d_zones.size()) {
+    return false;
+  }
+  zoneIdx = best;
+  return true;
+}
+
 bool DNSFilterEngine::getProcessingPolicy(const DNSName& qname, const std::unordered_map<std::string, bool>& discardedPolicies, Policy& pol) const
 {
   // cout<<"Got question for nameserver name "<<qname<<endl;
@@ -168,6 +442,22 @@ bool DNSFilterEngine::getProcessingPolicy(const DNSName& qname, const std::unord
     return false;
   }
 
+  if (areIndexesCurrent()) {
+    size_t zoneIdx = 0;
+    DNSName wildcard;
+    if (!findNamedPolicyIndexed(d_nsNameIndex, &Zone::getNSPolicies, qname, zoneEnabled, zoneIdx, wildcard)) {
+      return false;
+    }
+    if (!d_zones[zoneIdx]->findExactNSPolicy(wildcard.empty() ? qname : wildcard, pol)) {
+      return false;
+    }
+    if (!wildcard.empty()) {
+      // Hit is not the wildcard but the actual qname!
+      pol.d_hitdata->d_hit = qname.toStringNoDot();
+    }
+    return true;
+  }
+
   /* prepare the wildcard-based names */
   std::vector<DNSName> wcNames;
   wcNames.reserve(qname.countLabels());
@@ -275,6 +565,22 @@ bool DNSFilterEngine::getQueryPolicy(const DNSName& qname, const std::unordered_
     return false;
   }
 
+  if (areIndexesCurrent()) {
+    size_t zoneIdx = 0;
+    DNSName wildcard;
+    if (!findNamedPolicyIndexed(d_qnameIndex, &Zone::getQNamePolicies, qname, zoneEnabled, zoneIdx, wildcard)) {
+      return false;
+    }
+    if (!d_zones[zoneIdx]->findExactQNamePolicy(wildcard.empty() ? qname : wildcard, pol)) {
+      return false;
+    }
+    if (!wildcard.empty()) {
+      // Hit is not the wildcard but the actual qname!
+      pol.d_hitdata->d_hit = qname.toStringNoDot();
+    }
+    return true;
+  }
+
   /* prepare the wildcard-based names */
   std::vector<DNSName> wcNames;
   wcNames.reserve(qname.countLabels());
@@ -366,6 +672,37 @@ void DNSFilterEngine::assureZones(size_t zone)
   }
 }
 
+void DNSFilterEngine::updateIndexes(size_t zoneIdx, const std::shared_ptr<Zone>& newZone)
+{
+  d_indexedGenerations.resize(d_zones.size(), 0);
+  const auto& oldZone = d_zones.at(zoneIdx);
+  const auto priority = static_cast<Priority>(zoneIdx);
+
+  auto update = [priority](NameIndex& index, const NamePolicyMap& before, const NamePolicyMap& after) {
+    NamePolicyMap::diff(
+      before, after,
+      [&index, priority](const DNSName& name) { index.remove(static_cast<uint32_t>(name.hash()), priority); },
+      [&index, priority](const DNSName& name) { index.add(static_cast<uint32_t>(name.hash()), priority); });
+  };
+
+  if (oldZone && oldZone->getNamesGeneration() == d_indexedGenerations.at(zoneIdx)) {
+    /* usually a modified copy of the existing zone, we only need to look at the shards that are no longer shared */
+    update(d_qnameIndex, oldZone->getQNamePolicies(), newZone->getQNamePolicies());
+    update(d_nsNameIndex, oldZone->getNSPolicies(), newZone->getNSPolicies());
+  }
+  else {
+    /* the existing zone has been modified in place, we don't know what the indexes hold for it anymore */
+    if (oldZone) {
+      d_qnameIndex.removeZone(priority);
+      d_nsNameIndex.removeZone(priority);
+    }
+    const NamePolicyMap empty;
+    update(d_qnameIndex, empty, newZone->getQNamePolicies());
+    update(d_nsNameIndex, empty, newZone->getNSPolicies());
+  }
+  d_indexedGenerations.at(zoneIdx) = newZone->getNamesGeneration();
+}
+
 static void addCustom(DNSFilterEngine::Policy& existingPol, const DNSFilterEngine::Policy& pol)
 {
   if (!existingPol.d_custom) {
@@ -377,12 +714,10 @@ static void addCustom(DNSFilterEngine::Policy& existingPol, const DNSFilterEngin
   }
 }
 
-void DNSFilterEngine::Zone::addNameTrigger(std::unordered_map<DNSName, Policy>& map, const DNSName& n, Policy&& pol, bool ignoreDuplicate, PolicyType ptype)
+void DNSFilterEngine::Zone::addNameTrigger(NamePolicyMap& map, const DNSName& n, Policy&& pol, bool ignoreDuplicate, PolicyType ptype)
 {
-  auto iter = map.find(n);
-
-  if (iter != map.end()) {
-    auto& existingPol = iter->second;
+  if (const auto* found = map.find(n); found != nullptr) {
+    const auto& existingPol = *found;
 
     if (pol.d_kind != PolicyKind::Custom && !ignoreDuplicate) {
       if (d_zoneData->d_ignoreDuplicates) {
@@ -398,21 +733,30 @@ void DNSFilterEngine::Zone::addNameTrigger(std::unordered_map<DNSName, Policy>&
       throw std::runtime_error("Adding a " + getTypeToString(ptype) + "-based filter policy of kind " + getKindToString(pol.d_kind) + " but a policy of kind " + getKindToString(existingPol.d_kind) + " already exists for for the following name: " + n.toLogString());
     }
 
-    addCustom(existingPol, pol);
+    addCustom(*map.findMutable(n), pol);
   }
   else {
-    auto& qpol = map.insert({n, std::move(pol)}).first->second;
+    auto& qpol = map.insert(n, std::move(pol));
     qpol.d_zoneData = d_zoneData;
     qpol.d_type = ptype;
   }
 }
 
-void DNSFilterEngine::Zone::addNetmaskTrigger(NetmaskTree<Policy>& nmt, const Netmask& netmask, Policy&& pol, bool ignoreDuplicate, PolicyType ptype)
+NetmaskTree<DNSFilterEngine::Policy>& DNSFilterEngine::Zone::getWritableTree(std::shared_ptr<NetmaskTree<Policy>>& nmt)
 {
-  bool exists = nmt.has_key(netmask);
+  if (nmt.use_count() > 1) {
+    /* shared with a copy of this zone, which might be in use right now */
+    nmt = std::make_shared<NetmaskTree<Policy>>(*nmt);
+  }
+  return *nmt;
+}
+
+void DNSFilterEngine::Zone::addNetmaskTrigger(std::shared_ptr<NetmaskTree<Policy>>& nmt, const Netmask& netmask, Policy&& pol, bool ignoreDuplicate, PolicyType ptype)
+{
+  bool exists = nmt->has_key(netmask);
 
   if (exists) {
-    auto& existingPol = nmt.lookup(netmask)->second;
+    const auto& existingPol = nmt->lookup(netmask)->second;
 
     if (pol.d_kind != PolicyKind::Custom && !ignoreDuplicate) {
       if (d_zoneData->d_ignoreDuplicates) {
@@ -428,28 +772,29 @@ void DNSFilterEngine::Zone::addNetmaskTrigger(NetmaskTree<Policy>& nmt, const Ne
       throw std::runtime_error("Adding a " + getTypeToString(ptype) + "-based filter policy of kind " + getKindToString(pol.d_kind) + " but a policy of kind " + getKindToString(existingPol.d_kind) + " already exists for the following netmask: " + netmask.toString());
     }
 
-    addCustom(existingPol, pol);
+    addCustom(getWritableTree(nmt).lookup(netmask)->second, pol);
   }
   else {
     pol.d_zoneData = d_zoneData;
     pol.d_type = ptype;
-    nmt.insert(netmask).second = std::move(pol);
+    getWritableTree(nmt).insert(netmask).second = std::move(pol);
   }
 }
 
-bool DNSFilterEngine::Zone::rmNameTrigger(std::unordered_map<DNSName, Policy>& map, const DNSName& name, const Policy& pol)
+bool DNSFilterEngine::Zone::rmNameTrigger(NamePolicyMap& map, const DNSName& name, const Policy& pol)
 {
-  auto found = map.find(name);
-  if (found == map.end()) {
+  const auto* found = map.find(name);
+  if (found == nullptr) {
     return false;
   }
 
-  auto& existing = found->second;
-  if (existing.d_kind != DNSFilterEngine::PolicyKind::Custom) {
-    map.erase(found);
+  if (found->d_kind != DNSFilterEngine::PolicyKind::Custom) {
+    map.erase(name);
     return true;
   }
 
+  auto& existing = *map.findMutable(name);
+
   /* for custom types, we might have more than one type,
      and then we need to remove only the right ones. */
   bool result = false;
@@ -467,23 +812,24 @@ bool DNSFilterEngine::Zone::rmNameTrigger(std::unordered_map<DNSName, Policy>& m
 
   // No records left for this trigger?
   if (existing.customRecordsSize() == 0) {
-    map.erase(found);
+    map.erase(name);
     return true;
   }
 
   return result;
 }
 
-bool DNSFilterEngine::Zone::rmNetmaskTrigger(NetmaskTree<Policy>& nmt, const Netmask& netmask, const Policy& pol)
+bool DNSFilterEngine::Zone::rmNetmaskTrigger(std::shared_ptr<NetmaskTree<Policy>>& nmt, const Netmask& netmask, const Policy& pol)
 {
-  bool found = nmt.has_key(netmask);
+  bool found = nmt->has_key(netmask);
   if (!found) {
     return false;
   }
 
-  auto& existing = nmt.lookup(netmask)->second;
+  auto& tree = getWritableTree(nmt);
+  auto& existing = tree.lookup(netmask)->second;
   if (existing.d_kind != DNSFilterEngine::PolicyKind::Custom) {
-    nmt.erase(netmask);
+    tree.erase(netmask);
     return true;
   }
 
@@ -505,7 +851,7 @@ bool DNSFilterEngine::Zone::rmNetmaskTrigger(NetmaskTree<Policy>& nmt, const Net
 
   // No records left for this trigger?
   if (existing.customRecordsSize() == 0) {
-    nmt.erase(netmask);
+    tree.erase(netmask);
     return true;
   }
 
@@ -808,23 +1154,23 @@ void DNSFilterEngine::Zone::dump(FILE* filePtr) const
     fprintf(filePtr, "%s IN SOA %s\n", d_domain.toString().c_str(), soarr->getZoneRepresentation().c_str());
   }
 
-  for (const auto& pair : d_qpolName) {
-    dumpNamedPolicy(filePtr, pair.first + d_domain, pair.second);
-  }
+  d_qpolName.visit([this, filePtr](const DNSName& name, const Policy& pol) {
+    dumpNamedPolicy(filePtr, name + d_domain, pol);
+  });
 
-  for (const auto& pair : d_propolName) {
-    dumpNamedPolicy(filePtr, pair.first + DNSName(rpzNSDnameName) + d_domain, pair.second);
-  }
+  d_propolName.visit([this, filePtr](const DNSName& name, const Policy& pol) {
+    dumpNamedPolicy(filePtr, name + DNSName(rpzNSDnameName) + d_domain, pol);
+  });
 
-  for (const auto& pair : d_qpolAddr) {
+  for (const auto& pair : *d_qpolAddr) {
     dumpAddrPolicy(filePtr, pair.first, DNSName(rpzClientIPName) + d_domain, pair.second);
   }
 
-  for (const auto& pair : d_propolNSAddr) {
+  for (const auto& pair : *d_propolNSAddr) {
     dumpAddrPolicy(filePtr, pair.first, DNSName(rpzNSIPName) + d_domain, pair.second);
   }
 
-  for (const auto& pair : d_postpolAddr) {
+  for (const auto& pair : *d_postpolAddr) {
     dumpAddrPolicy(filePtr, pair.first, DNSName(rpzIPName) + d_domain, pair.second);
   }
 }
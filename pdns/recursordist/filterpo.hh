@@ -25,6 +25,8 @@
 #include "dnsname.hh"
 #include "dnsparser.hh"
 #include "logging.hh"
+#include <algorithm>
+#include <functional>
 #include <map>
 #include <unordered_map>
 #include <limits>
@@ -295,6 +297,115 @@ public:
     [[nodiscard]] DNSRecord getRecordFromCustom(const DNSName& qname, const std::shared_ptr<const DNSRecordContent>& custom) const;
   };
 
+  /* Maps names to policies, like an unordered_map would, but can be copied cheaply:
+     the entries are spread over shards that are shared between copies, and a shard
+     is only duplicated when one of the copies modifies it. Applying an IXFR delta
+     to a copy of a large zone therefore only duplicates the shards it touches. */
+  class NamePolicyMap
+  {
+  public:
+    using map_t = std::unordered_map<DNSName, Policy>;
+
+    [[nodiscard]] const Policy* find(const DNSName& name) const;
+    //! Same as find(), but the shard holding the entry is made private to this map first
+    Policy* findMutable(const DNSName& name);
+    Policy& insert(const DNSName& name, Policy&& pol);
+    bool erase(const DNSName& name);
+    void clear();
+    void reserve(size_t entriesCount);
+
+    [[nodiscard]] size_t size() const
+    {
+      return d_size;
+    }
+    [[nodiscard]] bool empty() const
+    {
+      return d_size == 0;
+    }
+    [[nodiscard]] size_t shardsCount() const
+    {
+      return d_shards.size();
+    }
+    //! Changes every time a name is added to or removed from the map
+    [[nodiscard]] uint64_t getGeneration() const
+    {
+      return d_generation;
+    }
+    //! Calls removed() for every name only present in before, and added() for every name only present in after
+    static void diff(const NamePolicyMap& before, const NamePolicyMap& after, const std::function<void(const DNSName&)>& removed, const std::function<void(const DNSName&)>& added);
+
+    template <typename F>
+    void visit(F func) const
+    {
+      for (const auto& shard : d_shards) {
+        for (const auto& pair : *shard) {
+          func(pair.first, pair.second);
+        }
+      }
+    }
+
+  private:
+    static constexpr size_t s_maxAverageShardSize = 512;
+
+    [[nodiscard]] size_t getShardIndex(const DNSName& name) const
+    {
+      return name.hash() & (d_shards.size() - 1);
+    }
+    map_t& getWritableShard(size_t index);
+    void resize(size_t shardsCount);
+
+    std::vector<std::shared_ptr<map_t>> d_shards;
+    size_t d_size{0};
+    uint64_t d_generation{0};
+  };
+
+  /* Merged index of the names present in the NamePolicyMap of every zone, so that
+     finding the first zone having an exact or wildcard policy for a name costs one
+     probe per label of the name, instead of one per label and per zone, and does not
+     need to build the wildcard names. Only the hash of the names and the index of the
+     zones are stored, possible matches are then confirmed against the zone itself.
+     It is sharded and shared between copies the same way NamePolicyMap is. */
+  class NameIndex
+  {
+  public:
+    void add(uint32_t hash, Priority zoneIdx);
+    void remove(uint32_t hash, Priority zoneIdx);
+    void removeZone(Priority zoneIdx);
+    void clear();
+
+    //! Calls func() with the index of every zone having a name of that hash, in increasing order, until it returns false
+    template <typename F>
+    void lookup(uint32_t hash, F func) const
+    {
+      if (d_size == 0) {
+        return;
+      }
+      const auto& shard = *d_shards[hash & (d_shards.size() - 1)];
+      for (auto iter = std::lower_bound(shard.begin(), shard.end(), entry_t{hash, 0}); iter != shard.end() && iter->first == hash; ++iter) {
+        if (!func(iter->second)) {
+          return;
+        }
+      }
+    }
+
+    [[nodiscard]] size_t size() const
+    {
+      return d_size;
+    }
+
+  private:
+    /* name hash, zone index, kept sorted */
+    using entry_t = std::pair<uint32_t, Priority>;
+    using shard_t = std::vector<entry_t>;
+    static constexpr size_t s_maxAverageShardSize = 512;
+
+    shard_t& getWritableShard(uint32_t hash);
+    void resize(size_t shardsCount);
+
+    std::vector<std::shared_ptr<shard_t>> d_shards;
+    size_t d_size{0};
+  };
+
   class Zone
   {
   public:
@@ -305,10 +416,11 @@ public:
 
     void clear()
     {
-      d_qpolAddr.clear();
-      d_postpolAddr.clear();
+      /* the trees might be shared with a copy of this zone, never clear them in place */
+      d_qpolAddr = std::make_shared<NetmaskTree<Policy>>();
+      d_postpolAddr = std::make_shared<NetmaskTree<Policy>>();
       d_propolName.clear();
-      d_propolNSAddr.clear();
+      d_propolNSAddr = std::make_shared<NetmaskTree<Policy>>();
       d_qpolName.clear();
     }
     void reserve(size_t entriesCount)
@@ -381,7 +493,7 @@ public:
 
     [[nodiscard]] size_t size() const
     {
-      return d_qpolAddr.size() + d_postpolAddr.size() + d_propolName.size() + d_propolNSAddr.size() + d_qpolName.size();
+      return d_qpolAddr->size() + d_postpolAddr->size() + d_propolName.size() + d_propolNSAddr->size() + d_qpolName.size();
     }
 
     void setIncludeSOA(bool flag)
@@ -416,7 +528,7 @@ public:
 
     [[nodiscard]] bool hasClientPolicies() const
     {
-      return !d_qpolAddr.empty();
+      return !d_qpolAddr->empty();
     }
     [[nodiscard]] bool hasQNamePolicies() const
     {
@@ -428,11 +540,11 @@ public:
     }
     [[nodiscard]] bool hasNSIPPolicies() const
     {
-      return !d_propolNSAddr.empty();
+      return !d_propolNSAddr->empty();
     }
     [[nodiscard]] bool hasResponsePolicies() const
     {
-      return !d_postpolAddr.empty();
+      return !d_postpolAddr->empty();
     }
     [[nodiscard]] Priority getPriority() const
     {
@@ -442,25 +554,41 @@ public:
     {
       d_zoneData->d_priority = priority;
     }
+    [[nodiscard]] const NamePolicyMap& getQNamePolicies() const
+    {
+      return d_qpolName;
+    }
+    [[nodiscard]] const NamePolicyMap& getNSPolicies() const
+    {
+      return d_propolName;
+    }
+    //! Changes every time a name-based trigger is added or removed
+    [[nodiscard]] uint64_t getNamesGeneration() const
+    {
+      return d_qpolName.getGeneration() + d_propolName.getGeneration();
+    }
 
     static DNSName maskToRPZ(const Netmask& netmask);
 
   private:
-    void addNameTrigger(std::unordered_map<DNSName, Policy>& map, const DNSName& n, Policy&& pol, bool ignoreDuplicate, PolicyType ptype);
-    void addNetmaskTrigger(NetmaskTree<Policy>& nmt, const Netmask& netmask, Policy&& pol, bool ignoreDuplicate, PolicyType ptype);
-    static bool rmNameTrigger(std::unordered_map<DNSName, Policy>& map, const DNSName& n, const Policy& pol);
-    static bool rmNetmaskTrigger(NetmaskTree<Policy>& nmt, const Netmask& netmask, const Policy& pol);
-
-    static bool findExactNamedPolicy(const std::unordered_map<DNSName, DNSFilterEngine::Policy>& polmap, const DNSName& qname, DNSFilterEngine::Policy& pol);
-    static bool findNamedPolicy(const std::unordered_map<DNSName, DNSFilterEngine::Policy>& polmap, const DNSName& qname, DNSFilterEngine::Policy& pol);
+    void addNameTrigger(NamePolicyMap& map, const DNSName& n, Policy&& pol, bool ignoreDuplicate, PolicyType ptype);
+    void addNetmaskTrigger(std::shared_ptr<NetmaskTree<Policy>>& nmt, const Netmask& netmask, Policy&& pol, bool ignoreDuplicate, PolicyType ptype);
+    static bool rmNameTrigger(NamePolicyMap& map, const DNSName& n, const Policy& pol);
+    static bool rmNetmaskTrigger(std::shared_ptr<NetmaskTree<Policy>>& nmt, const Netmask& netmask, const Policy& pol);
+    static NetmaskTree<Policy>& getWritableTree(std::shared_ptr<NetmaskTree<Policy>>& nmt);
+
+    static bool findExactNamedPolicy(const NamePolicyMap& polmap, const DNSName& qname, DNSFilterEngine::Policy& pol);
+    static bool findNamedPolicy(const NamePolicyMap& polmap, const DNSName& qname, DNSFilterEngine::Policy& pol);
     static void dumpNamedPolicy(FILE* filePtr, const DNSName& name, const Policy& pol);
     static void dumpAddrPolicy(FILE* filePtr, const Netmask& netmask, const DNSName& name, const Policy& pol);
 
-    std::unordered_map<DNSName, Policy> d_qpolName; // QNAME trigger (RPZ)
-    NetmaskTree<Policy> d_qpolAddr; // Source address
-    std::unordered_map<DNSName, Policy> d_propolName; // NSDNAME (RPZ)
-    NetmaskTree<Policy> d_propolNSAddr; // NSIP (RPZ)
-    NetmaskTree<Policy> d_postpolAddr; // IP trigger (RPZ)
+    /* copying a zone shares all of these with the copy, see NamePolicyMap
+       and getWritableTree() for how they are then modified */
+    NamePolicyMap d_qpolName; // QNAME trigger (RPZ)
+    std::shared_ptr<NetmaskTree<Policy>> d_qpolAddr{std::make_shared<NetmaskTree<Policy>>()}; // Source address
+    NamePolicyMap d_propolName; // NSDNAME (RPZ)
+    std::shared_ptr<NetmaskTree<Policy>> d_propolNSAddr{std::make_shared<NetmaskTree<Policy>>()}; // NSIP (RPZ)
+    std::shared_ptr<NetmaskTree<Policy>> d_postpolAddr{std::make_shared<NetmaskTree<Policy>>()}; // IP trigger (RPZ)
     DNSName d_domain;
     std::shared_ptr<PolicyZoneData> d_zoneData{nullptr};
     uint32_t d_serial{0};
@@ -470,13 +598,21 @@ public:
   DNSFilterEngine();
   void clear()
   {
-    for (auto& zone : d_zones) {
-      zone->clear();
+    d_qnameIndex.clear();
+    d_nsNameIndex.clear();
+    for (size_t zoneIdx = 0; zoneIdx < d_zones.size(); zoneIdx++) {
+      if (d_zones[zoneIdx]) {
+        d_zones[zoneIdx]->clear();
+        d_indexedGenerations.at(zoneIdx) = d_zones[zoneIdx]->getNamesGeneration();
+      }
     }
   }
   void clearZones()
   {
     d_zones.clear();
+    d_qnameIndex.clear();
+    d_nsNameIndex.clear();
+    d_indexedGenerations.clear();
   }
   [[nodiscard]] std::shared_ptr<Zone> getZone(size_t zoneIdx) const
   {
@@ -499,7 +635,9 @@ public:
   size_t addZone(const std::shared_ptr<Zone>& newZone)
   {
     newZone->setPriority(d_zones.size());
-    d_zones.push_back(newZone);
+    d_zones.push_back(nullptr);
+    updateIndexes(d_zones.size() - 1, newZone);
+    d_zones.back() = newZone;
     return (d_zones.size() - 1);
   }
   void setZone(size_t zoneIdx, const std::shared_ptr<Zone>& newZone)
@@ -507,6 +645,7 @@ public:
     if (newZone) {
       assureZones(zoneIdx);
       newZone->setPriority(zoneIdx);
+      updateIndexes(zoneIdx, newZone);
       d_zones[zoneIdx] = newZone;
     }
   }
@@ -571,7 +710,16 @@ public:
 
 private:
   void assureZones(size_t zone);
+  void updateIndexes(size_t zoneIdx, const std::shared_ptr<Zone>& newZone);
+  [[nodiscard]] bool areIndexesCurrent() const;
+  bool findNamedPolicyIndexed(const NameIndex& index, const NamePolicyMap& (Zone::*getPolicies)() const, const DNSName& qname, const std::vector<bool>& zoneEnabled, size_t& zoneIdx, DNSName& trigger) const;
+
   vector<std::shared_ptr<Zone>> d_zones;
+  /* kept in sync by addZone() and setZone(), but zones modified in place after having been added
+     are not reflected, and we then fall back to looking into every zone */
+  NameIndex d_qnameIndex;
+  NameIndex d_nsNameIndex;
+  std::vector<uint64_t> d_indexedGenerations;
 };
 
 void mergePolicyTags(std::unordered_set<std::string>& tags, const std::unordered_set<std::string>& newTags);
@@ -439,6 +439,8 @@ static LWResult::Result asyncresolve(const ComboAddress& address, const DNSName&
   }
   lwr->d_rcode = 0;
   lwr->d_haveEDNS = false;
+  lwr->d_hedged = false;
+  lwr->d_hedgeWon = false;
   LWResult::Result ret;
 
   DTime dt;
@@ -496,7 +498,12 @@ static LWResult::Result asyncresolve(const ComboAddress& address, const DNSName&
 #endif /* HAVE_FSTRM */
 
     // sleep until we see an answer to this, interface to mtasker
-    ret = arecvfrom(buf, 0, address, len, qid, domain, type, queryfd, subnetOpts, *now);
+    if (context.d_hedgeAddress && !*chained) {
+      ret = arecvfromHedged(buf, address, len, qid, domain, type, queryfd, subnetOpts, *now, context.d_timeoutMsec, vpacket, *context.d_hedgeAddress, context.d_hedgeAfterMsec, *lwr);
+    }
+    else {
+      ret = arecvfrom(buf, 0, address, len, qid, domain, type, queryfd, subnetOpts, *now, context.d_timeoutMsec);
+    }
   }
   else {
     bool isNew;
@@ -563,12 +570,16 @@ static LWResult::Result asyncresolve(const ComboAddress& address, const DNSName&
   lwr->d_records.clear();
   try {
     lwr->d_tcbit = 0;
-    MOADNSParser mdp(false, reinterpret_cast<const char*>(buf.data()), buf.size());
-    lwr->d_aabit = mdp.d_header.aa;
-    lwr->d_tcbit = mdp.d_header.tc;
-    lwr->d_rcode = mdp.d_header.rcode;
+    DNSMessageView view(false, std::string_view(reinterpret_cast<const char*>(buf.data()), buf.size()));
+    const auto& header = view.getHeader();
+    if (header.opcode != Opcode::Query && header.opcode != Opcode::Notify && header.opcode != Opcode::Update) {
+      throw MOADNSException("Can't parse non-query packet with opcode=" + std::to_string(header.opcode));
+    }
+    lwr->d_aabit = header.aa;
+    lwr->d_tcbit = header.tc;
+    lwr->d_rcode = header.rcode;
 
-    if (mdp.d_header.rcode == RCode::FormErr && mdp.d_qname.empty() && mdp.d_qtype == 0 && mdp.d_qclass == 0) {
+    if (header.rcode == RCode::FormErr && !view.hasQuestion()) {
       if (outgoingLoggers) {
         logIncomingResponse(outgoingLoggers, context.d_initialRequestId, uuid, address, domain, type, qid, doTCP, dnsOverTLS, srcmask, len, lwr->d_rcode, lwr->d_records, queryTime, exportTypes, nsName);
       }
@@ -576,24 +587,26 @@ static LWResult::Result asyncresolve(const ComboAddress& address, const DNSName&
       return LWResult::Result::Success; // this is "success", the error is set in lwr->d_rcode
     }
 
-    if (domain != mdp.d_qname) {
-      if (!mdp.d_qname.empty() && domain.toString().find((char)0) == string::npos /* ugly */) { // embedded nulls are too noisy, plus empty domains are too
-        SLOG(g_log << Logger::Notice << "Packet purporting to come from remote server " << address.toString() << " contained wrong answer: '" << domain << "' != '" << mdp.d_qname << "'" << endl,
+    if (!view.isQName(domain)) {
+      if (view.hasQuestion() && domain.toString().find((char)0) == string::npos /* ugly */) { // embedded nulls are too noisy, plus empty domains are too
+        const auto onwire = view.getQName();
+        SLOG(g_log << Logger::Notice << "Packet purporting to come from remote server " << address.toString() << " contained wrong answer: '" << domain << "' != '" << onwire << "'" << endl,
              g_slogout->info(Logr::Notice, "Packet purporting to come from remote server contained wrong answer",
                              "server", Logging::Loggable(address),
                              "qname", Logging::Loggable(domain),
-                             "onwire", Logging::Loggable(mdp.d_qname)));
+                             "onwire", Logging::Loggable(onwire)));
       }
       // unexpected count has already been done @ pdns_recursor.cc
       goto out;
     }
 
-    lwr->d_records.reserve(mdp.d_answers.size());
-    for (const auto& answer : mdp.d_answers) {
-      lwr->d_records.push_back(answer);
+    // records are only decoded now that we know the answer is for us, straight into their final place
+    lwr->d_records.reserve(view.getRecords().size());
+    for (const auto& record : view.getRecords()) {
+      lwr->d_records.push_back(view.getRecord(record));
     }
 
-    if (EDNSOpts edo; EDNS0Level > 0 && getEDNSOpts(mdp, &edo)) {
+    if (EDNSOpts edo; EDNS0Level > 0 && getEDNSOpts(view, &edo)) {
       lwr->d_haveEDNS = true;
 
       // If we sent out ECS, we can also expect to see a return with or without ECS, the absent case
@@ -86,13 +86,20 @@ public:
   bool d_validpacket{false};
   bool d_aabit{false}, d_tcbit{false};
   bool d_haveEDNS{false};
+  bool d_hedged{false}; // the query was also sent to the hedge address of the ResolveContext
+  bool d_hedgeWon{false}; // and that is where this answer came from
 };
 
 class EDNSSubnetOpts;
 
 LWResult::Result asendto(const void* data, size_t len, int flags, const ComboAddress& toAddress, uint16_t qid,
                          const DNSName& domain, uint16_t qtype, const std::optional<EDNSSubnetOpts>& ecs, int* fileDesc, timeval& now);
+// A timeoutMsec of 0 means the default timeout, see authWaitTimeMSec()
 LWResult::Result arecvfrom(PacketBuffer& packet, int flags, const ComboAddress& fromAddr, size_t& len, uint16_t qid,
-                           const DNSName& domain, uint16_t qtype, int fileDesc, const std::optional<EDNSSubnetOpts>& ecs, const struct timeval& now);
+                           const DNSName& domain, uint16_t qtype, int fileDesc, const std::optional<EDNSSubnetOpts>& ecs, const struct timeval& now, unsigned int timeoutMsec);
+// Same, but if no answer came after afterMsec, query is also sent to hedgeAddress and the first usable answer is returned
+LWResult::Result arecvfromHedged(PacketBuffer& packet, const ComboAddress& fromAddr, size_t& len, uint16_t qid, const DNSName& domain, uint16_t qtype,
+                                 int fileDesc, const std::optional<EDNSSubnetOpts>& ecs, const struct timeval& now, unsigned int timeoutMsec,
+                                 const std::vector<uint8_t>& query, const ComboAddress& hedgeAddress, unsigned int afterMsec, LWResult& lwr);
 
 LWResult::Result asyncresolve(const ComboAddress& address, const DNSName& domain, int type, bool doTCP, bool sendRDQuery, int EDNS0Level, struct timeval* now, boost::optional<Netmask>& srcmask, const ResolveContext& context, const std::shared_ptr<std::vector<std::unique_ptr<RemoteLogger>>>& outgoingLoggers, const std::shared_ptr<std::vector<std::unique_ptr<FrameStreamLogger>>>& fstrmLoggers, const std::set<uint16_t>& exportTypes, LWResult* lwr, bool* chained);
@@ -0,0 +1 @@
+../../../m4/pdns_enable_inline_dnsname_storage.m4
\ No newline at end of file
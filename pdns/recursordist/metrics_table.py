@@ -1384,6 +1384,15 @@
         'pname': 'cumul-authanswers-count4', # For cumulative histogram, state the xxx_count name where xxx matches the name in rec_channel_rec
         # No SNMP
     },
+    {
+        'name': 'cumul-adaptivetimeouts-x',
+        # No lambda
+        'desc': 'Cumulative counts of the adaptive timeouts used for outgoing UDP queries in buckets less than x microseconds.',
+        'longdesc': 'See :ref:`setting-yaml-outgoing.adaptive_network_timeout_max`. Disabled by default, see :ref:`setting-yaml-recursor.stats_rec_control_disabled_list`. These metrics are useful for Prometheus and not listed in other outputs by default.',
+        'ptype': 'histogram',
+        'pname': 'cumul-adaptivetimeouts-count', # For cumulative histogram, state the xxx_count name where xxx matches the name in rec_channel_rec
+        # No SNMP
+    },
     {
         'name': 'policy-hits',
         # No lambda
@@ -1401,10 +1410,100 @@
         'pname': 'proxy-mapping-total-n-0', # For multicounters, state the first
         # No SNMP
     },
+    {
+        'name': 'interned-names',
+        'lambda': '[] { return InternedDNSName::getInternedCount(); }',
+        'ptype': 'gauge',
+        'desc': 'Number of distinct names shared between cache entries',
+        'longdesc': '''Only non-zero when :ref:`setting-yaml-recordcache.intern_names` is enabled.''',
+        # No SNMP
+    },
     {
         'name': 'ecs-missing',
         'lambda': '[] { return g_Counters.sum(rec::Counter::ecsMissingCount); }',
         'desc': 'Number of answers where ECS info was missing',
         'snmp': 153,
     },
+    {
+        'name': 'outgoing-udp-batched-queries',
+        'lambda': '[] { return g_Counters.sum(rec::Counter::udpBatchedQueries); }',
+        'desc': 'Number of outgoing UDP queries sent in batches from pooled sockets',
+        'longdesc': '''Only non-zero when :ref:`setting-yaml-outgoing.udp_batch_sockets` is set. Divided by ``outgoing-udp-batch-syscalls``, this gives the average number of queries sent per system call.''',
+        # No SNMP
+    },
+    {
+        'name': 'outgoing-udp-batch-syscalls',
+        'lambda': '[] { return g_Counters.sum(rec::Counter::udpBatchSyscalls); }',
+        'desc': 'Number of system calls made to send batched outgoing UDP queries',
+        # No SNMP
+    },
+    {
+        'name': 'hedged-queries',
+        'lambda': '[] { return g_Counters.sum(rec::Counter::hedgedQueries); }',
+        'desc': 'Number of queries also sent to another authoritative server because the first one was slow to answer',
+        'longdesc': '''Only non-zero when :ref:`setting-yaml-outgoing.max_hedged_qperq` is set. These queries are also counted in ``all-outqueries``.''',
+        # No SNMP
+    },
+    {
+        'name': 'hedged-queries-won',
+        'lambda': '[] { return g_Counters.sum(rec::Counter::hedgedQueriesWon); }',
+        'desc': 'Number of hedged queries whose answer arrived before the one of the server first asked',
+        # No SNMP
+    },
+    {
+        'name': 'glueless-ns-prefetches',
+        'lambda': '[] { return g_Counters.sum(rec::Counter::gluelessNSPrefetches); }',
+        'desc': 'Number of background tasks pushed to resolve the addresses of glueless nameservers of a delegation',
+        'longdesc': '''Only non-zero when :ref:`setting-yaml-outgoing.glueless_ns_prefetch` is set.''',
+        # No SNMP
+    },
+    {
+        'name': 'glueless-ns-prefetch-hits',
+        'lambda': '[] { return g_Counters.sum(rec::Counter::gluelessNSPrefetchHits); }',
+        'desc': 'Number of times the addresses of a nameserver were found in the cache thanks to a glueless nameserver prefetch',
+        'longdesc': '''Each hit is a nameserver address resolution that did not have to be done while processing the client query.''',
+        # No SNMP
+    },
+    {
+        'name': 'udp-fast-path-answers',
+        'lambda': '[] { return g_Counters.sum(rec::Counter::udpFastPathAnswers); }',
+        'desc': 'Number of UDP queries answered from the packet cache by the UDP fast path',
+        'longdesc': '''Only non-zero when :ref:`setting-yaml-incoming.udp_fast_path_batch_size` is set. These answers are also counted in ``packetcache-hits``.''',
+        # No SNMP
+    },
+    {
+        'name': 'udp-fast-path-batches',
+        'lambda': '[] { return g_Counters.sum(rec::Counter::udpFastPathBatches); }',
+        'desc': 'Number of batches of UDP queries read by the UDP fast path',
+        'longdesc': '''Divided by ``questions``, this gives an idea of the average number of queries read per system call.''',
+        # No SNMP
+    },
+    {
+        'name': 'chained-outqueries',
+        'lambda': '[] { return g_Counters.sum(rec::Counter::chainedOutQueries); }',
+        'desc': 'Number of outgoing queries not sent because an identical query was already in flight from the same worker thread',
+        'longdesc': '''Such queries are chained to the query in flight and get its answer, see also ``chain-resends``.''',
+        # No SNMP
+    },
+    {
+        'name': 'cross-thread-duplicate-outqueries',
+        'lambda': '[] { return g_Counters.sum(rec::Counter::crossThreadDuplicateOutQueries); }',
+        'desc': 'Estimated number of outgoing queries sent while an identical query was in flight from another worker thread',
+        'longdesc': '''Unlike queries from the same thread, these cannot be chained. Compare with ``chained-outqueries`` to evaluate :ref:`setting-yaml-incoming.distribution_hash`. This is an estimate, based on a fixed-size table of recently sent queries.''',
+        # No SNMP
+    },
+    {
+        'name': 'cross-thread-chained-outqueries',
+        'lambda': '[] { return g_Counters.sum(rec::Counter::crossThreadChainedOutQueries); }',
+        'desc': 'Number of outgoing queries not sent because an identical query was in flight from another thread',
+        'longdesc': '''These queries wait for the answer to the query sent by the other thread, see :ref:`setting-yaml-recursor.max_cross_thread_chain_length`.''',
+        # No SNMP
+    },
+    {
+        'name': 'cross-thread-chain-lost',
+        'lambda': '[] { return g_Counters.sum(rec::Counter::crossThreadChainLost); }',
+        'desc': 'Number of answers that could not be handed to a query waiting in another thread',
+        'longdesc': '''This happens when the pipe to the other thread is full, the waiting query then times out.''',
+        # No SNMP
+    },
 ]
@@ -84,7 +84,7 @@ bool PersistentSBF::init(bool ignore_pid)
             SLOG(g_log << Logger::Warning << "Found SBF file " << filename << endl,
                  log->info(Logr::Warning, "Found SBF File", "file", Logging::Loggable(filename)));
             // read the file into the sbf
-            d_sbf.lock()->restore(infile);
+            d_sbf.restore(infile);
             infile.close();
             // now dump it out again with new thread id & process id
             snapshotCurrent(std::this_thread::get_id());
@@ -122,9 +122,9 @@ void PersistentSBF::setCacheDir(const std::string& cachedir)
 }
 
 // Dump the SBF to a file
-// To spend the least amount of time inside the mutex, we dump to an
-// intermediate stringstream, otherwise the lock would be waiting for
-// file IO to complete
+// The filter keeps being updated while it is dumped to an intermediate
+// stringstream, the snapshot is therefore only approximately consistent,
+// which is fine for a stable bloom filter
 bool PersistentSBF::snapshotCurrent(std::thread::id tid)
 {
   auto log = g_slog->withName("nod");
@@ -137,10 +137,7 @@ bool PersistentSBF::snapshotCurrent(std::thread::id tid)
     if (filesystem::exists(path) && filesystem::is_directory(path)) {
       try {
         std::ostringstream oss;
-        {
-          // only lock while dumping to a stringstream
-          d_sbf.lock()->dump(oss);
-        }
+        d_sbf.dump(oss);
         // Now write it out to the file
         std::string ftmp = file.string() + ".XXXXXXXX";
         auto fileDesc = FDWrapper(mkstemp(ftmp.data()));
@@ -26,7 +26,6 @@
 #include <boost/filesystem.hpp>
 
 #include "dnsname.hh"
-#include "lock.hh"
 #include "stable-bloom.hh"
 
 namespace nod
@@ -38,36 +37,35 @@ const unsigned int snapshot_interval_default = 600;
 const std::string bf_suffix = "bf";
 const std::string sbf_prefix = "sbf";
 
-// Theses classes are not designed to be shared between threads
-// Use a new instance per-thread, e.g. using thread local storage
+// These classes can be shared between threads, the filter does not need any locking
 // Synchronization (at the class level) is still needed for reading from
 // and writing to the cache dir
-// Synchronization (at the instance level) is needed when snapshotting
+// init() should be called before the instance is used by other threads
 class PersistentSBF
 {
 public:
   PersistentSBF() :
-    d_sbf(bf::stableBF(c_fp_rate, c_num_cells, c_num_dec)) {}
+    d_sbf(c_fp_rate, c_num_cells, c_num_dec) {}
   PersistentSBF(uint32_t num_cells) :
-    d_sbf(bf::stableBF(c_fp_rate, num_cells, c_num_dec)) {}
+    d_sbf(c_fp_rate, num_cells, c_num_dec) {}
   bool init(bool ignore_pid = false);
   void setPrefix(const std::string& prefix) { d_prefix = prefix; } // Added to filenames in cachedir
   void setCacheDir(const std::string& cachedir);
   bool snapshotCurrent(std::thread::id tid); // Write the current file out to disk
   void add(const std::string& data)
   {
-    d_sbf.lock()->add(data);
+    d_sbf.add(data);
   }
-  bool test(const std::string& data) { return d_sbf.lock()->test(data); }
+  bool test(const std::string& data) const { return d_sbf.test(data); }
   bool testAndAdd(const std::string& data)
   {
-    return d_sbf.lock()->testAndAdd(data);
+    return d_sbf.testAndAdd(data);
   }
 
 private:
   void remove_tmp_files(const boost::filesystem::path&, std::scoped_lock<std::mutex>&);
 
-  LockGuarded<bf::stableBF> d_sbf; // Stable Bloom Filter
+  bf::concurrentStableBF d_sbf; // Stable Bloom Filter
   std::string d_cachedir;
   std::string d_prefix = sbf_prefix;
   // One mutex for all instances of this class, used to avoid multiple init() calls happening
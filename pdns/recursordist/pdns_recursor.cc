@@ -71,6 +71,7 @@ static set<int> g_fromtosockets; // listen sockets that use 'sendfromto()' mecha
 NetmaskGroup g_paddingFrom;
 size_t g_proxyProtocolMaximumSize;
 size_t g_maxUDPQueriesPerRound;
+size_t g_udpFastPathBatchSize;
 unsigned int g_maxMThreads;
 unsigned int g_paddingTag;
 PaddingMode g_paddingMode;
@@ -86,6 +87,7 @@ boost::container::flat_set<uint16_t> g_avoidUdpSourcePorts;
 uint16_t g_minUdpSourcePort;
 uint16_t g_maxUdpSourcePort;
 double g_balancingFactor;
+DistributionHash g_distributionHash{DistributionHash::QName};
 
 bool g_lowercaseOutgoing;
 unsigned int g_networkTimeoutMsec;
@@ -130,6 +132,18 @@ LWResult::Result UDPClientSocks::getSocket(const ComboAddress& toaddr, int* file
 // return a socket to the pool, or simply erase it
 void UDPClientSocks::returnSocket(int fileDesc)
 {
+  auto pooled = d_pooled.find(fileDesc);
+  if (pooled != d_pooled.end()) {
+    // shared with other queries, only closed once it has been retired and the last of them is done
+    if (pooled->second.d_outstanding > 0) {
+      --pooled->second.d_outstanding;
+    }
+    if (!pooled->second.d_retired || pooled->second.d_outstanding > 0) {
+      return;
+    }
+    d_pooled.erase(pooled);
+  }
+
   try {
     t_fdm->removeReadFD(fileDesc);
   }
@@ -149,7 +163,7 @@ void UDPClientSocks::returnSocket(int fileDesc)
 }
 
 // returns -1 for errors which might go away, throws for ones that won't
-int UDPClientSocks::makeClientSocket(int family)
+int UDPClientSocks::makeClientSocket(int family, bool receiveErrors)
 {
   int ret = socket(family, SOCK_DGRAM, 0); // turns out that setting CLO_EXEC and NONBLOCK from here is not a performance win on Linux (oddly enough)
 
@@ -195,7 +209,10 @@ int UDPClientSocks::makeClientSocket(int family)
   }
 
   try {
-    setReceiveSocketErrors(ret, family);
+    // ICMP errors received on an unconnected socket cannot be tied to a query, and would only wake us up
+    if (receiveErrors) {
+      setReceiveSocketErrors(ret, family);
+    }
     setNonBlocking(ret);
   }
   catch (...) {
@@ -260,9 +277,109 @@ PacketBuffer GenUDPQueryResponse(const ComboAddress& dest, const string& query)
 }
 
 static void handleUDPServerResponse(int fileDesc, FDMultiplexer::funcparam_t& var);
+static int sendResponseEvent(const std::shared_ptr<PacketID>& pident, const PacketBuffer& packet);
 
 thread_local std::unique_ptr<UDPClientSocks> t_udpclientsocks;
 
+unsigned int UDPClientSocks::s_batchSockets{0};
+
+// A pooled socket stops being handed out after that many queries and is closed once they are all
+// done, so that the source ports in use keep changing
+static constexpr uint32_t s_maxQueriesPerPooledSocket = 1000;
+// Queued queries are sent as soon as there are that many of them, even before the end of the loop iteration
+static constexpr size_t s_maxQueuedQueries = 64;
+
+LWResult::Result UDPClientSocks::getPooledSocket(const ComboAddress& toaddr, int* fileDesc)
+{
+  auto& active = d_active.at(toaddr.isIPv4() ? 0 : 1);
+  if (active.size() < s_batchSockets) {
+    int newDesc = makeClientSocket(toaddr.sin4.sin_family, false);
+    if (newDesc < 0) { // temporary error, we can still use the sockets we already have
+      if (active.empty()) {
+        return LWResult::Result::OSLimitError;
+      }
+    }
+    else {
+      // responses on a pooled socket are matched against all waiters, so this PacketID is only used for the fd
+      auto pident = std::make_shared<PacketID>();
+      pident->fd = newDesc;
+      t_fdm->addReadFD(newDesc, handleUDPServerResponse, pident);
+      d_pooled.emplace(newDesc, PooledSocket{});
+      active.push_back(newDesc);
+      d_numsocks++;
+    }
+  }
+
+  auto pos = active.size() == 1 ? 0 : dns_random(active.size());
+  *fileDesc = active.at(pos);
+  auto& pooled = d_pooled.at(*fileDesc);
+  ++pooled.d_outstanding;
+  if (++pooled.d_uses >= s_maxQueriesPerPooledSocket) {
+    pooled.d_retired = true;
+    active.erase(active.begin() + pos);
+  }
+  return LWResult::Result::Success;
+}
+
+void UDPClientSocks::queueQuery(int fileDesc, const ComboAddress& toaddr, const void* data, size_t len)
+{
+  const auto* start = static_cast<const uint8_t*>(data);
+  d_queued.push_back({toaddr, PacketBuffer(start, start + len), fileDesc});
+  if (d_queued.size() >= s_maxQueuedQueries) {
+    flushQueries();
+  }
+}
+
+void UDPClientSocks::flushQueries()
+{
+  if (d_queued.empty()) {
+    return;
+  }
+
+  // group the queries by socket, keeping the order in which they were queued
+  std::stable_sort(d_queued.begin(), d_queued.end(), [](const QueuedQuery& lhs, const QueuedQuery& rhs) { return lhs.d_fd < rhs.d_fd; });
+  for (auto begin = d_queued.begin(); begin != d_queued.end();) {
+    auto end = std::find_if(begin, d_queued.end(), [fileDesc = begin->d_fd](const QueuedQuery& query) { return query.d_fd != fileDesc; });
+    sendQueued(begin, end);
+    begin = end;
+  }
+  t_Counters.at(rec::Counter::udpBatchedQueries) += d_queued.size();
+  d_queued.clear();
+}
+
+// A query that could not be sent is simply dropped, the waiting mthread will see it as a timeout
+void UDPClientSocks::sendQueued(std::vector<QueuedQuery>::iterator begin, std::vector<QueuedQuery>::iterator end)
+{
+  const int fileDesc = begin->d_fd;
+#if defined(HAVE_SENDMMSG)
+  const auto count = static_cast<size_t>(std::distance(begin, end));
+  std::vector<struct mmsghdr> msgVec(count);
+  std::vector<struct iovec> iovVec(count);
+  size_t idx = 0;
+  for (auto iter = begin; iter != end; ++iter, ++idx) {
+    fillMSGHdr(&msgVec.at(idx).msg_hdr, &iovVec.at(idx), nullptr, 0, reinterpret_cast<char*>(iter->d_packet.data()), iter->d_packet.size(), &iter->d_dest); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    msgVec.at(idx).msg_len = 0;
+  }
+
+  size_t done = 0;
+  while (done < count) {
+    int sent = sendmmsg(fileDesc, &msgVec.at(done), count - done, 0);
+    t_Counters.at(rec::Counter::udpBatchSyscalls)++;
+    if (sent <= 0) {
+      // only the first remaining message failed, skip it and carry on with the next ones
+      ++done;
+      continue;
+    }
+    done += sent;
+  }
+#else
+  for (auto iter = begin; iter != end; ++iter) {
+    sendto(fileDesc, iter->d_packet.data(), iter->d_packet.size(), 0, reinterpret_cast<const struct sockaddr*>(&iter->d_dest), iter->d_dest.getSocklen()); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    t_Counters.at(rec::Counter::udpBatchSyscalls)++;
+  }
+#endif
+}
+
 // If we have plenty of mthreads slot left, use default timeout.
 // Otherwise reduce the timeout to be between g_networkTimeoutMsec/10 and g_networkTimeoutMsec
 unsigned int authWaitTimeMSec(const std::unique_ptr<MT_t>& mtasker)
@@ -277,6 +394,195 @@ unsigned int authWaitTimeMSec(const std::unique_ptr<MT_t>& mtasker)
   return std::max(g_networkTimeoutMsec / 10, g_networkTimeoutMsec * avail / (max - cutoff));
 }
 
+namespace
+{
+// A lossy, process-wide record of the UDP queries recently sent to authoritative servers, used to estimate how often
+// several worker threads send the same query to the same server at the same time, something chaining cannot prevent.
+// Each slot holds a hash of the query, the id of the thread that sent it and a timestamp with a 100ms resolution.
+class RecentOutQueries
+{
+public:
+  // Returns true if the same query was sent to the same server by another thread during the last network-timeout
+  bool record(const DNSName& domain, uint16_t qtype, const ComboAddress& toAddress, const struct timeval& now)
+  {
+    const uint32_t hash = ComboAddress::addressPortOnlyHash()(toAddress) ^ static_cast<uint32_t>(domain.hash(qtype));
+    const uint64_t threadId = RecThreadInfo::thread_local_id() & 0xffff;
+    const uint64_t tenths = (static_cast<uint64_t>(now.tv_sec) * 10 + now.tv_usec / 100000) & 0xffff;
+    const uint64_t value = (static_cast<uint64_t>(hash) << 32) | (threadId << 16) | tenths;
+
+    const uint64_t old = d_slots.at(hash % d_slots.size()).exchange(value, std::memory_order_relaxed);
+    if ((old >> 32) != hash || ((old >> 16) & 0xffff) == threadId) {
+      return false;
+    }
+    const uint64_t age = (tenths - (old & 0xffff)) & 0xffff;
+    return age * 100 <= g_networkTimeoutMsec;
+  }
+
+private:
+  std::array<std::atomic<uint64_t>, 65536> d_slots{};
+};
+
+RecentOutQueries s_recentOutQueries;
+
+// The UDP queries in flight to authoritative servers, shared by all threads. A thread about to send a query that
+// another thread already sent (the leader) can instead wait for the leader's answer as a follower. The leader hands the
+// answer, or an empty packet on error, to each follower through the query pipe of the follower's thread.
+class InFlightOutQueries
+{
+public:
+  // Returns true if we were added as a follower, setting fileDesc to the negative value to wait on.
+  // Otherwise the query is registered as sent by this thread, unless this thread already has it in flight.
+  bool join(const PacketID& pident, uint16_t qid, const struct timeval& now, uint64_t maxAgeUsec, size_t maxFollowers, int* fileDesc)
+  {
+    const auto thread = RecThreadInfo::thread_local_id();
+    auto shard = getShard(pident).lock();
+    auto [entry, inserted] = shard->try_emplace(Key(pident), Leader{thread, qid, now, {}});
+    if (inserted) {
+      prune(*shard, now, maxAgeUsec);
+      return false;
+    }
+    auto& leader = entry->second;
+    const bool stale = uSec(now - leader.d_created) > maxAgeUsec;
+    if (stale) {
+      // the leader gave up without telling us, its followers will time out on their own
+      leader = Leader{thread, qid, now, {}};
+      return false;
+    }
+    if (leader.d_thread == thread || leader.d_followers.size() >= maxFollowers) {
+      return false;
+    }
+    // stay clear of the descriptors used by chaining, which count down from -1
+    static thread_local uint16_t t_followerSeq{0};
+    *fileDesc = -0x10000 - static_cast<int>(++t_followerSeq);
+    leader.d_followers.push_back({thread, *fileDesc, qid});
+    return true;
+  }
+
+  // Called by the leader when it will not be answering, its followers will time out
+  void abandon(const PacketID& pident, uint16_t qid)
+  {
+    auto shard = getShard(pident).lock();
+    auto entry = shard->find(Key(pident));
+    if (entry != shard->end() && entry->second.d_thread == RecThreadInfo::thread_local_id() && entry->second.d_id == qid) {
+      shard->erase(entry);
+    }
+  }
+
+  // Called by the leader once the answer to its query (described by the waiter's pident) is in
+  void complete(const PacketID& pident, const PacketBuffer& content)
+  {
+    std::vector<Follower> followers;
+    {
+      auto shard = getShard(pident).lock();
+      auto entry = shard->find(Key(pident));
+      if (entry == shard->end() || entry->second.d_thread != RecThreadInfo::thread_local_id() || entry->second.d_id != pident.id) {
+        return;
+      }
+      followers = std::move(entry->second.d_followers);
+      shard->erase(entry);
+    }
+    if (followers.empty()) {
+      return;
+    }
+    auto packet = std::make_shared<const PacketBuffer>(content);
+    for (const auto& follower : followers) {
+      if (!wakeUp(follower, pident, packet)) {
+        t_Counters.at(rec::Counter::crossThreadChainLost)++;
+      }
+    }
+  }
+
+private:
+  struct Key
+  {
+    explicit Key(const PacketID& pident) :
+      d_remote(pident.remote), d_domain(pident.domain), d_ecsSubnet(pident.ecsSubnet), d_type(pident.type)
+    {
+    }
+    bool operator<(const Key& rhs) const
+    {
+      return std::tie(d_remote, d_type, d_domain, d_ecsSubnet) < std::tie(rhs.d_remote, rhs.d_type, rhs.d_domain, rhs.d_ecsSubnet);
+    }
+    ComboAddress d_remote;
+    DNSName d_domain;
+    std::optional<Netmask> d_ecsSubnet;
+    uint16_t d_type;
+  };
+  struct Follower
+  {
+    unsigned int d_thread;
+    int d_fd;
+    uint16_t d_id;
+  };
+  struct Leader
+  {
+    unsigned int d_thread;
+    uint16_t d_id;
+    struct timeval d_created;
+    std::vector<Follower> d_followers;
+  };
+  using Shard = LockGuarded<std::map<Key, Leader>>;
+
+  Shard& getShard(const PacketID& pident)
+  {
+    const auto hash = ComboAddress::addressPortOnlyHash()(pident.remote) ^ static_cast<uint32_t>(pident.domain.hash(pident.type));
+    return d_shards.at(hash % d_shards.size());
+  }
+
+  // Entries are normally removed by their leader, but that might not happen, for example when a hedged query is answered
+  static void prune(std::map<Key, Leader>& shard, const struct timeval& now, uint64_t maxAgeUsec)
+  {
+    static const size_t pruneAbove = 1024;
+    if (shard.size() <= pruneAbove) {
+      return;
+    }
+    for (auto entry = shard.begin(); entry != shard.end();) {
+      if (uSec(now - entry->second.d_created) > maxAgeUsec) {
+        entry = shard.erase(entry);
+      }
+      else {
+        ++entry;
+      }
+    }
+  }
+
+  // Runs on the thread of the follower, which waits on a PacketID matching this one
+  static void* pleaseDeliverResponse(const PacketID& leader, int fileDesc, uint16_t qid, const std::shared_ptr<const PacketBuffer>& packet)
+  {
+    auto pident = std::make_shared<PacketID>();
+    pident->remote = leader.remote;
+    pident->domain = leader.domain;
+    pident->type = leader.type;
+    pident->fd = fileDesc;
+    pident->id = qid;
+    sendResponseEvent(pident, *packet);
+    return nullptr;
+  }
+
+  static bool wakeUp(const Follower& follower, const PacketID& pident, const std::shared_ptr<const PacketBuffer>& packet)
+  {
+    PacketID leader;
+    leader.remote = pident.remote;
+    leader.domain = pident.domain;
+    leader.type = pident.type;
+    ThreadMSG* tmsg = new ThreadMSG(); // NOLINT: pointer ownership
+    tmsg->func = [leader, fileDesc = follower.d_fd, qid = follower.d_id, packet] { return pleaseDeliverResponse(leader, fileDesc, qid, packet); };
+    tmsg->wantAnswer = false;
+    // the pipe is non-blocking, if it is full the follower will time out
+    if (write(RecThreadInfo::info(follower.d_thread).getPipes().writeQueriesToThread, &tmsg, sizeof(tmsg)) != sizeof(tmsg)) { // NOLINT: correct sizeof
+      delete tmsg; // NOLINT: pointer ownership
+      return false;
+    }
+    // coverity[leaked_storage]
+    return true;
+  }
+
+  std::array<Shard, 64> d_shards;
+};
+
+InFlightOutQueries s_inFlightOutQueries;
+}
+
 /* these two functions are used by LWRes */
 LWResult::Result asendto(const void* data, size_t len, int /* flags */,
                          const ComboAddress& toAddress, uint16_t qid, const DNSName& domain, uint16_t qtype, const std::optional<EDNSSubnetOpts>& ecs, int* fileDesc, timeval& now)
@@ -311,6 +617,7 @@ LWResult::Result asendto(const void* data, size_t len, int /* flags */,
         return LWResult::Result::ChainLimitError;
       }
       chain.first->key->authReqChain.emplace(*fileDesc, qid); // we can chain
+      t_Counters.at(rec::Counter::chainedOutQueries)++;
       auto maxLength = t_Counters.at(rec::Counter::maxChainLength);
       if (currentChainSize + 1 > maxLength) {
         t_Counters.at(rec::Counter::maxChainLength) = currentChainSize + 1;
@@ -319,8 +626,38 @@ LWResult::Result asendto(const void* data, size_t len, int /* flags */,
     }
   }
 
+  const bool crossThreadChaining = g_maxCrossThreadChainLength > 0 && RecThreadInfo::thread_local_id() != 0;
+  if (crossThreadChaining) {
+    const uint64_t maxAge = static_cast<uint64_t>(1000) * authWaitTimeMSec(g_multiTasker) * 2 / 3;
+    if (s_inFlightOutQueries.join(*pident, qid, now, maxAge, g_maxCrossThreadChainLength, fileDesc)) {
+      t_Counters.at(rec::Counter::crossThreadChainedOutQueries)++;
+      return LWResult::Result::Success;
+    }
+  }
+
+  if (!ecs && s_recentOutQueries.record(domain, qtype, toAddress, now)) {
+    t_Counters.at(rec::Counter::crossThreadDuplicateOutQueries)++;
+  }
+
+  if (UDPClientSocks::s_batchSockets > 0) {
+    auto ret = t_udpclientsocks->getPooledSocket(toAddress, fileDesc);
+    if (ret != LWResult::Result::Success) {
+      if (crossThreadChaining) {
+        s_inFlightOutQueries.abandon(*pident, qid);
+      }
+      return ret;
+    }
+    // the read callback was registered when the socket was added to the pool, responses are matched
+    // on the exact source address and port, id, qname and qtype by handleUDPServerResponse()
+    t_udpclientsocks->queueQuery(*fileDesc, toAddress, data, len);
+    return LWResult::Result::Success;
+  }
+
   auto ret = t_udpclientsocks->getSocket(toAddress, fileDesc);
   if (ret != LWResult::Result::Success) {
+    if (crossThreadChaining) {
+      s_inFlightOutQueries.abandon(*pident, qid);
+    }
     return ret;
   }
 
@@ -334,6 +671,9 @@ LWResult::Result asendto(const void* data, size_t len, int /* flags */,
 
   if (sent < 0) {
     t_udpclientsocks->returnSocket(*fileDesc);
+    if (crossThreadChaining) {
+      s_inFlightOutQueries.abandon(*pident, qid);
+    }
     errno = tmp; // this is for logging purposes only
     return LWResult::Result::PermanentError;
   }
@@ -343,8 +683,119 @@ LWResult::Result asendto(const void* data, size_t len, int /* flags */,
 
 static bool checkIncomingECSSource(const PacketBuffer& packet, const Netmask& subnet);
 
-LWResult::Result arecvfrom(PacketBuffer& packet, int /* flags */, const ComboAddress& fromAddr, size_t& len,
-                           uint16_t qid, const DNSName& domain, uint16_t qtype, int fileDesc, const std::optional<EDNSSubnetOpts>& ecs, const struct timeval& now)
+// Hedged queries in flight: a response matching a key is handed to the mthread waiting on its value, see waitHedged()
+static thread_local std::map<std::shared_ptr<PacketID>, std::shared_ptr<PacketID>, PacketIDCompare> t_hedgedQueries;
+
+// Wakes up the mthread waiting for this response, which can be the one that sent a hedged copy of the query
+static int sendResponseEvent(const std::shared_ptr<PacketID>& pident, const PacketBuffer& packet)
+{
+  int ret = g_multiTasker->sendEvent(pident, &packet);
+  if (ret != 0 || t_hedgedQueries.empty()) {
+    return ret;
+  }
+  auto hedged = t_hedgedQueries.find(pident);
+  if (hedged == t_hedgedQueries.end()) {
+    return ret;
+  }
+  auto waiter = hedged->second;
+  t_hedgedQueries.erase(hedged);
+  return g_multiTasker->sendEvent(waiter, &packet);
+}
+
+struct HedgedQuery
+{
+  const std::vector<uint8_t>& d_query;
+  const ComboAddress& d_address;
+  const std::optional<EDNSSubnetOpts>& d_ecs;
+  unsigned int d_afterMsec;
+  LWResult& d_lwr;
+};
+
+// An answer from the hedge server only replaces the one we are waiting for if it is likely to be useful
+static bool isUsableHedgeAnswer(const PacketBuffer& packet)
+{
+  if (packet.size() < sizeof(dnsheader)) {
+    return false;
+  }
+  dnsheader header{};
+  memcpy(&header, packet.data(), sizeof(header));
+  return header.qr != 0 && header.tc == 0 && (header.rcode == RCode::NoError || header.rcode == RCode::NXDomain);
+}
+
+// Waits like waitEvent() for an answer to the query of pident, also sending it to the hedge server if it is not answered
+// within hedge.d_afterMsec. The first usable answer wins, the socket of the other query is closed.
+static int waitHedged(std::shared_ptr<PacketID>& pident, PacketBuffer& packet, unsigned int timeoutMsec, const struct timeval& now, const HedgedQuery& hedge)
+{
+  if (hedge.d_afterMsec >= timeoutMsec) {
+    return g_multiTasker->waitEvent(pident, &packet, timeoutMsec, &now);
+  }
+  int ret = g_multiTasker->waitEvent(pident, &packet, hedge.d_afterMsec, &now);
+  if (ret != 0) {
+    return ret;
+  }
+
+  struct timeval sent{};
+  Utility::gettimeofday(&sent);
+  const auto deadline = now + timeval{timeoutMsec / 1000, static_cast<suseconds_t>((timeoutMsec % 1000) * 1000)};
+  auto remainingMsec = [&deadline]() {
+    struct timeval current{};
+    Utility::gettimeofday(&current);
+    auto msec = makeFloat(deadline - current) * 1000;
+    return msec >= 1.0F ? static_cast<unsigned int>(msec) : 0U;
+  };
+
+  int hedgeDesc{-1};
+  if (asendto(hedge.d_query.data(), hedge.d_query.size(), 0, hedge.d_address, pident->id, pident->domain, pident->type, hedge.d_ecs, &hedgeDesc, sent) != LWResult::Result::Success) {
+    auto msec = remainingMsec();
+    return msec > 0 ? g_multiTasker->waitEvent(pident, &packet, msec) : 0;
+  }
+  hedge.d_lwr.d_hedged = true;
+  t_Counters.at(rec::Counter::hedgedQueries)++;
+
+  // a negative descriptor means we were chained onto a query already in flight to that server, this also works
+  auto hedgeID = std::make_shared<PacketID>();
+  hedgeID->remote = hedge.d_address;
+  hedgeID->domain = pident->domain;
+  hedgeID->type = pident->type;
+  hedgeID->id = pident->id;
+  hedgeID->fd = hedgeDesc;
+  bool hedgePending = t_hedgedQueries.emplace(hedgeID, pident).second;
+
+  for (;;) {
+    auto msec = remainingMsec();
+    if (msec == 0) {
+      ret = 0;
+      break;
+    }
+    ret = g_multiTasker->waitEvent(pident, &packet, msec);
+    if (ret <= 0 || !hedgePending || t_hedgedQueries.count(hedgeID) != 0) {
+      // timeout, error or an answer from the first server
+      break;
+    }
+    // the answer came from the hedge server, whose socket has been taken care of by handleUDPServerResponse()
+    hedgePending = false;
+    if (isUsableHedgeAnswer(packet)) {
+      hedge.d_lwr.d_hedgeWon = true;
+      t_Counters.at(rec::Counter::hedgedQueriesWon)++;
+      if (pident->fd >= 0) {
+        t_udpclientsocks->returnSocket(pident->fd);
+      }
+      return ret;
+    }
+    // otherwise keep waiting for the first server
+  }
+
+  if (hedgePending) {
+    t_hedgedQueries.erase(hedgeID);
+    if (hedgeDesc >= 0) {
+      t_udpclientsocks->returnSocket(hedgeDesc);
+    }
+  }
+  return ret;
+}
+
+static LWResult::Result waitForUDPResponse(PacketBuffer& packet, const ComboAddress& fromAddr, size_t& len,
+                                           uint16_t qid, const DNSName& domain, uint16_t qtype, int fileDesc, const std::optional<EDNSSubnetOpts>& ecs, const struct timeval& now, unsigned int timeoutMsec, const HedgedQuery* hedge)
 {
   static const unsigned int nearMissLimit = ::arg().asNum("spoof-nearmiss-max");
 
@@ -362,7 +813,18 @@ LWResult::Result arecvfrom(PacketBuffer& packet, int /* flags */, const ComboAdd
     // We fill in the search key with the ecs we sent out, so both cases are covered and accepted here.
     pident->ecsSubnet = ecs->getSource();
   }
-  int ret = g_multiTasker->waitEvent(pident, &packet, authWaitTimeMSec(g_multiTasker), &now);
+  auto waitMsec = authWaitTimeMSec(g_multiTasker);
+  if (timeoutMsec > 0) {
+    waitMsec = std::min(waitMsec, timeoutMsec);
+    t_Counters.at(rec::Histogram::cumulativeAdaptiveTimeouts)(static_cast<uint64_t>(waitMsec) * 1000);
+  }
+  int ret{};
+  if (hedge != nullptr) {
+    ret = waitHedged(pident, packet, waitMsec, now, *hedge);
+  }
+  else {
+    ret = g_multiTasker->waitEvent(pident, &packet, waitMsec, &now);
+  }
   len = 0;
 
   /* -1 means error, 0 means timeout, 1 means a result from handleUDPServerResponse() which might still be an error */
@@ -398,11 +860,28 @@ LWResult::Result arecvfrom(PacketBuffer& packet, int /* flags */, const ComboAdd
   /* getting there means error or timeout, it's up to us to close the socket */
   if (fileDesc >= 0) {
     t_udpclientsocks->returnSocket(fileDesc);
+    if (g_maxCrossThreadChainLength > 0) {
+      s_inFlightOutQueries.abandon(*pident, qid);
+    }
   }
 
   return ret == 0 ? LWResult::Result::Timeout : LWResult::Result::PermanentError;
 }
 
+LWResult::Result arecvfrom(PacketBuffer& packet, int /* flags */, const ComboAddress& fromAddr, size_t& len,
+                           uint16_t qid, const DNSName& domain, uint16_t qtype, int fileDesc, const std::optional<EDNSSubnetOpts>& ecs, const struct timeval& now, unsigned int timeoutMsec)
+{
+  return waitForUDPResponse(packet, fromAddr, len, qid, domain, qtype, fileDesc, ecs, now, timeoutMsec, nullptr);
+}
+
+LWResult::Result arecvfromHedged(PacketBuffer& packet, const ComboAddress& fromAddr, size_t& len, uint16_t qid, const DNSName& domain, uint16_t qtype,
+                                 int fileDesc, const std::optional<EDNSSubnetOpts>& ecs, const struct timeval& now, unsigned int timeoutMsec,
+                                 const std::vector<uint8_t>& query, const ComboAddress& hedgeAddress, unsigned int afterMsec, LWResult& lwr)
+{
+  const HedgedQuery hedge{query, hedgeAddress, ecs, afterMsec, lwr};
+  return waitForUDPResponse(packet, fromAddr, len, qid, domain, qtype, fileDesc, ecs, now, timeoutMsec, &hedge);
+}
+
 // the idea is, only do things that depend on the *response* here. Incoming accounting is on incoming.
 static void updateResponseStats(int res, const ComboAddress& remote, unsigned int packetsize, const DNSName* query, uint16_t qtype)
 {
@@ -2187,7 +2666,7 @@ bool expectProxyProtocol(const ComboAddress& from, const ComboAddress& listenAdd
 // source: the address we assume the query is coming from, might be set by proxy protocol
 // destination: the address we assume the query was sent to, might be set by proxy protocol
 // mappedSource: the address we assume the query is coming from. Differs from source if table based mapping has been applied
-static string* doProcessUDPQuestion(const std::string& question, const ComboAddress& fromaddr, const ComboAddress& destaddr, ComboAddress source, ComboAddress destination, const ComboAddress& mappedSource, struct timeval tval, int fileDesc, std::vector<ProxyProtocolValue>& proxyProtocolValues, RecEventTrace& eventTrace, pdns::trace::InitialSpanInfo& otTrace) // NOLINT(readability-function-cognitive-complexity): https://github.com/PowerDNS/pdns/issues/12791
+static string* doProcessUDPQuestion(const std::string& question, const ComboAddress& fromaddr, const ComboAddress& destaddr, ComboAddress source, ComboAddress destination, const ComboAddress& mappedSource, struct timeval tval, int fileDesc, std::vector<ProxyProtocolValue>& proxyProtocolValues, RecEventTrace& eventTrace, pdns::trace::InitialSpanInfo& otTrace, std::optional<uint32_t> missedQHash) // NOLINT(readability-function-cognitive-complexity): https://github.com/PowerDNS/pdns/issues/12791
 {
   RecThreadInfo::self().incNumberOfDistributedQueries();
   gettimeofday(&g_now, nullptr);
@@ -2330,7 +2809,14 @@ static string* doProcessUDPQuestion(const std::string& question, const ComboAddr
          but it means that the hash would not be computed. If some script decides at a later time to mark back the answer
          as cacheable we would cache it with a wrong tag, so better safe than sorry. */
       auto match = eventTrace.add(RecEventTrace::PCacheCheck);
-      bool cacheHit = checkForCacheHit(qnameParsed, ctag, question, qname, qtype, qclass, g_now, response, qhash, pbData, false, source, mappedSource);
+      bool cacheHit = false;
+      if (missedQHash) {
+        // The UDP fast path already looked this query up in the packet cache, without success
+        qhash = *missedQHash;
+      }
+      else {
+        cacheHit = checkForCacheHit(qnameParsed, ctag, question, qname, qtype, qclass, g_now, response, qhash, pbData, false, source, mappedSource);
+      }
       eventTrace.add(RecEventTrace::PCacheCheck, cacheHit, false, match);
       if (cacheHit) {
         if (!g_quiet) {
@@ -2471,221 +2957,404 @@ static string* doProcessUDPQuestion(const std::string& question, const ComboAddr
   return nullptr;
 }
 
-static void handleNewUDPQuestion(int fileDesc, FDMultiplexer::funcparam_t& /* var */) // NOLINT(readability-function-cognitive-complexity): https://github.com/PowerDNS/pdns/issues/12791
+// Handles a query of len bytes received in data from fromaddr on fileDesc. missedQHash is set when the UDP fast path already
+// looked the query up in the packet cache. Returns false if no more queries should be read from fileDesc in this round
+static bool handleUDPQuestion(int fileDesc, std::string& data, ssize_t len, const ComboAddress& fromaddr, struct msghdr& msgh, std::vector<ProxyProtocolValue>& proxyProtocolValues, RecEventTrace& eventTrace, pdns::trace::InitialSpanInfo& otTrace, std::optional<uint32_t> missedQHash) // NOLINT(readability-function-cognitive-complexity): https://github.com/PowerDNS/pdns/issues/12791
 {
-  const bool proxyActive = t_proxyProtocolACL && !t_proxyProtocolACL->empty();
-  static const size_t maxIncomingQuerySize = !proxyActive ? 512 : (512 + g_proxyProtocolMaximumSize);
-  static thread_local std::string data;
-  ComboAddress fromaddr; // the address the query is coming from
+  bool proxyProto = false;
   ComboAddress source; // the address we assume the query is coming from, might be set by proxy protocol
   ComboAddress destination; // the address we assume the query was sent to, might be set by proxy protocol
-  struct msghdr msgh{};
-  struct iovec iov{};
-  cmsgbuf_aligned cbuf;
-  bool firstQuery = true;
-  std::vector<ProxyProtocolValue> proxyProtocolValues;
-  RecEventTrace eventTrace;
-  pdns::trace::InitialSpanInfo otTrace;
 
-  for (size_t queriesCounter = 0; queriesCounter < g_maxUDPQueriesPerRound; queriesCounter++) {
-    bool proxyProto = false;
-    proxyProtocolValues.clear();
-    data.resize(maxIncomingQuerySize);
-    fromaddr.sin6.sin6_family = AF_INET6; // this makes sure fromaddr is big enough
-    fillMSGHdr(&msgh, &iov, &cbuf, sizeof(cbuf), data.data(), data.size(), &fromaddr);
+  eventTrace.clear();
+  eventTrace.setEnabled(SyncRes::s_event_trace_enabled != 0);
+  // eventTrace uses monotonic time, while OpenTelemetry uses absolute time. setEnabled()
+  // established the reference point, get an absolute TS as close as possible to the
+  // eventTrace start of trace time.
+  auto traceTS = pdns::trace::timestamp();
+  eventTrace.add(RecEventTrace::ReqRecv);
+  if (SyncRes::eventTraceEnabled(SyncRes::event_trace_to_ot)) {
+    otTrace.clear();
+    otTrace.start_time_unix_nano = traceTS;
+  }
 
-    if (ssize_t len = recvmsg(fileDesc, &msgh, 0); len >= 0) {
-      eventTrace.clear();
-      eventTrace.setEnabled(SyncRes::s_event_trace_enabled != 0);
-      // eventTrace uses monotonic time, while OpenTelemetry uses absolute time. setEnabled()
-      // established the reference point, get an absolute TS as close as possible to the
-      // eventTrace start of trace time.
-      auto traceTS = pdns::trace::timestamp();
-      eventTrace.add(RecEventTrace::ReqRecv);
-      if (SyncRes::eventTraceEnabled(SyncRes::event_trace_to_ot)) {
-        otTrace.clear();
-        otTrace.start_time_unix_nano = traceTS;
-      }
-      firstQuery = false;
+  if ((msgh.msg_flags & MSG_TRUNC) != 0) {
+    t_Counters.at(rec::Counter::truncatedDrops)++;
+    if (!g_quiet) {
+      SLOG(g_log << Logger::Error << "Ignoring truncated query from " << fromaddr.toString() << endl,
+           g_slogudpin->info(Logr::Error, "Ignoring truncated query", "remote", Logging::Loggable(fromaddr)));
+    }
+    return false;
+  }
 
-      if ((msgh.msg_flags & MSG_TRUNC) != 0) {
-        t_Counters.at(rec::Counter::truncatedDrops)++;
-        if (!g_quiet) {
-          SLOG(g_log << Logger::Error << "Ignoring truncated query from " << fromaddr.toString() << endl,
-               g_slogudpin->info(Logr::Error, "Ignoring truncated query", "remote", Logging::Loggable(fromaddr)));
-        }
-        return;
+  data.resize(static_cast<size_t>(len));
+
+  ComboAddress destaddr; // the address the query was sent to to
+  destaddr.reset(); // this makes sure we ignore this address if not explictly set below
+  const auto* loc = rplookup(g_listenSocketsAddresses, fileDesc);
+  if (HarvestDestinationAddress(&msgh, &destaddr)) {
+    // but.. need to get port too
+    if (loc != nullptr) {
+      destaddr.sin4.sin_port = loc->sin4.sin_port;
+    }
+  }
+  else {
+    if (loc != nullptr) {
+      destaddr = *loc;
+    }
+    else {
+      destaddr.sin4.sin_family = fromaddr.sin4.sin_family;
+      socklen_t slen = destaddr.getSocklen();
+      getsockname(fileDesc, reinterpret_cast<sockaddr*>(&destaddr), &slen); // if this fails, we're ok with it  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    }
+  }
+  if (expectProxyProtocol(fromaddr, destaddr)) {
+    bool tcp = false;
+    ssize_t used = parseProxyHeader(data, proxyProto, source, destination, tcp, proxyProtocolValues);
+    if (used <= 0) {
+      ++t_Counters.at(rec::Counter::proxyProtocolInvalidCount);
+      if (!g_quiet) {
+        SLOG(g_log << Logger::Error << "Ignoring invalid proxy protocol (" << std::to_string(len) << ", " << std::to_string(used) << ") query from " << fromaddr.toStringWithPort() << endl,
+             g_slogudpin->info(Logr::Error, "Ignoring invalid proxy protocol query", "length", Logging::Loggable(len),
+                               "used", Logging::Loggable(used), "remote", Logging::Loggable(fromaddr)));
       }
+      return false;
+    }
+    if (static_cast<size_t>(used) > g_proxyProtocolMaximumSize) {
+      if (g_quiet) {
+        SLOG(g_log << Logger::Error << "Proxy protocol header in UDP packet from " << fromaddr.toStringWithPort() << " is larger than proxy-protocol-maximum-size (" << used << "), dropping" << endl,
+             g_slogudpin->info(Logr::Error, "Proxy protocol header in UDP packet  is larger than proxy-protocol-maximum-size",
+                               "used", Logging::Loggable(used), "remote", Logging::Loggable(fromaddr)));
+      }
+      ++t_Counters.at(rec::Counter::proxyProtocolInvalidCount);
+      return false;
+    }
+
+    data.erase(0, used);
+  }
+  else if (len > 512) {
+    /* we only allow UDP packets larger than 512 for those with a proxy protocol header */
+    t_Counters.at(rec::Counter::truncatedDrops)++;
+    if (!g_quiet) {
+      SLOG(g_log << Logger::Error << "Ignoring truncated query from " << fromaddr.toStringWithPort() << endl,
+           g_slogudpin->info(Logr::Error, "Ignoring truncated query", "remote", Logging::Loggable(fromaddr)));
+    }
+    return false;
+  }
 
-      data.resize(static_cast<size_t>(len));
+  if (data.size() < sizeof(dnsheader)) {
+    t_Counters.at(rec::Counter::ignoredCount)++;
+    if (!g_quiet) {
+      SLOG(g_log << Logger::Error << "Ignoring too-short (" << std::to_string(data.size()) << ") query from " << fromaddr.toString() << endl,
+           g_slogudpin->info(Logr::Error, "Ignoring too-short query", "length", Logging::Loggable(data.size()),
+                             "remote", Logging::Loggable(fromaddr)));
+    }
+    return false;
+  }
 
-      ComboAddress destaddr; // the address the query was sent to to
-      destaddr.reset(); // this makes sure we ignore this address if not explictly set below
-      const auto* loc = rplookup(g_listenSocketsAddresses, fileDesc);
-      if (HarvestDestinationAddress(&msgh, &destaddr)) {
-        // but.. need to get port too
-        if (loc != nullptr) {
-          destaddr.sin4.sin_port = loc->sin4.sin_port;
-        }
+  if (!proxyProto) {
+    source = fromaddr;
+  }
+  ComboAddress mappedSource = source;
+  if (t_proxyMapping) {
+    if (const auto* iter = t_proxyMapping->lookup(source)) {
+      mappedSource = iter->second.address;
+      ++iter->second.stats.netmaskMatches;
+    }
+  }
+  if (t_remotes) {
+    t_remotes->push_back(source);
+  }
+
+  if (t_allowFrom && !t_allowFrom->match(&mappedSource)) {
+    if (!g_quiet) {
+      SLOG(g_log << Logger::Error << "[" << g_multiTasker->getTid() << "] dropping UDP query from " << mappedSource.toString() << ", address not matched by allow-from" << endl,
+           g_slogudpin->info(Logr::Error, "Dropping UDP query, address not matched by allow-from", "source", Logging::Loggable(mappedSource)));
+    }
+
+    t_Counters.at(rec::Counter::unauthorizedUDP)++;
+    return false;
+  }
+
+  BOOST_STATIC_ASSERT(offsetof(sockaddr_in, sin_port) == offsetof(sockaddr_in6, sin6_port));
+  if (fromaddr.sin4.sin_port == 0) { // also works for IPv6
+    if (!g_quiet) {
+      SLOG(g_log << Logger::Error << "[" << g_multiTasker->getTid() << "] dropping UDP query from " << fromaddr.toStringWithPort() << ", can't deal with port 0" << endl,
+           g_slogudpin->info(Logr::Error, "Dropping UDP query can't deal with port 0", "remote", Logging::Loggable(fromaddr)));
+    }
+
+    t_Counters.at(rec::Counter::clientParseError)++; // not quite the best place to put it, but needs to go somewhere
+    return false;
+  }
+
+  try {
+    const dnsheader_aligned headerdata(data.data());
+    const dnsheader* dnsheader = headerdata.get();
+
+    if (dnsheader->qr) {
+      t_Counters.at(rec::Counter::ignoredCount)++;
+      if (g_logCommonErrors) {
+        SLOG(g_log << Logger::Error << "Ignoring answer from " << fromaddr.toString() << " on server socket!" << endl,
+             g_slogudpin->info(Logr::Error, "Ignoring answer on server socket", "remote", Logging::Loggable(fromaddr)));
       }
-      else {
-        if (loc != nullptr) {
-          destaddr = *loc;
-        }
-        else {
-          destaddr.sin4.sin_family = fromaddr.sin4.sin_family;
-          socklen_t slen = destaddr.getSocklen();
-          getsockname(fileDesc, reinterpret_cast<sockaddr*>(&destaddr), &slen); // if this fails, we're ok with it  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
-        }
+    }
+    else if (dnsheader->opcode != static_cast<unsigned>(Opcode::Query) && dnsheader->opcode != static_cast<unsigned>(Opcode::Notify)) {
+      t_Counters.at(rec::Counter::ignoredCount)++;
+      if (g_logCommonErrors) {
+        SLOG(g_log << Logger::Error << "Ignoring unsupported opcode " << Opcode::to_s(dnsheader->opcode) << " from " << fromaddr.toString() << " on server socket!" << endl,
+             g_slogudpin->info(Logr::Error, "Ignoring unsupported opcode server socket", "remote", Logging::Loggable(fromaddr), "opcode", Logging::Loggable(Opcode::to_s(dnsheader->opcode))));
+      }
+    }
+    else if (dnsheader->qdcount == 0U) {
+      t_Counters.at(rec::Counter::emptyQueriesCount)++;
+      if (g_logCommonErrors) {
+        SLOG(g_log << Logger::Error << "Ignoring empty (qdcount == 0) query from " << fromaddr.toString() << " on server socket!" << endl,
+             g_slogudpin->info(Logr::Error, "Ignoring empty (qdcount == 0) query on server socket!", "remote", Logging::Loggable(fromaddr)));
       }
-      if (expectProxyProtocol(fromaddr, destaddr)) {
-        bool tcp = false;
-        ssize_t used = parseProxyHeader(data, proxyProto, source, destination, tcp, proxyProtocolValues);
-        if (used <= 0) {
-          ++t_Counters.at(rec::Counter::proxyProtocolInvalidCount);
+    }
+    else {
+      if (dnsheader->opcode == static_cast<unsigned>(Opcode::Notify)) {
+        if (!t_allowNotifyFrom || !t_allowNotifyFrom->match(&mappedSource)) {
           if (!g_quiet) {
-            SLOG(g_log << Logger::Error << "Ignoring invalid proxy protocol (" << std::to_string(len) << ", " << std::to_string(used) << ") query from " << fromaddr.toStringWithPort() << endl,
-                 g_slogudpin->info(Logr::Error, "Ignoring invalid proxy protocol query", "length", Logging::Loggable(len),
-                                   "used", Logging::Loggable(used), "remote", Logging::Loggable(fromaddr)));
+            SLOG(g_log << Logger::Error << "[" << g_multiTasker->getTid() << "] dropping UDP NOTIFY from " << mappedSource.toString() << ", address not matched by allow-notify-from" << endl,
+                 g_slogudpin->info(Logr::Error, "Dropping UDP NOTIFY from address not matched by allow-notify-from",
+                                   "source", Logging::Loggable(mappedSource)));
           }
-          return;
-        }
-        if (static_cast<size_t>(used) > g_proxyProtocolMaximumSize) {
-          if (g_quiet) {
-            SLOG(g_log << Logger::Error << "Proxy protocol header in UDP packet from " << fromaddr.toStringWithPort() << " is larger than proxy-protocol-maximum-size (" << used << "), dropping" << endl,
-                 g_slogudpin->info(Logr::Error, "Proxy protocol header in UDP packet  is larger than proxy-protocol-maximum-size",
-                                   "used", Logging::Loggable(used), "remote", Logging::Loggable(fromaddr)));
-          }
-          ++t_Counters.at(rec::Counter::proxyProtocolInvalidCount);
-          return;
-        }
-
-        data.erase(0, used);
-      }
-      else if (len > 512) {
-        /* we only allow UDP packets larger than 512 for those with a proxy protocol header */
-        t_Counters.at(rec::Counter::truncatedDrops)++;
-        if (!g_quiet) {
-          SLOG(g_log << Logger::Error << "Ignoring truncated query from " << fromaddr.toStringWithPort() << endl,
-               g_slogudpin->info(Logr::Error, "Ignoring truncated query", "remote", Logging::Loggable(fromaddr)));
-        }
-        return;
-      }
 
-      if (data.size() < sizeof(dnsheader)) {
-        t_Counters.at(rec::Counter::ignoredCount)++;
-        if (!g_quiet) {
-          SLOG(g_log << Logger::Error << "Ignoring too-short (" << std::to_string(data.size()) << ") query from " << fromaddr.toString() << endl,
-               g_slogudpin->info(Logr::Error, "Ignoring too-short query", "length", Logging::Loggable(data.size()),
-                                 "remote", Logging::Loggable(fromaddr)));
+          t_Counters.at(rec::Counter::sourceDisallowedNotify)++;
+          return false;
         }
-        return;
       }
 
+      struct timeval tval = {0, 0};
+      HarvestTimestamp(&msgh, &tval);
       if (!proxyProto) {
-        source = fromaddr;
+        destination = destaddr;
       }
-      ComboAddress mappedSource = source;
-      if (t_proxyMapping) {
-        if (const auto* iter = t_proxyMapping->lookup(source)) {
-          mappedSource = iter->second.address;
-          ++iter->second.stats.netmaskMatches;
-        }
+
+      if (RecThreadInfo::weDistributeQueries()) {
+        std::string localdata = data;
+        distributeAsyncFunction(data, [localdata = std::move(localdata), fromaddr, destaddr, source, destination, mappedSource, tval, fileDesc, proxyProtocolValues, eventTrace, otTrace]() mutable {
+          return doProcessUDPQuestion(localdata, fromaddr, destaddr, source, destination, mappedSource, tval, fileDesc, proxyProtocolValues, eventTrace, otTrace, std::nullopt);
+        });
       }
-      if (t_remotes) {
-        t_remotes->push_back(source);
+      else {
+        doProcessUDPQuestion(data, fromaddr, destaddr, source, destination, mappedSource, tval, fileDesc, proxyProtocolValues, eventTrace, otTrace, missedQHash);
       }
+    }
+  }
+  catch (const MOADNSException& mde) {
+    t_Counters.at(rec::Counter::clientParseError)++;
+    if (g_logCommonErrors) {
+      SLOG(g_log << Logger::Error << "Unable to parse packet from remote UDP client " << fromaddr.toString() << ": " << mde.what() << endl,
+           g_slogudpin->error(Logr::Error, mde.what(), "Unable to parse packet from remote UDP client", "remote", Logging::Loggable(fromaddr), "exception", Logging::Loggable("MOADNSException")));
+    }
+  }
+  catch (const std::runtime_error& e) {
+    t_Counters.at(rec::Counter::clientParseError)++;
+    if (g_logCommonErrors) {
+      SLOG(g_log << Logger::Error << "Unable to parse packet from remote UDP client " << fromaddr.toString() << ": " << e.what() << endl,
+           g_slogudpin->error(Logr::Error, e.what(), "Unable to parse packet from remote UDP client", "remote", Logging::Loggable(fromaddr), "exception", Logging::Loggable("std::runtime_error")));
+    }
+  }
+  return true;
+}
 
-      if (t_allowFrom && !t_allowFrom->match(&mappedSource)) {
-        if (!g_quiet) {
-          SLOG(g_log << Logger::Error << "[" << g_multiTasker->getTid() << "] dropping UDP query from " << mappedSource.toString() << ", address not matched by allow-from" << endl,
-               g_slogudpin->info(Logr::Error, "Dropping UDP query, address not matched by allow-from", "source", Logging::Loggable(mappedSource)));
-        }
+#if defined(HAVE_RECVMMSG) && defined(HAVE_SENDMMSG) && defined(MSG_WAITFORONE)
+// The UDP fast path reads queries in batches, and answers the packet cache hits among them straight away, also in batches.
+// It is only used when no feature needing per-query work before the packet cache lookup is active.
+static bool udpFastPathUsable(bool proxyActive)
+{
+  if (g_udpFastPathBatchSize == 0 || proxyActive || !g_quiet || t_pdl || t_proxyMapping || SyncRes::s_event_trace_enabled != 0 || !g_paddingFrom.empty() || RecThreadInfo::weDistributeQueries()) {
+    return false;
+  }
+  auto luaconfsLocal = g_luaconfs.getLocal();
+  return !luaconfsLocal->protobufExportConfig.enabled && !luaconfsLocal->outgoingProtobufExportConfig.enabled;
+}
 
-        t_Counters.at(rec::Counter::unauthorizedUDP)++;
-        return;
-      }
+// Buffers used by the UDP fast path, kept around so that handling a batch does not allocate once they have grown
+struct UDPFastPathBatch
+{
+  explicit UDPFastPathBatch(size_t size) :
+    d_queries(size), d_from(size), d_msgs(size), d_iovs(size), d_cbufs(size), d_responses(size), d_replyMsgs(size), d_replyIovs(size), d_replyCbufs(size)
+  {
+  }
 
-      BOOST_STATIC_ASSERT(offsetof(sockaddr_in, sin_port) == offsetof(sockaddr_in6, sin6_port));
-      if (fromaddr.sin4.sin_port == 0) { // also works for IPv6
-        if (!g_quiet) {
-          SLOG(g_log << Logger::Error << "[" << g_multiTasker->getTid() << "] dropping UDP query from " << fromaddr.toStringWithPort() << ", can't deal with port 0" << endl,
-               g_slogudpin->info(Logr::Error, "Dropping UDP query can't deal with port 0", "remote", Logging::Loggable(fromaddr)));
-        }
+  std::vector<std::string> d_queries;
+  std::vector<ComboAddress> d_from;
+  std::vector<struct mmsghdr> d_msgs;
+  std::vector<struct iovec> d_iovs;
+  std::vector<cmsgbuf_aligned> d_cbufs;
+  std::vector<std::string> d_responses;
+  std::vector<struct mmsghdr> d_replyMsgs;
+  std::vector<struct iovec> d_replyIovs;
+  std::vector<cmsgbuf_aligned> d_replyCbufs;
+  size_t d_replies{0};
+};
 
-        t_Counters.at(rec::Counter::clientParseError)++; // not quite the best place to put it, but needs to go somewhere
-        return;
-      }
+// Tries to answer the query at index idx of the batch from the packet cache, queueing the response if so. Otherwise the query
+// has to be handled by handleUDPQuestion(), and missedQHash is set if the packet cache has already been consulted
+static bool answerFromPacketCacheFastPath(int fileDesc, UDPFastPathBatch& batch, size_t idx, std::optional<uint32_t>& missedQHash)
+{
+  auto& msgh = batch.d_msgs.at(idx).msg_hdr;
+  const auto& question = batch.d_queries.at(idx);
+  auto& fromaddr = batch.d_from.at(idx);
 
-      try {
-        const dnsheader_aligned headerdata(data.data());
-        const dnsheader* dnsheader = headerdata.get();
+  // Anything out of the ordinary is left to the regular path, which knows how to deal with it and account for it
+  if ((msgh.msg_flags & MSG_TRUNC) != 0 || question.size() < sizeof(dnsheader) || fromaddr.sin4.sin_port == 0 || (t_allowFrom && !t_allowFrom->match(&fromaddr))) {
+    return false;
+  }
+  const dnsheader_aligned headerdata(question.data());
+  const dnsheader* dnsheader = headerdata.get();
+  if (dnsheader->qr || dnsheader->opcode != static_cast<unsigned>(Opcode::Query) || dnsheader->qdcount == 0U) {
+    return false;
+  }
+  struct timeval tval = {0, 0};
+  HarvestTimestamp(&msgh, &tval);
+  if (tval.tv_sec != 0 && makeFloat(g_now - tval) > 1.0) {
+    return false;
+  }
 
-        if (dnsheader->qr) {
-          t_Counters.at(rec::Counter::ignoredCount)++;
-          if (g_logCommonErrors) {
-            SLOG(g_log << Logger::Error << "Ignoring answer from " << fromaddr.toString() << " on server socket!" << endl,
-                 g_slogudpin->info(Logr::Error, "Ignoring answer on server socket", "remote", Logging::Loggable(fromaddr)));
-          }
-        }
-        else if (dnsheader->opcode != static_cast<unsigned>(Opcode::Query) && dnsheader->opcode != static_cast<unsigned>(Opcode::Notify)) {
-          t_Counters.at(rec::Counter::ignoredCount)++;
-          if (g_logCommonErrors) {
-            SLOG(g_log << Logger::Error << "Ignoring unsupported opcode " << Opcode::to_s(dnsheader->opcode) << " from " << fromaddr.toString() << " on server socket!" << endl,
-                 g_slogudpin->info(Logr::Error, "Ignoring unsupported opcode server socket", "remote", Logging::Loggable(fromaddr), "opcode", Logging::Loggable(Opcode::to_s(dnsheader->opcode))));
-          }
-        }
-        else if (dnsheader->qdcount == 0U) {
-          t_Counters.at(rec::Counter::emptyQueriesCount)++;
-          if (g_logCommonErrors) {
-            SLOG(g_log << Logger::Error << "Ignoring empty (qdcount == 0) query from " << fromaddr.toString() << " on server socket!" << endl,
-                 g_slogudpin->info(Logr::Error, "Ignoring empty (qdcount == 0) query on server socket!", "remote", Logging::Loggable(fromaddr)));
-          }
-        }
-        else {
-          if (dnsheader->opcode == static_cast<unsigned>(Opcode::Notify)) {
-            if (!t_allowNotifyFrom || !t_allowNotifyFrom->match(&mappedSource)) {
-              if (!g_quiet) {
-                SLOG(g_log << Logger::Error << "[" << g_multiTasker->getTid() << "] dropping UDP NOTIFY from " << mappedSource.toString() << ", address not matched by allow-notify-from" << endl,
-                     g_slogudpin->info(Logr::Error, "Dropping UDP NOTIFY from address not matched by allow-notify-from",
-                                       "source", Logging::Loggable(mappedSource)));
-              }
+  DNSName qname;
+  uint16_t qtype = 0;
+  uint16_t qclass = 0;
+  uint32_t qhash = 0;
+  RecursorPacketCache::OptPBData pbData{boost::none};
+  auto& response = batch.d_responses.at(idx);
+  if (!checkForCacheHit(false, 0, question, qname, qtype, qclass, g_now, response, qhash, pbData, false, fromaddr, fromaddr)) {
+    missedQHash = qhash;
+    return false;
+  }
 
-              t_Counters.at(rec::Counter::sourceDisallowedNotify)++;
-              return;
-            }
-          }
+  RecThreadInfo::self().incNumberOfDistributedQueries();
+  ++t_Counters.at(rec::Counter::qcounter);
+  if (fromaddr.sin4.sin_family == AF_INET6) {
+    t_Counters.at(rec::Counter::ipv6qcounter)++;
+  }
+  if (t_remotes) {
+    t_remotes->push_back(fromaddr);
+  }
+  t_Counters.at(rec::Counter::udpFastPathAnswers)++;
+  t_Counters.at(rec::Histogram::cumulativeAnswers)(tval.tv_sec != 0 ? uSec(g_now - tval) : 0);
 
-          struct timeval tval = {0, 0};
-          HarvestTimestamp(&msgh, &tval);
-          if (!proxyProto) {
-            destination = destaddr;
-          }
+  auto& reply = batch.d_replyMsgs.at(batch.d_replies);
+  auto& cbuf = batch.d_replyCbufs.at(batch.d_replies);
+  fillMSGHdr(&reply.msg_hdr, &batch.d_replyIovs.at(batch.d_replies), &cbuf, 0, response.data(), response.length(), &fromaddr);
+  reply.msg_hdr.msg_control = nullptr;
+  reply.msg_len = 0;
+  if (g_fromtosockets.count(fileDesc) != 0) {
+    ComboAddress destaddr;
+    destaddr.reset();
+    if (HarvestDestinationAddress(&msgh, &destaddr)) {
+      addCMsgSrcAddr(&reply.msg_hdr, &cbuf, &destaddr, 0);
+    }
+  }
+  ++batch.d_replies;
+  return true;
+}
 
-          if (RecThreadInfo::weDistributeQueries()) {
-            std::string localdata = data;
-            distributeAsyncFunction(data, [localdata = std::move(localdata), fromaddr, destaddr, source, destination, mappedSource, tval, fileDesc, proxyProtocolValues, eventTrace, otTrace]() mutable {
-              return doProcessUDPQuestion(localdata, fromaddr, destaddr, source, destination, mappedSource, tval, fileDesc, proxyProtocolValues, eventTrace, otTrace);
-            });
-          }
-          else {
-            doProcessUDPQuestion(data, fromaddr, destaddr, source, destination, mappedSource, tval, fileDesc, proxyProtocolValues, eventTrace, otTrace);
-          }
-        }
+static void sendUDPFastPathReplies(int fileDesc, UDPFastPathBatch& batch)
+{
+  size_t done = 0;
+  while (done < batch.d_replies) {
+    int sent = sendmmsg(fileDesc, &batch.d_replyMsgs.at(done), batch.d_replies - done, 0);
+    if (sent <= 0) {
+      int err = errno;
+      if (g_logCommonErrors) {
+        const auto* remote = static_cast<const ComboAddress*>(batch.d_replyMsgs.at(done).msg_hdr.msg_name);
+        SLOG(g_log << Logger::Warning << "Sending UDP reply to client " << remote->toStringWithPort() << " failed with: " << stringerror(err) << endl,
+             g_slogudpin->error(Logr::Error, err, "Sending UDP reply to client failed", "remote", Logging::Loggable(*remote)));
       }
-      catch (const MOADNSException& mde) {
-        t_Counters.at(rec::Counter::clientParseError)++;
-        if (g_logCommonErrors) {
-          SLOG(g_log << Logger::Error << "Unable to parse packet from remote UDP client " << fromaddr.toString() << ": " << mde.what() << endl,
-               g_slogudpin->error(Logr::Error, mde.what(), "Unable to parse packet from remote UDP client", "remote", Logging::Loggable(fromaddr), "exception", Logging::Loggable("MOADNSException")));
-        }
+      // only the first remaining reply failed, skip it and carry on with the next ones
+      ++done;
+      continue;
+    }
+    done += sent;
+  }
+  batch.d_replies = 0;
+}
+
+static void handleNewUDPQuestionsFastPath(int fileDesc)
+{
+  static thread_local UDPFastPathBatch batch(g_udpFastPathBatchSize);
+  std::vector<ProxyProtocolValue> proxyProtocolValues;
+  RecEventTrace eventTrace;
+  pdns::trace::InitialSpanInfo otTrace;
+  bool firstBatch = true;
+  bool keepReading = true;
+
+  for (size_t queriesCounter = 0; keepReading && queriesCounter < g_maxUDPQueriesPerRound;) {
+    const auto wanted = std::min(batch.d_msgs.size(), g_maxUDPQueriesPerRound - queriesCounter);
+    for (size_t idx = 0; idx < wanted; idx++) {
+      auto& query = batch.d_queries.at(idx);
+      query.resize(512);
+      batch.d_from.at(idx).sin6.sin6_family = AF_INET6; // this makes sure the address is big enough
+      fillMSGHdr(&batch.d_msgs.at(idx).msg_hdr, &batch.d_iovs.at(idx), &batch.d_cbufs.at(idx), sizeof(cmsgbuf_aligned), query.data(), query.size(), &batch.d_from.at(idx));
+      batch.d_msgs.at(idx).msg_len = 0;
+    }
+
+    int received = recvmmsg(fileDesc, batch.d_msgs.data(), static_cast<unsigned int>(wanted), MSG_WAITFORONE, nullptr);
+    if (received <= 0) {
+      if (firstBatch && errno == EAGAIN) {
+        t_Counters.at(rec::Counter::noPacketError)++;
       }
-      catch (const std::runtime_error& e) {
-        t_Counters.at(rec::Counter::clientParseError)++;
-        if (g_logCommonErrors) {
-          SLOG(g_log << Logger::Error << "Unable to parse packet from remote UDP client " << fromaddr.toString() << ": " << e.what() << endl,
-               g_slogudpin->error(Logr::Error, e.what(), "Unable to parse packet from remote UDP client", "remote", Logging::Loggable(fromaddr), "exception", Logging::Loggable("std::runtime_error")));
-        }
+      break;
+    }
+    firstBatch = false;
+    t_Counters.at(rec::Counter::udpFastPathBatches)++;
+    queriesCounter += received;
+    // a short batch means the socket has been drained
+    keepReading = static_cast<size_t>(received) == wanted;
+    gettimeofday(&g_now, nullptr);
+
+    for (size_t idx = 0; idx < static_cast<size_t>(received); idx++) {
+      const auto len = batch.d_msgs.at(idx).msg_len;
+      batch.d_queries.at(idx).resize(len);
+      std::optional<uint32_t> missedQHash;
+      if (answerFromPacketCacheFastPath(fileDesc, batch, idx, missedQHash)) {
+        continue;
+      }
+      proxyProtocolValues.clear();
+      if (!handleUDPQuestion(fileDesc, batch.d_queries.at(idx), static_cast<ssize_t>(len), batch.d_from.at(idx), batch.d_msgs.at(idx).msg_hdr, proxyProtocolValues, eventTrace, otTrace, missedQHash)) {
+        // the queries of this batch have been read already, so we handle them but do not read any further
+        keepReading = false;
+      }
+    }
+    sendUDPFastPathReplies(fileDesc, batch);
+  }
+  t_Counters.updateSnap(g_regressionTestMode);
+}
+#endif /* HAVE_RECVMMSG && HAVE_SENDMMSG && MSG_WAITFORONE */
+
+static void handleNewUDPQuestion(int fileDesc, FDMultiplexer::funcparam_t& /* var */)
+{
+  const bool proxyActive = t_proxyProtocolACL && !t_proxyProtocolACL->empty();
+  static const size_t maxIncomingQuerySize = !proxyActive ? 512 : (512 + g_proxyProtocolMaximumSize);
+#if defined(HAVE_RECVMMSG) && defined(HAVE_SENDMMSG) && defined(MSG_WAITFORONE)
+  if (udpFastPathUsable(proxyActive)) {
+    handleNewUDPQuestionsFastPath(fileDesc);
+    return;
+  }
+#endif
+  static thread_local std::string data;
+  ComboAddress fromaddr; // the address the query is coming from
+  struct msghdr msgh{};
+  struct iovec iov{};
+  cmsgbuf_aligned cbuf;
+  bool firstQuery = true;
+  std::vector<ProxyProtocolValue> proxyProtocolValues;
+  RecEventTrace eventTrace;
+  pdns::trace::InitialSpanInfo otTrace;
+
+  for (size_t queriesCounter = 0; queriesCounter < g_maxUDPQueriesPerRound; queriesCounter++) {
+    proxyProtocolValues.clear();
+    data.resize(maxIncomingQuerySize);
+    fromaddr.sin6.sin6_family = AF_INET6; // this makes sure fromaddr is big enough
+    fillMSGHdr(&msgh, &iov, &cbuf, sizeof(cbuf), data.data(), data.size(), &fromaddr);
+
+    if (ssize_t len = recvmsg(fileDesc, &msgh, 0); len >= 0) {
+      firstQuery = false;
+      if (!handleUDPQuestion(fileDesc, data, len, fromaddr, msgh, proxyProtocolValues, eventTrace, otTrace, std::nullopt)) {
+        return;
       }
     }
     else {
@@ -2876,6 +3545,24 @@ static unsigned int selectWorker(unsigned int hash)
   return RecThreadInfo::numHandlers() + RecThreadInfo::numDistributors() + worker;
 }
 
+// Hash the registered domain of the qname, or the closest zone cut below it that the record cache knows about, instead of
+// the qname itself, so that queries for names in the same zone end up on the same worker, where they can be chained
+static unsigned int hashZoneForDistribution(const string& packet)
+{
+  const DNSName qname(packet.data(), static_cast<int>(packet.length()), sizeof(dnsheader), false);
+  DNSName zone = getRegisteredName(qname);
+  if (g_distributionHash == DistributionHash::ZoneCut && qname.isPartOf(zone)) {
+    const time_t now = time(nullptr);
+    for (DNSName cut(qname); cut.countLabels() > zone.countLabels(); cut.chopOff()) {
+      if (g_recCache->get(now, cut, QType::NS, MemRecursorCache::None, nullptr, ComboAddress()) > 0) {
+        zone = cut;
+        break;
+      }
+    }
+  }
+  return static_cast<unsigned int>(zone.hash(g_disthashseed));
+}
+
 // This function is only called by the distributor threads, when pdns-distributes-queries is set
 void distributeAsyncFunction(const string& packet, const pipefunc_t& func)
 {
@@ -2892,6 +3579,9 @@ void distributeAsyncFunction(const string& packet, const pipefunc_t& func)
     t_Counters.at(rec::Counter::ignoredCount)++;
     throw MOADNSException("too-short (" + std::to_string(packet.length()) + ") or invalid name");
   }
+  if (g_distributionHash != DistributionHash::QName) {
+    hash = hashZoneForDistribution(packet);
+  }
   unsigned int target = selectWorker(hash);
 
   ThreadMSG* tmsg = new ThreadMSG(); // NOLINT: pointer ownership
@@ -2920,6 +3610,10 @@ static void doResends(MT_t::waiters_t::iterator& iter, const std::shared_ptr<Pac
   // We close the chain for new entries, since they won't be processed anyway
   iter->key->closed = true;
 
+  if (g_maxCrossThreadChainLength > 0 && iter->key->fd >= 0) {
+    s_inFlightOutQueries.complete(*iter->key, content);
+  }
+
   if (iter->key->authReqChain.empty()) {
     return;
   }
@@ -2934,7 +3628,7 @@ static void doResends(MT_t::waiters_t::iterator& iter, const std::shared_ptr<Pac
     auto packetID = std::make_shared<PacketID>(*resend);
     packetID->fd = fileDesc;
     packetID->id = qid;
-    g_multiTasker->sendEvent(packetID, &content);
+    sendResponseEvent(packetID, content);
     t_Counters.at(rec::Counter::chainResends)++;
   }
 }
@@ -2990,6 +3684,10 @@ static void handleUDPServerResponse(int fileDesc, FDMultiplexer::funcparam_t& va
 
   if (len < 0) {
     // len < 0: error on socket
+    if (t_udpclientsocks->isPooled(fileDesc)) {
+      // not tied to a single query, the ones outstanding on this socket will time out if needed
+      return;
+    }
     t_udpclientsocks->returnSocket(fileDesc);
 
     PacketBuffer empty;
@@ -2997,7 +3695,7 @@ static void handleUDPServerResponse(int fileDesc, FDMultiplexer::funcparam_t& va
     if (iter != g_multiTasker->getWaiters().end()) {
       doResends(iter, pid, empty);
     }
-    g_multiTasker->sendEvent(pid, &empty); // this denotes error (does retry lookup using other NS)
+    sendResponseEvent(pid, empty); // this denotes error (does retry lookup using other NS)
     return;
   }
 
@@ -3062,7 +3760,7 @@ static void handleUDPServerResponse(int fileDesc, FDMultiplexer::funcparam_t& va
 
 retryWithName:
 
-  if (pident->domain.empty() || g_multiTasker->sendEvent(pident, &packet) == 0) {
+  if (pident->domain.empty() || sendResponseEvent(pident, packet) == 0) {
     /* we did not find a match for this response, something is wrong */
 
     // we do a full scan for outstanding queries on unexpected answers. not too bad since we only accept them on the right port number, which is hard enough to guess
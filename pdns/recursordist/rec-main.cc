@@ -111,6 +111,7 @@ static shared_ptr<std::set<ComboAddress>> g_initialProxyProtocolExceptions;
 boost::optional<ComboAddress> g_dns64Prefix{boost::none};
 DNSName g_dns64PrefixReverse;
 unsigned int g_maxChainLength;
+unsigned int g_maxCrossThreadChainLength;
 LockGuarded<std::shared_ptr<SyncRes::domainmap_t>> g_initialDomainMap; // new threads needs this to be setup
 LockGuarded<std::shared_ptr<NetmaskGroup>> g_initialAllowFrom; // new thread needs to be setup with this
 LockGuarded<std::shared_ptr<NetmaskGroup>> g_initialAllowNotifyFrom; // new threads need this to be setup
@@ -923,6 +924,7 @@ static void setupNODGlobal()
   if (!::arg().isEmpty("new-domain-ignore-list-file")) {
     parseIgnorelistFile(::arg()["new-domain-ignore-list-file"], g_nodDomainWL);
   }
+  g_nodDomainWL.compile();
 
   // Setup Unique DNS Response subsystem
   g_udrEnabled = ::arg().mustDo("unique-response-tracking");
@@ -933,6 +935,7 @@ static void setupNODGlobal()
   if (!::arg().isEmpty("unique-response-ignore-list-file")) {
     parseIgnorelistFile(::arg()["unique-response-ignore-list-file"], g_udrDomainWL);
   }
+  g_udrDomainWL.compile();
 }
 #endif /* NOD_ENABLED */
 
@@ -1373,6 +1376,7 @@ static std::shared_ptr<NetmaskGroup> parseACL(const std::string& aclFile, const
     }
   }
 
+  result->compile();
   return result;
 }
 
@@ -1503,6 +1507,7 @@ void parseACLs()
   if (!::arg()["proxy-protocol-from"].empty()) {
     proxyProtocolACL = std::make_shared<NetmaskGroup>();
     proxyProtocolACL->toMasks(::arg()["proxy-protocol-from"]);
+    proxyProtocolACL->compile();
 
     std::vector<std::string> vec;
     stringtok(vec, ::arg()["proxy-protocol-exceptions"], ", ");
@@ -1827,6 +1832,10 @@ static int initSyncRes(Logr::log_t log)
   SyncRes::s_maxqperq = ::arg().asNum("max-qperq");
   SyncRes::s_maxnsperresolve = ::arg().asNum("max-ns-per-resolve");
   SyncRes::s_maxnsaddressqperq = ::arg().asNum("max-ns-address-qperq");
+  SyncRes::s_maxhedgedqperq = ::arg().asNum("max-hedged-qperq");
+  SyncRes::s_gluelessnsprefetch = ::arg().asNum("glueless-ns-prefetch");
+  SyncRes::s_minadaptivetimeout = ::arg().asNum("adaptive-network-timeout-min");
+  SyncRes::s_maxadaptivetimeout = ::arg().asNum("adaptive-network-timeout-max");
   SyncRes::s_maxtotusec = 1000 * ::arg().asNum("max-total-msec");
   SyncRes::s_maxdepth = ::arg().asNum("max-recursion-depth");
   SyncRes::s_maxvalidationsperq = ::arg().asNum("max-signature-validations-per-query");
@@ -1855,6 +1864,8 @@ static int initSyncRes(Logr::log_t log)
   }
   MemRecursorCache::s_maxRRSetSize = ::arg().asNum("max-rrset-size");
   MemRecursorCache::s_limitQTypeAny = ::arg().mustDo("limit-qtype-any");
+  InternedDNSName::setInterning(::arg().mustDo("intern-names"));
+  MemRecursorCache::s_locklessReads = ::arg().mustDo("record-cache-lockless-reads");
 
   if (SyncRes::s_tcp_fast_open_connect) {
     checkFastOpenSysctl(true, log);
@@ -1929,6 +1940,16 @@ static unsigned int initDistribution(Logr::log_t log)
     SLOG(g_log << Logger::Warning << "Asked to run with a distribution-load-factor below 1.0, disabling it instead" << endl,
          log->info(Logr::Warning, "Asked to run with a distribution-load-factor below 1.0, disabling it instead"));
   }
+  if (::arg()["distribution-hash"] == "registered-domain") {
+    g_distributionHash = DistributionHash::RegisteredDomain;
+  }
+  else if (::arg()["distribution-hash"] == "zone-cut") {
+    g_distributionHash = DistributionHash::ZoneCut;
+  }
+  else if (::arg()["distribution-hash"] != "qname") {
+    SLOG(g_log << Logger::Warning << "Unknown distribution-hash '" << ::arg()["distribution-hash"] << "', using 'qname' instead" << endl,
+         log->info(Logr::Warning, "Unknown distribution-hash, using 'qname' instead", "distribution-hash", Logging::Loggable(::arg()["distribution-hash"])));
+  }
 
 #ifdef SO_REUSEPORT
   g_reusePort = ::arg().mustDo("reuseport");
@@ -2035,6 +2056,7 @@ static int initPorts(Logr::log_t log)
     return 99; // this isn't going to fix itself either
   }
   g_maxUdpSourcePort = port;
+  UDPClientSocks::s_batchSockets = ::arg().asNum("udp-batch-sockets");
   std::vector<string> parts{};
   stringtok(parts, ::arg()["udp-source-port-avoid"], ", ");
   for (const auto& part : parts) {
@@ -2123,6 +2145,7 @@ static void initSuffixMatchNodes([[maybe_unused]] Logr::log_t log)
     for (const auto& part : parts) {
       dontThrottleNames.add(DNSName(part));
     }
+    dontThrottleNames.compile();
     g_dontThrottleNames.setState(std::move(dontThrottleNames));
 
     NetmaskGroup dontThrottleNetmasks;
@@ -2137,6 +2160,7 @@ static void initSuffixMatchNodes([[maybe_unused]] Logr::log_t log)
     for (const auto& part : parts) {
       xdnssecNames.add(DNSName(part));
     }
+    xdnssecNames.compile();
     g_xdnssec.setState(std::move(xdnssecNames));
   }
 
@@ -2153,6 +2177,7 @@ static void initSuffixMatchNodes([[maybe_unused]] Logr::log_t log)
     for (const auto& part : parts) {
       dotauthNames.add(DNSName(part));
     }
+    dotauthNames.compile();
     g_DoTToAuthNames.setState(std::move(dotauthNames));
   }
 }
@@ -2261,6 +2286,7 @@ static int serviceMain(Logr::log_t log)
   if (!::arg()["proxy-protocol-from"].empty()) {
     g_initialProxyProtocolACL = std::make_shared<NetmaskGroup>();
     g_initialProxyProtocolACL->toMasks(::arg()["proxy-protocol-from"]);
+    g_initialProxyProtocolACL->compile();
 
     std::vector<std::string> vec;
     stringtok(vec, ::arg()["proxy-protocol-exceptions"], ", ");
@@ -2381,9 +2407,11 @@ static int serviceMain(Logr::log_t log)
   g_maxTCPPerClient = ::arg().asNum("max-tcp-per-client");
   g_tcpMaxQueriesPerConn = ::arg().asNum("max-tcp-queries-per-connection");
   g_maxUDPQueriesPerRound = ::arg().asNum("max-udp-queries-per-round");
+  g_udpFastPathBatchSize = ::arg().asNum("udp-fast-path-batch-size");
 
   g_useKernelTimestamp = ::arg().mustDo("protobuf-use-kernel-timestamp");
   g_maxChainLength = ::arg().asNum("max-chain-length");
+  g_maxCrossThreadChainLength = ::arg().asNum("max-cross-thread-chain-length");
 
   checkOrFixFDS(listeningSockets, log);
   checkOrFixLinuxMapCountLimits(log);
@@ -2568,6 +2596,14 @@ private:
   string name;
 };
 
+// Each of these mthreads resolves names from the cache warming list until it is exhausted
+static void runCacheWarming(void* /* ignored */)
+{
+  while (runCacheWarmingOnce(g_logCommonErrors)) {
+    ;
+  }
+}
+
 static void houseKeepingWork(Logr::log_t log)
 {
   struct timeval now{};
@@ -2602,6 +2638,10 @@ static void houseKeepingWork(Logr::log_t log)
     // TaskQueue is run always
     runTasks(10, g_logCommonErrors);
 
+    for (auto slots = claimCacheWarmingSlots(); slots > 0; --slots) {
+      g_multiTasker->makeThread(runCacheWarming, nullptr);
+    }
+
     static PeriodicTask ztcTask{"ZTC", 60};
     static map<DNSName, RecZoneToCache::State> ztcStates;
     ztcTask.runIfDue(now, [&luaconfsLocal]() {
@@ -2858,6 +2898,7 @@ static void recLoop()
       runLuaMaintenance(threadInfo, last_lua_maintenance, luaMaintenanceInterval);
 
       auto timeoutUsec = g_multiTasker->nextWaiterDelayUsec(500000);
+      t_udpclientsocks->flushQueries();
       t_fdm->run(&g_now, static_cast<int>(timeoutUsec / 1000));
       // 'run' updates g_now for us
     }
@@ -181,9 +181,40 @@ public:
   // return a socket to the pool, or simply erase it
   void returnSocket(int fileDesc);
 
+  // When s_batchSockets is not zero, queries are sent from a small pool of unconnected sockets per
+  // address family instead of from a connected socket per query. Packets are queued by
+  // queueQuery() and sent with as few system calls as possible by flushQueries(), which is called
+  // once per event loop iteration.
+  static unsigned int s_batchSockets;
+  LWResult::Result getPooledSocket(const ComboAddress& toaddr, int* fileDesc);
+  [[nodiscard]] bool isPooled(int fileDesc) const
+  {
+    return d_pooled.count(fileDesc) != 0;
+  }
+  void queueQuery(int fileDesc, const ComboAddress& toaddr, const void* data, size_t len);
+  void flushQueries();
+
 private:
+  struct PooledSocket
+  {
+    uint32_t d_uses{0};
+    uint32_t d_outstanding{0};
+    bool d_retired{false};
+  };
+  struct QueuedQuery
+  {
+    ComboAddress d_dest;
+    PacketBuffer d_packet;
+    int d_fd;
+  };
+
   // returns -1 for errors which might go away, throws for ones that won't
-  static int makeClientSocket(int family);
+  static int makeClientSocket(int family, bool receiveErrors = true);
+  void sendQueued(std::vector<QueuedQuery>::iterator begin, std::vector<QueuedQuery>::iterator end);
+
+  std::unordered_map<int, PooledSocket> d_pooled;
+  std::array<std::vector<int>, 2> d_active; // pooled sockets still handing out new queries, [0] for IPv4 and [1] for IPv6
+  std::vector<QueuedQuery> d_queued;
 };
 
 enum class PaddingMode
@@ -192,6 +223,14 @@ enum class PaddingMode
   PaddedQueries
 };
 
+// What the distributor threads hash to select the worker thread a query is sent to
+enum class DistributionHash
+{
+  QName,
+  RegisteredDomain,
+  ZoneCut
+};
+
 typedef MTasker<std::shared_ptr<PacketID>, PacketBuffer, PacketIDCompare> MT_t;
 extern thread_local std::unique_ptr<MT_t> g_multiTasker; // the big MTasker
 extern std::unique_ptr<RecursorPacketCache> g_packetCache;
@@ -218,10 +257,13 @@ extern unsigned int g_maxTCPPerClient;
 extern int g_tcpTimeout;
 extern uint16_t g_udpTruncationThreshold;
 extern double g_balancingFactor;
+extern DistributionHash g_distributionHash;
 extern size_t g_maxUDPQueriesPerRound;
+extern size_t g_udpFastPathBatchSize;
 extern bool g_useKernelTimestamp;
 extern bool g_allowNoRD;
 extern unsigned int g_maxChainLength;
+extern unsigned int g_maxCrossThreadChainLength;
 extern thread_local std::shared_ptr<NetmaskGroup> t_allowFrom;
 extern thread_local std::shared_ptr<NetmaskGroup> t_allowNotifyFrom;
 extern thread_local std::shared_ptr<notifyset_t> t_allowNotifyFor;
@@ -50,10 +50,12 @@ private:
       auto val = static_cast<float>(arg);
       if (d_val == 0) {
         d_val = val;
+        d_var = val / 2.0F;
       }
       else {
         auto diff = makeFloat(last - now);
         auto factor = expf(diff) / 2.0F; // might be '0.5', or 0.0001
+        d_var = (1.0F - factor) * std::abs(val - d_val) + factor * d_var;
         d_val = (1.0F - factor) * val + factor * d_val;
       }
     }
@@ -75,6 +77,7 @@ private:
 
     float d_val{0};
     int d_last{0};
+    float d_var{0}; // mean deviation, not shared with other recursors
   };
 
 public:
@@ -94,6 +97,16 @@ public:
     return expf(diff / 60.0F); // is 1.0 or less
   }
 
+  // Retransmission timeout in usec as in RFC 6298: SRTT + 4 * RTTVAR, 0 if we know nothing about remote
+  [[nodiscard]] float rto(const ComboAddress& remote) const
+  {
+    auto iter = d_collection.find(remote);
+    if (iter == d_collection.end()) {
+      return 0;
+    }
+    return iter->second.peek() + 4.0F * iter->second.d_var;
+  }
+
   bool stale(time_t limit) const
   {
     return limit > d_lastget.tv_sec;
@@ -113,7 +126,7 @@ public:
 
   void insert(const ComboAddress& address, float val, int last)
   {
-    d_collection.insert(std::make_pair(address, DecayingEwma{val, last}));
+    d_collection.insert(std::make_pair(address, DecayingEwma{val, last, val / 2.0F}));
   }
 
   // d_collection is the modifyable part of the record, we index on DNSName and timeval, and DNSName never changes
@@ -161,6 +174,13 @@ public:
     return ret;
   }
 
+  float rto(const DNSName& name, const ComboAddress& remote) const
+  {
+    const auto& ind = get<DNSName>();
+    auto iter = ind.find(name);
+    return iter == ind.end() ? 0 : iter->rto(remote);
+  }
+
   size_t getPB(const string& serverID, size_t maxSize, std::string& ret) const;
   size_t putPB(time_t cutoff, const std::string& pbuf);
 
@@ -115,7 +115,8 @@ static struct taskstats s_almost_expired_tasks;
 static struct taskstats s_resolve_tasks;
 
 // forceNoQM is true means resolve using no qm, false means use default value
-static void resolveInternal(const struct timeval& now, bool logErrors, const pdns::ResolveTask& task, bool forceNoQM) noexcept
+// Returns the rcode, or -1 if an exception occurred
+static int resolveInternal(const struct timeval& now, bool logErrors, const pdns::ResolveTask& task, bool forceNoQM) noexcept
 {
   auto log = g_slog->withName("taskq")->withValues("name", Logging::Loggable(task.d_qname), "qtype", Logging::Loggable(QType(task.d_qtype).toString()), "netmask", Logging::Loggable(task.d_netmask.empty() ? "" : task.d_netmask.toString()));
   const string msg = "Exception while running a background ResolveTask";
@@ -127,9 +128,10 @@ static void resolveInternal(const struct timeval& now, bool logErrors, const pdn
     resolver.setQNameMinimization(false);
   }
   bool exceptionOccurred = true;
+  int res = -1;
   try {
     log->info(Logr::Debug, "resolving", "refresh", Logging::Loggable(task.d_refreshMode));
-    int res = resolver.beginResolve(task.d_qname, QType(task.d_qtype), QClass::IN, ret);
+    res = resolver.beginResolve(task.d_qname, QType(task.d_qtype), QClass::IN, ret);
     exceptionOccurred = false;
     log->info(Logr::Debug, "done", "rcode", Logging::Loggable(res), "records", Logging::Loggable(ret.size()));
   }
@@ -168,6 +170,7 @@ static void resolveInternal(const struct timeval& now, bool logErrors, const pdn
       ++s_resolve_tasks.run;
     }
   }
+  return res;
 }
 
 static void resolveForceNoQM(const struct timeval& now, bool logErrors, const pdns::ResolveTask& task) noexcept
@@ -180,6 +183,37 @@ static void resolve(const struct timeval& now, bool logErrors, const pdns::Resol
   resolveInternal(now, logErrors, task, false);
 }
 
+struct CacheWarming
+{
+  std::vector<std::pair<DNSName, uint16_t>> names;
+  size_t next{0};
+  size_t done{0};
+  size_t failed{0};
+  size_t running{0};
+  size_t concurrency{0};
+  struct timeval start{};
+  struct timeval end{};
+};
+static LockGuarded<CacheWarming> s_cacheWarming;
+
+static void warm(const struct timeval& now, bool logErrors, const pdns::ResolveTask& task) noexcept
+{
+  auto res = resolveInternal(now, logErrors, task, false);
+  bool failed = res != RCode::NoError && res != RCode::NXDomain;
+
+  auto lock = s_cacheWarming.lock();
+  ++lock->done;
+  if (failed) {
+    ++lock->failed;
+  }
+  if (lock->done == lock->names.size()) {
+    Utility::gettimeofday(&lock->end);
+    auto elapsed = makeFloat(lock->end - lock->start);
+    g_slog->withName("taskq")->info(Logr::Notice, "Cache warming done", "names", Logging::Loggable(lock->done), "failed", Logging::Loggable(lock->failed),
+                                    "seconds", Logging::Loggable(elapsed), "qps", Logging::Loggable(elapsed > 0 ? static_cast<uint64_t>(static_cast<double>(lock->done) / elapsed) : 0));
+  }
+}
+
 static void tryDoT(const struct timeval& now, bool logErrors, const pdns::ResolveTask& task) noexcept
 {
   auto log = g_slog->withName("taskq")->withValues("method", Logging::Loggable("tryDoT"), "name", Logging::Loggable(task.d_qname), "qtype", Logging::Loggable(QType(task.d_qtype).toString()), "ip", Logging::Loggable(task.d_ip));
@@ -261,12 +295,12 @@ void pushAlmostExpiredTask(const DNSName& qname, uint16_t qtype, time_t deadline
   }
 }
 
-void pushResolveTask(const DNSName& qname, uint16_t qtype, time_t now, time_t deadline, bool forceQMOff)
+bool pushResolveTask(const DNSName& qname, uint16_t qtype, time_t now, time_t deadline, bool forceQMOff)
 {
   if (SyncRes::isUnsupported(qtype)) {
     auto log = g_slog->withName("taskq")->withValues("name", Logging::Loggable(qname), "qtype", Logging::Loggable(QType(qtype).toString()));
     log->error(Logr::Error, "Cannot push task", "qtype unsupported");
-    return;
+    return false;
   }
   auto func = forceQMOff ? resolveForceNoQM : resolve;
   pdns::ResolveTask task{qname, qtype, deadline, false, func, {}, {}, {}};
@@ -275,8 +309,10 @@ void pushResolveTask(const DNSName& qname, uint16_t qtype, time_t now, time_t de
   if (inserted) {
     if (lock->queue.push(std::move(task))) {
       ++s_resolve_tasks.pushed;
+      return true;
     }
   }
+  return false;
 }
 
 bool pushTryDoTTask(const DNSName& qname, uint16_t qtype, const ComboAddress& ipAddress, time_t deadline, const DNSName& nsname)
@@ -356,3 +392,58 @@ bool taskQTypeIsSupported(QType qtype)
 {
   return !SyncRes::isUnsupported(qtype);
 }
+
+bool startCacheWarming(std::vector<std::pair<DNSName, uint16_t>>&& names, size_t concurrency)
+{
+  auto lock = s_cacheWarming.lock();
+  if (lock->done < lock->names.size()) {
+    return false;
+  }
+  *lock = CacheWarming{};
+  lock->names = std::move(names);
+  lock->concurrency = concurrency;
+  Utility::gettimeofday(&lock->start);
+  return true;
+}
+
+size_t claimCacheWarmingSlots()
+{
+  auto lock = s_cacheWarming.lock();
+  if (lock->next >= lock->names.size() || lock->running >= lock->concurrency) {
+    return 0;
+  }
+  auto slots = std::min(lock->concurrency - lock->running, lock->names.size() - lock->next);
+  lock->running += slots;
+  return slots;
+}
+
+bool runCacheWarmingOnce(bool logErrors)
+{
+  pdns::ResolveTask task{};
+  {
+    auto lock = s_cacheWarming.lock();
+    if (lock->next >= lock->names.size()) {
+      --lock->running;
+      return false;
+    }
+    const auto& [qname, qtype] = lock->names.at(lock->next++);
+    task = pdns::ResolveTask{qname, qtype, time(nullptr) + 60, false, warm, {}, {}, {}};
+  }
+  // Not pushed to the task queue: the queue is drained at a slow pace and we want to control concurrency ourselves
+  (void)task.run(logErrors);
+  return true;
+}
+
+CacheWarmingStatus getCacheWarmingStatus()
+{
+  auto lock = s_cacheWarming.lock();
+  CacheWarmingStatus status{lock->names.size(), lock->done, lock->failed, lock->running, 0};
+  if (lock->start.tv_sec != 0) {
+    struct timeval end = lock->end;
+    if (lock->done < lock->names.size()) {
+      Utility::gettimeofday(&end);
+    }
+    status.elapsed = makeFloat(end - lock->start);
+  }
+  return status;
+}
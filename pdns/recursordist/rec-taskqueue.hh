@@ -23,6 +23,8 @@
 
 #include <cstdint>
 #include <ctime>
+#include <utility>
+#include <vector>
 #include <qtype.hh>
 
 class DNSName;
@@ -36,7 +38,7 @@ struct ResolveTask;
 void runTasks(size_t max, bool logErrors);
 bool runTaskOnce(bool logErrors);
 void pushAlmostExpiredTask(const DNSName& qname, uint16_t qtype, time_t deadline, const Netmask& netmask);
-void pushResolveTask(const DNSName& qname, uint16_t qtype, time_t now, time_t deadline, bool forceQMOff);
+bool pushResolveTask(const DNSName& qname, uint16_t qtype, time_t now, time_t deadline, bool forceQMOff);
 bool pushTryDoTTask(const DNSName& qname, uint16_t qtype, const ComboAddress& ipAddress, time_t deadline, const DNSName& nsname);
 void taskQueueClear();
 pdns::ResolveTask taskQueuePop();
@@ -57,3 +59,20 @@ uint64_t getAlmostExpiredTasksRun();
 uint64_t getAlmostExpiredTaskExceptions();
 
 bool taskQTypeIsSupported(QType qtype);
+
+// Cache warming: resolving a list of names in the background, at most concurrency at a time
+struct CacheWarmingStatus
+{
+  size_t total{0};
+  size_t done{0};
+  size_t failed{0}; // exception, ServFail or another unexpected rcode
+  size_t running{0};
+  double elapsed{0}; // seconds since the start, or until the end if done
+};
+
+// Returns false if cache warming is already in progress
+bool startCacheWarming(std::vector<std::pair<DNSName, uint16_t>>&& names, size_t concurrency);
+// The number of extra resolves to run concurrently, each calling runCacheWarmingOnce() until it returns false
+size_t claimCacheWarmingSlots();
+bool runCacheWarmingOnce(bool logErrors);
+CacheWarmingStatus getCacheWarmingStatus();
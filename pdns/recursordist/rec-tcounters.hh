@@ -99,6 +99,18 @@ enum class Counter : uint8_t
   maxChainWeight,
   chainLimits,
   ecsMissingCount,
+  udpBatchedQueries,
+  udpBatchSyscalls,
+  hedgedQueries,
+  hedgedQueriesWon,
+  gluelessNSPrefetches,
+  gluelessNSPrefetchHits,
+  udpFastPathAnswers,
+  udpFastPathBatches,
+  chainedOutQueries,
+  crossThreadDuplicateOutQueries,
+  crossThreadChainedOutQueries,
+  crossThreadChainLost,
 
   numberOfCounters
 };
@@ -135,6 +147,7 @@ enum class Histogram : uint8_t
   cumulativeAnswers,
   cumulativeAuth4Answers,
   cumulativeAuth6Answers,
+  cumulativeAdaptiveTimeouts,
 
   numberOfCounters
 };
@@ -209,7 +222,8 @@ struct Counters
     pdns::Histogram{"ourtime", {1000, 2000, 4000, 8000, 16000, 32000}},
     pdns::Histogram{"cumul-clientanswers-", 10, 19},
     pdns::Histogram{"cumul-authanswers-", 1000, 13},
-    pdns::Histogram{"cumul-authanswers-", 1000, 13}};
+    pdns::Histogram{"cumul-authanswers-", 1000, 13},
+    pdns::Histogram{"cumul-adaptivetimeouts-", 1000, 13}};
 
   // Response stats
   RecResponseStats responseStats{};
@@ -42,6 +42,7 @@
 #include <fcntl.h>
 #include "logger.hh"
 #include "dnsparser.hh"
+#include "dnspcap.hh"
 #include "arguments.hh"
 #include <sys/resource.h>
 #include <sys/time.h>
@@ -879,6 +880,136 @@ static string setMinimumTTL(ArgIterator begin, ArgIterator end)
   }
 }
 
+using WarmCacheNames = std::vector<std::pair<DNSName, uint16_t>>;
+
+static void addWarmCacheName(WarmCacheNames& names, std::set<std::pair<DNSName, uint16_t>>& seen, const DNSName& qname, uint16_t qtype)
+{
+  if (taskQTypeIsSupported(QType(qtype)) && seen.emplace(qname, qtype).second) {
+    names.emplace_back(qname, qtype);
+  }
+}
+
+// The questions of the queries in a pcap file, in order of appearance
+static WarmCacheNames readWarmCachePcap(const string& fname)
+{
+  WarmCacheNames names;
+  std::set<std::pair<DNSName, uint16_t>> seen;
+  PcapPacketReader reader(fname);
+  while (reader.getUDPPacket()) {
+    if (reader.d_len < sizeof(dnsheader)) {
+      continue;
+    }
+    dnsheader header{};
+    memcpy(&header, reader.d_payload, sizeof(header));
+    if (header.qr != 0 || header.qdcount == 0) {
+      continue;
+    }
+    try {
+      uint16_t qtype{};
+      DNSName qname(reinterpret_cast<const char*>(reader.d_payload), static_cast<int>(reader.d_len), sizeof(dnsheader), false, &qtype); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+      addWarmCacheName(names, seen, qname, qtype);
+    }
+    catch (const std::exception& e) {
+      // not a question we can use
+    }
+  }
+  return names;
+}
+
+// One name per line, optionally followed by a type (A if absent) and anything else, as in the output of dnspcap2calidns.
+// Empty lines and lines starting with a # are skipped.
+static WarmCacheNames readWarmCacheList(const string& fname)
+{
+  WarmCacheNames names;
+  std::set<std::pair<DNSName, uint16_t>> seen;
+  std::ifstream input(fname);
+  if (!input) {
+    throw std::runtime_error("Unable to open file: " + stringerror());
+  }
+  string line;
+  size_t lineno = 0;
+  while (std::getline(input, line)) {
+    ++lineno;
+    boost::trim(line);
+    if (line.empty() || line.at(0) == '#') {
+      continue;
+    }
+    vector<string> parts;
+    stringtok(parts, line, " \t");
+    try {
+      uint16_t qtype = parts.size() > 1 ? QType::chartocode(parts.at(1).c_str()) : static_cast<uint16_t>(QType::A);
+      if (qtype == 0) {
+        throw std::runtime_error("unknown type '" + parts.at(1) + "'");
+      }
+      addWarmCacheName(names, seen, DNSName(parts.at(0)), qtype);
+    }
+    catch (const std::exception& e) {
+      throw std::runtime_error("line " + std::to_string(lineno) + ": " + e.what());
+    }
+  }
+  return names;
+}
+
+static bool isPcapFile(const string& fname)
+{
+  std::ifstream input(fname, std::ios::binary);
+  uint32_t magic{0};
+  input.read(reinterpret_cast<char*>(&magic), sizeof(magic)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+  return input && magic == 0xa1b2c3d4;
+}
+
+static RecursorControlChannel::Answer doWarmCache(ArgIterator begin, ArgIterator end)
+{
+  if (begin == end) {
+    return {1, "Need to supply a file name\n"};
+  }
+  const string fname = *begin++;
+  size_t concurrency = 100;
+  if (begin != end) {
+    try {
+      pdns::checked_stoi_into(concurrency, *begin);
+    }
+    catch (const std::exception& e) {
+      return {1, "Error parsing the concurrency: " + std::string(e.what()) + "\n"};
+    }
+  }
+  concurrency = std::clamp(concurrency, static_cast<size_t>(1), static_cast<size_t>(::arg().asNum("max-mthreads")));
+
+  WarmCacheNames names;
+  try {
+    names = isPcapFile(fname) ? readWarmCachePcap(fname) : readWarmCacheList(fname);
+  }
+  catch (const std::exception& e) {
+    return {1, "Error reading '" + fname + "': " + e.what() + "\n"};
+  }
+  if (names.empty()) {
+    return {1, "No names to resolve found in '" + fname + "'\n"};
+  }
+  const auto count = names.size();
+  if (!startCacheWarming(std::move(names), concurrency)) {
+    return {1, "Cache warming already in progress, see warm-cache-status\n"};
+  }
+  g_slog->withName("control")->info(Logr::Notice, "Cache warming started", "file", Logging::Loggable(fname), "names", Logging::Loggable(count), "concurrency", Logging::Loggable(concurrency));
+  return {0, "Resolving " + std::to_string(count) + " names from '" + fname + "', " + std::to_string(concurrency) + " at a time\n"};
+}
+
+static RecursorControlChannel::Answer doWarmCacheStatus()
+{
+  auto status = getCacheWarmingStatus();
+  if (status.total == 0) {
+    return {0, "No cache warming started\n"};
+  }
+  std::ostringstream str;
+  str << (status.done < status.total ? "In progress" : "Done") << ": " << status.done << "/" << status.total << " names resolved, "
+      << status.failed << " failed, " << status.running << " running, "
+      << boost::format("%.1f") % status.elapsed << " seconds";
+  if (status.elapsed > 0) {
+    str << ", " << static_cast<uint64_t>(static_cast<double>(status.done) / status.elapsed) << " names/second";
+  }
+  str << endl;
+  return {0, str.str()};
+}
+
 static string setMinimumECSTTL(ArgIterator begin, ArgIterator end)
 {
   if (end - begin != 1) {
@@ -1358,6 +1489,9 @@ static void registerAllStats1()
   addGetStat("cumul-authanswers", []() {
     return toStatsMap(t_Counters.at(rec::Histogram::cumulativeAuth4Answers).getName(), g_Counters.sum(rec::Histogram::cumulativeAuth4Answers), g_Counters.sum(rec::Histogram::cumulativeAuth6Answers));
   });
+  addGetStat("cumul-adaptivetimeouts", []() {
+    return toStatsMap(t_Counters.at(rec::Histogram::cumulativeAdaptiveTimeouts).getName(), g_Counters.sum(rec::Histogram::cumulativeAdaptiveTimeouts));
+  });
   addGetStat("policy-hits", []() {
     return toRPZStatsMap("policy-hits", g_Counters.sum(rec::PolicyNameHits::policyName).counts);
   });
@@ -1694,6 +1828,7 @@ static string addDontThrottleNames(ArgIterator begin, ArgIterator end)
     dnt.add(name);
   }
 
+  dnt.compile();
   g_dontThrottleNames.setState(std::move(dnt));
 
   ret += " to the list of nameservers that may not be throttled";
@@ -1779,6 +1914,7 @@ static string clearDontThrottleNames(ArgIterator begin, ArgIterator end)
     dnt.remove(name);
   }
 
+  dnt.compile();
   g_dontThrottleNames.setState(std::move(dnt));
 
   ret += " from the list of nameservers that may not be throttled";
@@ -1943,6 +2079,8 @@ static RecursorControlChannel::Answer help()
           "top-bogus-remotes                show top remotes receiving bogus answers\n"
           "unload-lua-script                unload Lua script\n"
           "version                          return version number of running Recursor\n"
+          "warm-cache <filename> [N]        resolve the names in a list or pcap file in the background, N at a time\n"
+          "warm-cache-status                show the progress of warm-cache\n"
           "wipe-cache domain0 [domain1] ..  wipe domain data from cache\n"
           "wipe-cache-typed type domain0 [domain1] ..  wipe domain data with qtype from cache\n"};
 }
@@ -2275,6 +2413,12 @@ RecursorControlChannel::Answer RecursorControlParser::getAnswer(int socket, cons
   if (cmd == "set-aggr-nsec-cache-size") {
     return setAggrNSECCacheSize(begin, end);
   }
+  if (cmd == "warm-cache") {
+    return doWarmCache(begin, end);
+  }
+  if (cmd == "warm-cache-status") {
+    return doWarmCacheStatus();
+  }
 
   return {1, "Unknown command '" + cmd + "', try 'help'\n"};
 }
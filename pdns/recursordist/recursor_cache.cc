@@ -76,6 +76,7 @@
 uint16_t MemRecursorCache::s_maxServedStaleExtensions;
 uint16_t MemRecursorCache::s_maxRRSetSize = 256;
 bool MemRecursorCache::s_limitQTypeAny = true;
+bool MemRecursorCache::s_locklessReads = false;
 
 const MemRecursorCache::AuthRecs MemRecursorCache::s_emptyAuthRecs = std::make_shared<MemRecursorCache::AuthRecsVec>();
 const MemRecursorCache::SigRecs MemRecursorCache::s_emptySigRecs = std::make_shared<MemRecursorCache::SigRecsVec>();
@@ -88,6 +89,7 @@ void MemRecursorCache::resetStaticsForTests()
   SyncRes::s_minimumTTL = 0;
   s_maxRRSetSize = 256;
   s_limitQTypeAny = true;
+  s_locklessReads = false;
 }
 
 MemRecursorCache::MemRecursorCache(size_t mapsCount) :
@@ -207,75 +209,210 @@ static void ptrAssign(T* ptr, const T& value)
   }
 }
 
-time_t MemRecursorCache::handleHit(time_t now, MapCombo::LockedContent& content, OrderedTagIterator_t& entry, const DNSName& qname, uint32_t& origTTL, vector<DNSRecord>* res, SigRecs* signatures, AuthRecs* authorityRecs, bool* variable, boost::optional<vState>& state, bool* wasAuth, DNSName* fromAuthZone, ComboAddress* fromAuthIP)
+void MemRecursorCache::copyEntry(const CacheEntry& entry, const DNSName& qname, uint32_t& origTTL, vector<DNSRecord>* res, SigRecs* signatures, AuthRecs* authorityRecs, bool* variable, boost::optional<vState>& state, bool* wasAuth, DNSName* fromAuthZone, ComboAddress* fromAuthIP)
 {
-  // MUTEX SHOULD BE ACQUIRED (as indicated by the reference to the content which is protected by a lock)
-  if (entry->d_tooBig) {
-    throw ImmediateServFailException("too many records in RRSet");
-  }
-  time_t ttd = entry->d_ttd;
-  if (ttd <= now) {
-    // Expired, don't bother returning contents. Callers *MUST* check return value of get(), and only look at the entry
-    // if it returned > 0
-    return ttd;
-  }
-  origTTL = entry->d_orig_ttl;
+  origTTL = entry.d_orig_ttl;
 
-  if (!entry->d_netmask.empty() || entry->d_rtag) {
+  if (!entry.d_netmask.empty() || entry.d_rtag) {
     ptrAssign(variable, true);
   }
 
   if (res != nullptr) {
-    if (s_limitQTypeAny && res->size() + entry->d_records.size() > s_maxRRSetSize) {
+    if (s_limitQTypeAny && res->size() + entry.d_records.size() > s_maxRRSetSize) {
       throw ImmediateServFailException("too many records in result");
     }
 
-    res->reserve(res->size() + entry->d_records.size());
+    res->reserve(res->size() + entry.d_records.size());
 
-    for (const auto& record : entry->d_records) {
+    for (const auto& record : entry.d_records) {
       DNSRecord result;
       result.d_name = qname;
-      result.d_type = entry->d_qtype;
+      result.d_type = entry.d_qtype;
       result.d_class = QClass::IN;
       result.setContent(record);
       // coverity[store_truncates_time_t]
-      result.d_ttl = static_cast<uint32_t>(entry->d_ttd);
+      result.d_ttl = static_cast<uint32_t>(entry.d_ttd);
       result.d_place = DNSResourceRecord::ANSWER;
       res->push_back(std::move(result));
     }
   }
 
   if (signatures != nullptr) {
-    if (*signatures && !(*signatures)->empty() && entry->d_signatures && !entry->d_signatures->empty()) {
+    if (*signatures && !(*signatures)->empty() && entry.d_signatures && !entry.d_signatures->empty()) {
       // Return a new vec if we need to append to a non-empty vector
       SigRecsVec vec(**signatures);
-      vec.insert(vec.end(), entry->d_signatures->cbegin(), entry->d_signatures->cend());
+      vec.insert(vec.end(), entry.d_signatures->cbegin(), entry.d_signatures->cend());
       *signatures = std::make_shared<SigRecsVec>(std::move(vec));
     }
     else {
-      *signatures = entry->d_signatures ? entry->d_signatures : s_emptySigRecs;
+      *signatures = entry.d_signatures ? entry.d_signatures : s_emptySigRecs;
     }
   }
 
   if (authorityRecs != nullptr) {
     // XXX Might need to be adapted like sigs to handle a non-empty incoming authorityRecs
     assert(*authorityRecs == nullptr || (*authorityRecs)->empty());
-    *authorityRecs = entry->d_authorityRecs ? entry->d_authorityRecs : s_emptyAuthRecs;
+    *authorityRecs = entry.d_authorityRecs ? entry.d_authorityRecs : s_emptyAuthRecs;
   }
 
-  updateDNSSECValidationStateFromCache(state, entry->d_state);
+  updateDNSSECValidationStateFromCache(state, entry.d_state);
 
   if (wasAuth != nullptr) {
-    *wasAuth = *wasAuth && entry->d_auth;
+    *wasAuth = *wasAuth && entry.d_auth;
+  }
+  ptrAssign(fromAuthZone, *entry.d_authZone);
+  ptrAssign(fromAuthIP, entry.d_from);
+}
+
+time_t MemRecursorCache::handleHit(time_t now, MapCombo::LockedContent& content, OrderedTagIterator_t& entry, const DNSName& qname, uint32_t& origTTL, vector<DNSRecord>* res, SigRecs* signatures, AuthRecs* authorityRecs, bool* variable, boost::optional<vState>& state, bool* wasAuth, DNSName* fromAuthZone, ComboAddress* fromAuthIP)
+{
+  // MUTEX SHOULD BE ACQUIRED (as indicated by the reference to the content which is protected by a lock)
+  if (entry->d_tooBig) {
+    throw ImmediateServFailException("too many records in RRSet");
+  }
+  time_t ttd = entry->d_ttd;
+  if (ttd <= now) {
+    // Expired, don't bother returning contents. Callers *MUST* check return value of get(), and only look at the entry
+    // if it returned > 0
+    return ttd;
   }
-  ptrAssign(fromAuthZone, entry->d_authZone);
-  ptrAssign(fromAuthIP, entry->d_from);
+
+  copyEntry(*entry, qname, origTTL, res, signatures, authorityRecs, variable, state, wasAuth, fromAuthZone, fromAuthIP);
 
   moveCacheItemToBack<SequencedTag>(content.d_map, entry);
 
   return ttd;
 }
 
+/*
+ * LOCKLESS READS: the general approach
+ *
+ * When s_locklessReads is set, an entry found by get() while holding the shard lock is copied into
+ * one of the shard's published buckets, an immutable vector of shared pointers that is replaced
+ * (never modified) while holding the lock, and read by get() without taking it. Only the plain
+ * case is handled that way: no routing tag, no ECS-specific entry for that name and type, no ANY
+ * or ADDR query, no refresh or serve-stale lookup. Everything else takes the locked path.
+ *
+ * Each shard has a generation counter, and a copy is only valid as long as the shard is in the
+ * generation it was published in. Every modification of the shard increments the generation, so
+ * a reader never serves a copy that is older than what the locked path would return. The price is
+ * that a write invalidates all copies of that shard, which are published again by the next locked
+ * hit.
+ *
+ * Lockless hits do not move the entry to the back of the LRU list, but mark the copy as touched.
+ * sweepPublished(), called after each prune, moves the touched entries to the back and drops the
+ * copies that were not used since the previous sweep or whose entry has been pruned. The LRU order
+ * is thus only approximate, with the granularity of the pruning interval.
+ */
+bool MemRecursorCache::getPublished(MapCombo& shard, size_t hash, time_t now, const DNSName& qname, const QType qtype, bool requireAuth, time_t& ttl, vector<DNSRecord>* res, SigRecs* signatures, AuthRecs* authorityRecs, vState* state, bool* wasAuth, DNSName* fromAuthZone, ComboAddress* fromAuthIP) const
+{
+  auto bucket = shard.getPublished(getPublishedIndex(hash));
+  if (!bucket) {
+    return false;
+  }
+  const auto generation = shard.getGeneration();
+
+  for (const auto& published : *bucket) {
+    const auto& entry = published->d_entry;
+    if (entry.d_qtype != qtype || entry.d_qname != qname) {
+      continue;
+    }
+    if (entry.d_publishedGeneration != generation || entry.d_ttd <= now || (requireAuth && !entry.d_auth)) {
+      return false;
+    }
+    // leave almost expired entries to the locked path, which takes care of pushing a refresh task
+    // coverity[store_truncates_time_t]
+    const auto remaining = static_cast<uint32_t>(entry.d_ttd - now);
+    if (SyncRes::s_refresh_ttlperc > 0 && remaining <= entry.d_orig_ttl * SyncRes::s_refresh_ttlperc / 100 && qname != g_rootdnsname) {
+      return false;
+    }
+
+    boost::optional<vState> cachedState{boost::none};
+    uint32_t origTTL = 0;
+    copyEntry(entry, qname, origTTL, res, signatures, authorityRecs, nullptr, cachedState, wasAuth, fromAuthZone, fromAuthIP);
+    ptrAssign(state, *cachedState);
+    if (!published->d_touched.load(std::memory_order_relaxed)) {
+      published->d_touched.store(true, std::memory_order_relaxed);
+    }
+    ttl = remaining;
+    return true;
+  }
+  return false;
+}
+
+void MemRecursorCache::publish(MapCombo& shard, const MapCombo::LockedContent& content, size_t hash, const CacheEntry& entry) const
+{
+  // MUTEX SHOULD BE ACQUIRED
+  const auto generation = shard.getGeneration();
+  if (!s_locklessReads || entry.d_publishedGeneration == generation) {
+    return;
+  }
+  if (!entry.d_netmask.empty() || entry.d_rtag || entry.d_tooBig || entry.d_servedStale > 0) {
+    return;
+  }
+  if (content.d_ecsIndex.find(std::tie(entry.d_qname, entry.d_qtype)) != content.d_ecsIndex.end()) {
+    return;
+  }
+
+  const auto index = getPublishedIndex(hash);
+  auto current = shard.getPublished(index);
+  auto bucket = std::make_shared<PublishedBucket>();
+  if (current) {
+    bucket->reserve(current->size() + 1);
+    for (const auto& published : *current) {
+      const auto& other = published->d_entry;
+      // drop the copies from a previous generation while we are at it
+      if (other.d_publishedGeneration == generation && (other.d_qtype != entry.d_qtype || other.d_qname != entry.d_qname)) {
+        bucket->push_back(published);
+      }
+    }
+  }
+  if (bucket->size() >= s_maxPublishedPerBucket) {
+    return;
+  }
+  entry.d_publishedGeneration = generation;
+  bucket->push_back(std::make_shared<const PublishedEntry>(entry));
+  shard.setPublished(index, std::move(bucket));
+}
+
+void MemRecursorCache::sweepPublished()
+{
+  for (auto& shard : d_maps) {
+    auto lockedShard = shard.lock();
+    const auto generation = shard.getGeneration();
+    for (size_t index = 0; index < s_publishedBuckets; ++index) {
+      auto current = shard.getPublished(index);
+      if (!current) {
+        continue;
+      }
+      auto bucket = std::make_shared<PublishedBucket>();
+      for (const auto& published : *current) {
+        const auto& entry = published->d_entry;
+        if (entry.d_publishedGeneration != generation) {
+          continue;
+        }
+        auto key = std::tuple(entry.d_qname, entry.d_qtype, boost::none, Netmask());
+        auto iter = lockedShard->d_map.find(key);
+        if (iter == lockedShard->d_map.end()) {
+          // pruned
+          continue;
+        }
+        if (!published->d_touched.exchange(false)) {
+          // not used since the last sweep, it will be published again by the next locked hit
+          iter->d_publishedGeneration = 0;
+          continue;
+        }
+        moveCacheItemToBack<SequencedTag>(lockedShard->d_map, iter);
+        bucket->push_back(published);
+      }
+      if (bucket->empty()) {
+        bucket.reset();
+      }
+      shard.setPublished(index, std::move(bucket));
+    }
+  }
+}
+
 static void pushRefreshTask(const DNSName& qname, QType qtype, time_t deadline, const Netmask& netmask)
 {
   if (qtype == QType::ADDR) {
@@ -444,7 +581,16 @@ time_t MemRecursorCache::get(time_t now, const DNSName& qname, const QType qtype
   // so it will be set to false if at least one entry is not auth
   ptrAssign(wasAuth, true);
 
-  auto& shard = getMap(qname);
+  const auto hash = qname.hash();
+  auto& shard = d_maps.at(hash % d_maps.size());
+
+  if (s_locklessReads && !routingTag && qtype != QType::ANY && qtype != QType::ADDR && !refresh && !serveStale) {
+    time_t ttl{};
+    if (getPublished(shard, hash, now, qname, qtype, requireAuth, ttl, res, signatures, authorityRecs, state, wasAuth, fromAuthZone, fromAuthIP)) {
+      return ttl;
+    }
+  }
+
   auto lockedShard = shard.lock();
 
   /* If we don't have any netmask-specific entries at all, let's just skip this
@@ -479,6 +625,7 @@ time_t MemRecursorCache::get(time_t now, const DNSName& qname, const QType qtype
       time_t ret = handleHit(now, *lockedShard, entry, qname, origTTL, res, signatures, authorityRecs, variable, cachedState, wasAuth, fromAuthZone, fromAuthIP);
       if (cachedState && ret > now) {
         ptrAssign(state, *cachedState);
+        publish(shard, *lockedShard, hash, *entry);
       }
       return fakeTTD(entry, qname, qtype, ret, now, origTTL, refresh);
     }
@@ -562,6 +709,9 @@ time_t MemRecursorCache::get(time_t now, const DNSName& qname, const QType qtype
     if (found > 0) {
       if (cachedState && ttd > now) {
         ptrAssign(state, *cachedState);
+        if (qtype != QType::ANY && qtype != QType::ADDR) {
+          publish(shard, *lockedShard, hash, *firstIndexIterator);
+        }
       }
       return fakeTTD(firstIndexIterator, qname, qtype, ttd, now, origTTL, refresh);
     }
@@ -622,6 +772,7 @@ bool MemRecursorCache::replace(CacheEntry&& entry)
   auto lockedShard = shard.lock();
 
   lockedShard->d_cachecachevalid = false;
+  shard.invalidatePublished();
   entry.d_submitted = false;
   if (lockedShard->d_map.emplace(std::move(entry)).second) {
     shard.incEntriesCount();
@@ -636,6 +787,7 @@ void MemRecursorCache::replace(time_t now, const DNSName& qname, const QType qty
   auto lockedShard = shard.lock();
 
   lockedShard->d_cachecachevalid = false;
+  shard.invalidatePublished();
   if (ednsmask) {
     ednsmask = ednsmask->getNormalized();
   }
@@ -703,7 +855,9 @@ void MemRecursorCache::replace(time_t now, const DNSName& qname, const QType qty
     cacheEntry.d_authorityRecs = nullptr;
   }
   cacheEntry.d_records.clear();
-  cacheEntry.d_authZone = authZone;
+  if (cacheEntry.d_authZone->getStorage() != authZone.getStorage()) {
+    cacheEntry.d_authZone = InternedDNSName(authZone);
+  }
   if (from) {
     cacheEntry.d_from = *from;
   }
@@ -755,6 +909,7 @@ size_t MemRecursorCache::doWipeCache(const DNSName& name, bool sub, const QType
     auto& shard = getMap(name);
     auto lockedShard = shard.lock();
     lockedShard->d_cachecachevalid = false;
+    shard.invalidatePublished();
     auto& idx = lockedShard->d_map.get<OrderedTag>();
     auto range = idx.equal_range(name);
     auto iter = range.first;
@@ -784,6 +939,7 @@ size_t MemRecursorCache::doWipeCache(const DNSName& name, bool sub, const QType
     for (auto& content : d_maps) {
       auto map = content.lock();
       map->d_cachecachevalid = false;
+      content.invalidatePublished();
       auto& idx = map->d_map.get<OrderedTag>();
       for (auto i = idx.lower_bound(name); i != idx.end();) {
         if (!i->d_qname.isPartOf(name)) {
@@ -834,6 +990,7 @@ bool MemRecursorCache::doAgeCache(time_t now, const DNSName& name, const QType q
   auto maxTTL = static_cast<uint32_t>(cacheEntry.d_ttd - now);
   if (maxTTL > newTTL) {
     lockedShard->d_cachecachevalid = false;
+    shard.invalidatePublished();
 
     time_t newTTD = now + newTTL;
 
@@ -857,6 +1014,7 @@ bool MemRecursorCache::updateValidationStatus(time_t now, const DNSName& qname,
 
   auto& content = getMap(qname);
   auto map = content.lock();
+  content.invalidatePublished();
 
   bool updated = false;
   if (!map->d_ecsIndex.empty() && !routingTag) {
@@ -927,7 +1085,7 @@ uint64_t MemRecursorCache::doDump(int fileDesc, size_t maxCacheEntries)
       for (const auto& record : recordSet.d_records) {
         count++;
         try {
-          fprintf(filePtr.get(), "%s %" PRIu32 " %" PRId64 " IN %s %s ; (%s) auth=%i zone=%s from=%s nm=%s rtag=%s ss=%hd%s\n", recordSet.d_qname.toString().c_str(), recordSet.d_orig_ttl, static_cast<int64_t>(recordSet.d_ttd - now), recordSet.d_qtype.toString().c_str(), record->getZoneRepresentation().c_str(), vStateToString(recordSet.d_state).c_str(), static_cast<int>(recordSet.d_auth), recordSet.d_authZone.toLogString().c_str(), recordSet.d_from.toString().c_str(), recordSet.d_netmask.empty() ? "" : recordSet.d_netmask.toString().c_str(), !recordSet.d_rtag ? "" : recordSet.d_rtag.get().c_str(), recordSet.d_servedStale, recordSet.d_tooBig ? " (too big!)" : "");
+          fprintf(filePtr.get(), "%s %" PRIu32 " %" PRId64 " IN %s %s ; (%s) auth=%i zone=%s from=%s nm=%s rtag=%s ss=%hd%s\n", recordSet.d_qname.toString().c_str(), recordSet.d_orig_ttl, static_cast<int64_t>(recordSet.d_ttd - now), recordSet.d_qtype.toString().c_str(), record->getZoneRepresentation().c_str(), vStateToString(recordSet.d_state).c_str(), static_cast<int>(recordSet.d_auth), recordSet.d_authZone->toLogString().c_str(), recordSet.d_from.toString().c_str(), recordSet.d_netmask.empty() ? "" : recordSet.d_netmask.toString().c_str(), !recordSet.d_rtag ? "" : recordSet.d_rtag.get().c_str(), recordSet.d_servedStale, recordSet.d_tooBig ? " (too big!)" : "");
         }
         catch (...) {
           fprintf(filePtr.get(), "; error printing '%s'\n", recordSet.d_qname.empty() ? "EMPTY" : recordSet.d_qname.toString().c_str());
@@ -954,6 +1112,9 @@ void MemRecursorCache::doPrune(time_t now, size_t keep)
 {
   size_t cacheSize = size();
   pruneMutexCollectionsVector<SequencedTag>(now, d_maps, keep, cacheSize);
+  if (s_locklessReads) {
+    sweepPublished();
+  }
 }
 
 enum class PBCacheDump : protozero::pbf_tag_type
@@ -1023,7 +1184,7 @@ void MemRecursorCache::getRecordSet(T& message, U recordSet)
       auth.add_uint32(PBAuthRecord::required_uint32_clen, authRec.d_clen);
     }
   }
-  message.add_bytes(PBCacheEntry::required_bytes_authZone, recordSet->d_authZone.toString());
+  message.add_bytes(PBCacheEntry::required_bytes_authZone, recordSet->d_authZone->toString());
   encodeComboAddress(message, PBCacheEntry::required_message_from, recordSet->d_from);
   encodeNetmask(message, PBCacheEntry::optional_bytes_netmask, recordSet->d_netmask);
   if (recordSet->d_rtag) {
@@ -1147,7 +1308,7 @@ bool MemRecursorCache::putRecordSet(T& message)
       cacheEntry.d_qname = DNSName(message.get_bytes());
       break;
     case PBCacheEntry::required_bytes_authZone:
-      cacheEntry.d_authZone = DNSName(message.get_bytes());
+      cacheEntry.d_authZone = InternedDNSName(DNSName(message.get_bytes()));
       break;
     case PBCacheEntry::required_message_from:
       decodeComboAddress(message, cacheEntry.d_from);
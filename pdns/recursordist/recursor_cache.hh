@@ -20,6 +20,8 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 #pragma once
+#include <array>
+#include <atomic>
 #include <string>
 #include "dns.hh"
 #include "qtype.hh"
@@ -56,6 +58,9 @@ public:
   // but mark it as too big. Subsequent gets will cause an ImmediateServFailException to be thrown.
   static uint16_t s_maxRRSetSize;
   static bool s_limitQTypeAny;
+  // Whether record sets found by get() are published so that later lookups can be served without
+  // taking the shard lock, see the comment above MemRecursorCache::getPublished()
+  static bool s_locklessReads;
 
   [[nodiscard]] size_t size() const;
   [[nodiscard]] size_t bytes();
@@ -168,8 +173,8 @@ private:
     Netmask d_netmask; // 36
     ComboAddress d_from; // 28
     records_t d_records; // 24
-    DNSName d_qname; // 24
-    DNSName d_authZone; // 24
+    DNSName d_qname; // 64
+    InternedDNSName d_authZone; // 8
     SigRecs d_signatures; // 16
     AuthRecs d_authorityRecs; // 16
     mutable time_t d_ttd{0}; // 8
@@ -180,8 +185,26 @@ private:
     bool d_auth; // 1
     mutable bool d_submitted{false}; // 1, whether this entry has been queued for refetch
     bool d_tooBig{false}; // 1
+    mutable uint32_t d_publishedGeneration{0}; // 4, shard generation in which a copy was published for lockless reads
   };
 
+  // An immutable copy of a cache entry that can be read without holding the shard lock. Readers
+  // only record that they used it, the LRU position of the original entry is updated in batches
+  // by sweepPublished().
+  struct PublishedEntry
+  {
+    explicit PublishedEntry(const CacheEntry& entry) :
+      d_entry(entry)
+    {
+    }
+
+    const CacheEntry d_entry;
+    mutable std::atomic<bool> d_touched{false};
+  };
+  using PublishedBucket = std::vector<std::shared_ptr<const PublishedEntry>>;
+  static constexpr size_t s_publishedBuckets = 16;
+  static constexpr size_t s_maxPublishedPerBucket = 32;
+
   bool replace(CacheEntry&& entry);
   // Using templates to avoid exposing protozero types in this header file
   template <typename T>
@@ -346,6 +369,29 @@ private:
       return d_entriesCount.load();
     }
 
+    // The published buckets are read without holding the lock, but only replaced while holding it
+    [[nodiscard]] std::shared_ptr<const PublishedBucket> getPublished(size_t index) const
+    {
+      return std::atomic_load(&d_published.at(index));
+    }
+
+    void setPublished(size_t index, std::shared_ptr<const PublishedBucket> bucket)
+    {
+      std::atomic_store(&d_published.at(index), std::move(bucket));
+    }
+
+    // Published entries are only valid as long as the generation they were published in is the
+    // current one, so every modification of the shard has to call invalidatePublished()
+    [[nodiscard]] uint32_t getGeneration() const
+    {
+      return d_generation.load();
+    }
+
+    void invalidatePublished()
+    {
+      ++d_generation;
+    }
+
     void incEntriesCount()
     {
       ++d_entriesCount;
@@ -364,6 +410,8 @@ private:
   private:
     LockGuarded<LockedContent> d_content;
     pdns::stat_t d_entriesCount{0};
+    std::array<std::shared_ptr<const PublishedBucket>, s_publishedBuckets> d_published;
+    std::atomic<uint32_t> d_generation{1};
   };
 
   vector<MapCombo> d_maps;
@@ -371,6 +419,11 @@ private:
   {
     return d_maps.at(qname.hash() % d_maps.size());
   }
+  [[nodiscard]] size_t getPublishedIndex(size_t hash) const
+  {
+    // the low bits of the hash select the shard
+    return (hash / d_maps.size()) % s_publishedBuckets;
+  }
 
   static time_t fakeTTD(OrderedTagIterator_t& entry, const DNSName& qname, QType qtype, time_t ret, time_t now, uint32_t origTTL, bool refresh);
 
@@ -378,7 +431,11 @@ private:
   static Entries getEntries(MapCombo::LockedContent& map, const DNSName& qname, QType qtype, const OptTag& rtag);
   static cache_t::const_iterator getEntryUsingECSIndex(MapCombo::LockedContent& map, time_t now, const DNSName& qname, QType qtype, bool requireAuth, const ComboAddress& who, bool serveStale);
 
+  static void copyEntry(const CacheEntry& entry, const DNSName& qname, uint32_t& origTTL, vector<DNSRecord>* res, SigRecs* signatures, AuthRecs* authorityRecs, bool* variable, boost::optional<vState>& state, bool* wasAuth, DNSName* fromAuthZone, ComboAddress* fromAuthIP);
   static time_t handleHit(time_t now, MapCombo::LockedContent& content, OrderedTagIterator_t& entry, const DNSName& qname, uint32_t& origTTL, vector<DNSRecord>* res, SigRecs* signatures, AuthRecs* authorityRecs, bool* variable, boost::optional<vState>& state, bool* wasAuth, DNSName* authZone, ComboAddress* fromAuthIP);
+  bool getPublished(MapCombo& shard, size_t hash, time_t now, const DNSName& qname, QType qtype, bool requireAuth, time_t& ttl, vector<DNSRecord>* res, SigRecs* signatures, AuthRecs* authorityRecs, vState* state, bool* wasAuth, DNSName* fromAuthZone, ComboAddress* fromAuthIP) const;
+  void publish(MapCombo& shard, const MapCombo::LockedContent& content, size_t hash, const CacheEntry& entry) const;
+  void sweepPublished();
   static void updateStaleEntry(time_t now, OrderedTagIterator_t& entry);
   static void handleServeStaleBookkeeping(time_t, bool, OrderedTagIterator_t&);
 };
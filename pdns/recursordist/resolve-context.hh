@@ -29,6 +29,7 @@
 #include <functional>
 
 #include "dnsname.hh"
+#include "iputils.hh"
 
 struct ResolveContext
 {
@@ -44,6 +45,11 @@ struct ResolveContext
 
   boost::optional<const boost::uuids::uuid&> d_initialRequestId;
   DNSName d_nsName;
+  // If set, a UDP query not answered within d_hedgeAfterMsec is also sent to d_hedgeAddress, and the first usable answer wins
+  boost::optional<ComboAddress> d_hedgeAddress;
+  unsigned int d_hedgeAfterMsec{0};
+  // If set, how long to wait for a UDP answer instead of the default, see SyncRes::getAdaptiveTimeoutMsec()
+  unsigned int d_timeoutMsec{0};
 #ifdef HAVE_FSTRM
   boost::optional<const DNSName&> d_auth;
 #endif
@@ -0,0 +1,84 @@
+/*
+ * This file is part of PowerDNS or dnsdist.
+ * Copyright -- PowerDNS.COM B.V. and its contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of version 2 of the GNU General Public License as
+ * published by the Free Software Foundation.
+ *
+ * In addition, for the avoidance of any doubt, permission is granted to
+ * link this program with OpenSSL and to (re)distribute the binaries
+ * produced as the result of such linking.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/* Measures the cost of looking up a query name against name-based RPZ triggers,
+   for a varying number of zones and entries per zone. Not built by default, run
+   'make rpz-speedtest' (or enable unit tests with meson) to get it. */
+
+#include "config.h"
+
+#include <iostream>
+#include <boost/format.hpp>
+
+#include "filterpo.hh"
+#include "misc.hh"
+
+int main(int argc, char** argv)
+{
+  size_t maxEntries = 1000000;
+  if (argc > 1) {
+    maxEntries = std::stoul(argv[1]);
+  }
+
+  const std::unordered_map<std::string, bool> noDiscarded;
+  const size_t queriesCount = 10000;
+  const size_t rounds = 100;
+  std::vector<DNSName> queries;
+  queries.reserve(queriesCount);
+  for (size_t idx = 0; idx < queriesCount; idx++) {
+    queries.emplace_back("www.query-" + std::to_string(idx) + ".example.com.");
+  }
+
+  for (size_t zonesCount : {1, 4, 15}) {
+    for (size_t entriesCount : {1000, 100000, 1000000}) {
+      if (entriesCount > maxEntries) {
+        continue;
+      }
+      DNSFilterEngine dfe;
+      for (size_t zoneIdx = 0; zoneIdx < zonesCount; zoneIdx++) {
+        auto zone = std::make_shared<DNSFilterEngine::Zone>();
+        zone->setName("Bench policy " + std::to_string(zoneIdx));
+        zone->reserve(entriesCount);
+        for (size_t idx = 0; idx < entriesCount; idx++) {
+          /* one in ten queries should get a hit */
+          const std::string name = "query-" + std::to_string(idx * 10 + zoneIdx) + ".example.com.";
+          zone->addQNameTrigger(DNSName(idx % 2 == 0 ? name : "*." + name), DNSFilterEngine::Policy(DNSFilterEngine::PolicyKind::Drop, DNSFilterEngine::PolicyType::QName));
+        }
+        dfe.addZone(zone);
+      }
+
+      size_t hits = 0;
+      CPUTime cpuTime;
+      cpuTime.start();
+      for (size_t round = 0; round < rounds; round++) {
+        for (const auto& qname : queries) {
+          if (dfe.getQueryPolicy(qname, noDiscarded, DNSFilterEngine::maximumPriority).d_type != DNSFilterEngine::PolicyType::None) {
+            ++hits;
+          }
+        }
+      }
+      auto elapsed = cpuTime.ndiff();
+      cout << (boost::format("%2d zones of %7d entries: %6.1f ns/query, %d hits") % zonesCount % entriesCount % (static_cast<double>(elapsed) / static_cast<double>(queriesCount * rounds)) % hits) << endl;
+    }
+  }
+  return 0;
+}
@@ -604,7 +604,10 @@ static bool RPZTrackerIteration(RPZTrackerParams& params, const DNSName& zoneNam
            logger->info(Logr::Info, "This policy is no more, stopping the existing RPZ update thread"));
       return false;
     }
-    /* we need to make a _full copy_ of the zone we are going to work on */
+    /* we need to make a copy of the zone we are going to work on. This is cheap, the
+       copy shares the policies with the existing zone until they are modified */
+    DTime applyTime;
+    applyTime.set();
     std::shared_ptr<DNSFilterEngine::Zone> newZone = std::make_shared<DNSFilterEngine::Zone>(*oldZone);
     /* initialize the current serial to the last one */
     std::shared_ptr<const SOARecordContent> currentSR = params.zoneXFRParams.soaRecordContent;
@@ -671,8 +674,9 @@ static bool RPZTrackerIteration(RPZTrackerParams& params, const DNSName& zoneNam
       newZone->setSOA(std::move(dnsRecord));
       params.zoneXFRParams.soaRecordContent = std::move(currentSR);
     }
-    SLOG(g_log << Logger::Info << "Had " << totremove << " RPZ removal" << addS(totremove) << ", " << totadd << " addition" << addS(totadd) << " for " << zoneName << " New serial: " << params.soaRecordContent->d_st.serial << endl,
-         logger->info(Logr::Info, "RPZ mutations", "removals", Logging::Loggable(totremove), "additions", Logging::Loggable(totadd), "newserial", Logging::Loggable(params.zoneXFRParams.soaRecordContent->d_st.serial)));
+    auto applyMsec = applyTime.udiff() / 1000;
+    SLOG(g_log << Logger::Info << "Had " << totremove << " RPZ removal" << addS(totremove) << ", " << totadd << " addition" << addS(totadd) << " for " << zoneName << " New serial: " << params.soaRecordContent->d_st.serial << ", applied to " << newZone->size() << " entries in " << applyMsec << " ms" << endl,
+         logger->info(Logr::Info, "RPZ mutations", "removals", Logging::Loggable(totremove), "additions", Logging::Loggable(totadd), "newserial", Logging::Loggable(params.zoneXFRParams.soaRecordContent->d_st.serial), "size", Logging::Loggable(newZone->size()), "msec", Logging::Loggable(applyMsec)));
     newZone->setSerial(params.zoneXFRParams.soaRecordContent->d_st.serial);
     newZone->setRefresh(params.zoneXFRParams.soaRecordContent->d_st.refresh);
     setRPZZoneNewState(polName, params.zoneXFRParams.soaRecordContent->d_st.serial, newZone->size(), false, fullUpdate);
@@ -714,7 +718,7 @@ void RPZIXFRTracker(RPZTrackerParams params, uint64_t configGeneration)
   auto logger = g_slog->withName("rpz");
   ZoneXFR::ZoneWaiter waiter(std::this_thread::get_id());
 
-  /* we can _never_ modify this zone directly, we need to do a full copy then replace the existing zone */
+  /* we can _never_ modify this zone directly, we need to make a copy then replace the existing zone */
   std::shared_ptr<DNSFilterEngine::Zone> oldZone = g_luaconfs.getLocal()->dfe.getZone(params.zoneXFRParams.zoneIdx);
   if (!oldZone) {
     SLOG(g_log << Logger::Error << "Unable to retrieve RPZ zone with index " << params.zoneIdx << " from the configuration, exiting" << endl,
@@ -22,6 +22,9 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <vector>
 #include <cmath>
 #include <random>
@@ -213,4 +216,276 @@ private:
   std::mt19937 d_gen;
   std::uniform_int_distribution<> d_dis;
 };
+
+// Same algorithm as stableBF, but safe to use from several threads at the same time without
+// locking: cells are updated using atomic operations on 64-bit words, and each thread uses its own
+// random generator to choose the cells to decrement. Concurrent updates can race with each other,
+// which only has the same effect as doing them in a different order.
+//
+// By default the k cells of an item are all taken from the same 512-bit block, so a lookup only
+// touches one cache line. This changes which cells are used for an item compared to stableBF, so
+// the layout is stored after the cells in the snapshot, a trailer that older versions ignore.
+// Snapshots without it, written by stableBF, are restored with the stableBF layout.
+class concurrentStableBF
+{
+public:
+  enum class Layout : uint8_t
+  {
+    Spread = 0, // the cells of an item are spread over the whole filter, as in stableBF
+    Blocked = 1, // the cells of an item are in the same cache line
+  };
+
+  concurrentStableBF(float fp_rate, uint32_t num_cells, uint8_t pArg) :
+    d_blocks(blocksNeeded(num_cells)),
+    d_k(optimalK(fp_rate)),
+    d_num_cells(num_cells),
+    d_p(pArg),
+    d_layout(num_cells >= s_blockBits ? Layout::Blocked : Layout::Spread)
+  {
+  }
+
+  void add(const std::string& data)
+  {
+    decrement();
+    set(hash(data));
+  }
+
+  [[nodiscard]] bool test(const std::string& data) const
+  {
+    return test(hash(data));
+  }
+
+  bool testAndAdd(const std::string& data)
+  {
+    auto hashes = hash(data);
+    bool retval = test(hashes);
+    decrement();
+    set(hashes);
+    return retval;
+  }
+
+  [[nodiscard]] Layout getLayout() const
+  {
+    return d_layout;
+  }
+
+  // Can run concurrently with updates, which may or may not be part of the dump
+  void dump(std::ostream& ostr) const
+  {
+    ostr.write(charPtr(&d_k), sizeof(d_k));
+    uint32_t nint = htonl(d_num_cells);
+    ostr.write(charPtr(&nint), sizeof(nint));
+    ostr.write(charPtr(&d_p), sizeof(d_p));
+    // Same representation as boost::to_string(dynamic_bitset): the highest cell comes first
+    std::string temp_str(d_num_cells, '0');
+    for (uint32_t cell = 0; cell < d_num_cells; ++cell) {
+      if ((word(cell).load(std::memory_order_relaxed) & bit(cell)) != 0) {
+        temp_str.at(d_num_cells - 1 - cell) = '1';
+      }
+    }
+    uint32_t bitstr_length = htonl(static_cast<uint32_t>(temp_str.length()));
+    ostr.write(charPtr(&bitstr_length), sizeof(bitstr_length));
+    ostr.write(charPtr(temp_str.c_str()), static_cast<std::streamsize>(temp_str.length()));
+    ostr.write(charPtr(&d_layout), sizeof(d_layout));
+    if (ostr.fail()) {
+      throw std::runtime_error("SBF: Failed to dump");
+    }
+  }
+
+  // Not thread-safe, the filter cannot be used by other threads while it is being restored
+  void restore(std::istream& istr)
+  {
+    uint8_t kValue{};
+    istr.read(charPtr(&kValue), sizeof(kValue));
+    if (istr.fail()) {
+      throw std::runtime_error("SBF: read failed (file too short?)");
+    }
+    uint32_t num_cells{};
+    istr.read(charPtr(&num_cells), sizeof(num_cells));
+    if (istr.fail()) {
+      throw std::runtime_error("SBF: read failed (file too short?)");
+    }
+    num_cells = ntohl(num_cells);
+    uint8_t pValue{};
+    istr.read(charPtr(&pValue), sizeof(pValue));
+    if (istr.fail()) {
+      throw std::runtime_error("SBF: read failed (file too short?)");
+    }
+    uint32_t bitstr_len{};
+    istr.read(charPtr(&bitstr_len), sizeof(bitstr_len));
+    if (istr.fail()) {
+      throw std::runtime_error("SBF: read failed (file too short?)");
+    }
+    bitstr_len = ntohl(bitstr_len);
+    if (bitstr_len > 2 * 64 * 1024 * 1024U) { // twice the current size
+      throw std::runtime_error("SBF: read failed (bitstr_len too big)");
+    }
+    if (bitstr_len != num_cells || num_cells == 0) {
+      throw std::runtime_error("SBF: read failed (inconsistent number of cells)");
+    }
+    auto bitcstr = NoInitVector<char>(bitstr_len);
+    istr.read(bitcstr.data(), bitstr_len);
+    if (istr.fail()) {
+      throw std::runtime_error("SBF: read failed (file too short?)");
+    }
+    // the layout is absent from snapshots written by stableBF
+    auto layout = Layout::Spread;
+    uint8_t layoutValue{};
+    istr.read(charPtr(&layoutValue), sizeof(layoutValue));
+    if (istr.gcount() == sizeof(layoutValue)) {
+      if (layoutValue > static_cast<uint8_t>(Layout::Blocked) || (layoutValue == static_cast<uint8_t>(Layout::Blocked) && num_cells < s_blockBits)) {
+        throw std::runtime_error("SBF: read failed (unknown layout)");
+      }
+      layout = static_cast<Layout>(layoutValue);
+    }
+
+    std::vector<Block> blocks(blocksNeeded(num_cells));
+    for (uint32_t cell = 0; cell < num_cells; ++cell) {
+      const char value = bitcstr.at(num_cells - 1 - cell);
+      if (value == '1') {
+        blocks.at(cell / s_blockBits).d_words.at((cell % s_blockBits) / 64).fetch_or(bit(cell), std::memory_order_relaxed);
+      }
+      else if (value != '0') {
+        throw std::runtime_error("SBF: read failed (invalid cell value)");
+      }
+    }
+
+    d_blocks.swap(blocks);
+    d_k = kValue;
+    d_num_cells = num_cells;
+    d_p = pValue;
+    d_layout = layout;
+  }
+
+private:
+  static constexpr uint32_t s_blockBits = 512;
+
+  struct alignas(64) Block
+  {
+    std::array<std::atomic<uint64_t>, s_blockBits / 64> d_words{};
+  };
+
+  struct Hashes
+  {
+    uint32_t hash1;
+    uint32_t hash2;
+  };
+
+  static const char* charPtr(const void* ptr)
+  {
+    return static_cast<const char*>(ptr);
+  }
+
+  static char* charPtr(void* ptr)
+  {
+    return static_cast<char*>(ptr);
+  }
+
+  static unsigned int optimalK(float fp_rate)
+  {
+    return std::ceil(std::log2(1.0 / fp_rate));
+  }
+
+  static size_t blocksNeeded(uint32_t num_cells)
+  {
+    return (static_cast<size_t>(num_cells) + s_blockBits - 1) / s_blockBits;
+  }
+
+  static uint64_t bit(uint32_t cell)
+  {
+    return uint64_t(1) << (cell % 64);
+  }
+
+  [[nodiscard]] const std::atomic<uint64_t>& word(uint32_t cell) const
+  {
+    return d_blocks[cell / s_blockBits].d_words[(cell % s_blockBits) / 64];
+  }
+
+  [[nodiscard]] std::atomic<uint64_t>& word(uint32_t cell)
+  {
+    return d_blocks[cell / s_blockBits].d_words[(cell % s_blockBits) / 64];
+  }
+
+  // The i-th cell of an item
+  [[nodiscard]] uint32_t cell(const Hashes& hashes, uint32_t index) const
+  {
+    if (d_layout == Layout::Spread) {
+      return static_cast<uint32_t>(hashes.hash1 + index * hashes.hash2) % d_num_cells;
+    }
+    // any partial block at the end is not used
+    const uint32_t block = hashes.hash1 % (d_num_cells / s_blockBits);
+    // an odd step visits every cell of the block before coming back to the first one
+    const uint32_t step = (hashes.hash2 >> 9) | 1;
+    return block * s_blockBits + (hashes.hash2 + index * step) % s_blockBits;
+  }
+
+  [[nodiscard]] bool test(const Hashes& hashes) const
+  {
+    for (uint32_t index = 0; index < d_k; ++index) { // NOLINT(readability-use-anyofallof) not more clear IMO
+      const auto position = cell(hashes, index);
+      if ((word(position).load(std::memory_order_relaxed) & bit(position)) == 0) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  void set(const Hashes& hashes)
+  {
+    for (uint32_t index = 0; index < d_k; ++index) {
+      const auto position = cell(hashes, index);
+      auto& cells = word(position);
+      // avoid dirtying the cache line when the cell is already set, which is the common case
+      if ((cells.load(std::memory_order_relaxed) & bit(position)) == 0) {
+        cells.fetch_or(bit(position), std::memory_order_relaxed);
+      }
+    }
+  }
+
+  static std::mt19937& generator()
+  {
+    thread_local std::mt19937 gen(std::random_device{}());
+    return gen;
+  }
+
+  void decrement()
+  {
+    // Choose a random cell then decrement the next p-1, see stableBF::decrement(), clearing the
+    // cells of the same word at once
+    std::uniform_int_distribution<uint32_t> dis(0, d_num_cells - 1);
+    uint32_t position = dis(generator());
+    uint32_t remaining = d_p;
+    while (remaining > 0) {
+      const uint32_t count = std::min({remaining, 64 - (position % 64), d_num_cells - position});
+      const uint64_t mask = (count == 64 ? ~uint64_t(0) : ((uint64_t(1) << count) - 1)) << (position % 64);
+      word(position).fetch_and(~mask, std::memory_order_relaxed);
+      remaining -= count;
+      position = (position + count) % d_num_cells;
+    }
+  }
+
+  [[nodiscard]] Hashes hash(const std::string& data) const
+  {
+    Hashes hashes{};
+    // MurmurHash3 assumes the data is uint32_t aligned, so fixup if needed
+    // It does handle string lengths that are not a multiple of sizeof(uint32_t) correctly
+    if (reinterpret_cast<uintptr_t>(data.data()) % sizeof(uint32_t) != 0) { // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+      NoInitVector<uint32_t> vec((data.length() / sizeof(uint32_t)) + 1);
+      memcpy(vec.data(), data.data(), data.length());
+      MurmurHash3_x86_32(vec.data(), static_cast<int>(data.length()), 1, &hashes.hash1);
+      MurmurHash3_x86_32(vec.data(), static_cast<int>(data.length()), 2, &hashes.hash2);
+    }
+    else {
+      MurmurHash3_x86_32(data.data(), static_cast<int>(data.length()), 1, &hashes.hash1);
+      MurmurHash3_x86_32(data.data(), static_cast<int>(data.length()), 2, &hashes.hash2);
+    }
+    return hashes;
+  }
+
+  std::vector<Block> d_blocks;
+  uint8_t d_k;
+  uint32_t d_num_cells;
+  uint8_t d_p;
+  Layout d_layout;
+};
 }
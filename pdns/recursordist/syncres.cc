@@ -352,6 +352,10 @@ unsigned int SyncRes::s_maxcachettl;
 unsigned int SyncRes::s_maxqperq;
 unsigned int SyncRes::s_maxnsperresolve;
 unsigned int SyncRes::s_maxnsaddressqperq;
+unsigned int SyncRes::s_maxhedgedqperq;
+unsigned int SyncRes::s_gluelessnsprefetch;
+unsigned int SyncRes::s_minadaptivetimeout;
+unsigned int SyncRes::s_maxadaptivetimeout;
 unsigned int SyncRes::s_maxtotusec;
 unsigned int SyncRes::s_maxdepth;
 unsigned int SyncRes::s_minimumTTL;
@@ -1134,6 +1138,30 @@ float SyncRes::getNSSpeed(const DNSName& server, const ComboAddress& address)
   return lock->find_or_enter(server).d_collection[address].peek();
 }
 
+// We hedge after twice the usual response time of a server, within sane bounds
+unsigned int SyncRes::getHedgeDelayMsec(float speedUsec)
+{
+  const unsigned int minDelay = 20;
+  const unsigned int maxDelay = std::max(minDelay, g_networkTimeoutMsec / 2);
+  auto delay = std::min(2 * speedUsec / 1000, static_cast<float>(maxDelay));
+  return std::max(static_cast<unsigned int>(delay), minDelay);
+}
+
+// The time to wait for an answer from a server, based on its usual response time and the variation of it, within the
+// configured bounds. 0 means the default timeout, when adaptive timeouts are disabled or we know nothing about the server.
+unsigned int SyncRes::getAdaptiveTimeoutMsec(const DNSName& server, const ComboAddress& address)
+{
+  if (s_maxadaptivetimeout == 0) {
+    return 0;
+  }
+  auto rto = s_nsSpeeds.lock()->rto(server, address);
+  if (rto <= 0) {
+    return 0;
+  }
+  auto msec = std::min(rto / 1000, static_cast<float>(s_maxadaptivetimeout));
+  return std::max(static_cast<unsigned int>(msec), s_minadaptivetimeout);
+}
+
 uint64_t SyncRes::doDumpNSSpeeds(int fileDesc)
 {
   int newfd = dup(fileDesc);
@@ -1437,7 +1465,7 @@ uint64_t SyncRes::doDumpDoTProbeMap(int fileDesc)
    For now this means we can't be clever, but will turn off DNSSEC if you reply with FormError or gibberish.
 */
 
-LWResult::Result SyncRes::asyncresolveWrapper(const ComboAddress& address, bool ednsMANDATORY, const DNSName& domain, [[maybe_unused]] const DNSName& auth, int type, bool doTCP, bool sendRDQuery, struct timeval* now, boost::optional<Netmask>& srcmask, LWResult* res, bool* chained, const DNSName& nsName) const
+LWResult::Result SyncRes::asyncresolveWrapper(const ComboAddress& address, bool ednsMANDATORY, const DNSName& domain, [[maybe_unused]] const DNSName& auth, int type, bool doTCP, bool sendRDQuery, struct timeval* now, boost::optional<Netmask>& srcmask, LWResult* res, bool* chained, const DNSName& nsName, const HedgeTarget* hedge) const
 {
   /* what is your QUEST?
      the goal is to get as many remotes as possible on the best level of EDNS support
@@ -1477,6 +1505,14 @@ LWResult::Result SyncRes::asyncresolveWrapper(const ComboAddress& address, bool
 #ifdef HAVE_FSTRM
   ctx.d_auth = auth;
 #endif
+  // answers with ECS are specific to the server that sent them, so we do not hedge those
+  if (hedge != nullptr && !doTCP && !srcmask) {
+    ctx.d_hedgeAddress = hedge->d_address;
+    ctx.d_hedgeAfterMsec = hedge->d_afterMsec;
+  }
+  if (!doTCP) {
+    ctx.d_timeoutMsec = getAdaptiveTimeoutMsec(nsName.empty() ? DNSName(address.toStringWithPort()) : nsName, address);
+  }
 
   LWResult::Result ret{};
 
@@ -1510,6 +1546,10 @@ LWResult::Result SyncRes::asyncresolveWrapper(const ComboAddress& address, bool
       break;
     }
 
+    if (res->d_hedgeWon) { // the answer came from another server, it tells us nothing about this one
+      break;
+    }
+
     if (EDNSLevel == 1) {
       // We sent out with EDNS
       // ret is LWResult::Result::Success
@@ -3514,6 +3554,117 @@ bool SyncRes::throttledOrBlocked(const std::string& prefix, const ComboAddress&
   return false;
 }
 
+/* If hedging is enabled and the budget for this resolution is not exhausted, pick the address of the next nameserver
+   in speed order to send a copy of the query to if tns is slow to answer. We only use addresses we already have in
+   the cache, and which the query could be sent to right away. */
+boost::optional<SyncRes::HedgeTarget> SyncRes::getHedgeTarget(const std::string& prefix, const DNSName& qname, const QType qtype, const vector<std::pair<DNSName, float>>& rnameservers, vector<std::pair<DNSName, float>>::const_iterator tns, const DNSFilterEngine& dfe)
+{
+  if (s_maxhedgedqperq == 0 || d_hedgedqueries >= s_maxhedgedqperq || tns->first.empty() || tns->second <= 0) {
+    return boost::none;
+  }
+  auto next = tns + 1;
+  if (next == rnameservers.cend() || next->first.empty() || next->first == qname || doDoTtoAuth(next->first)) {
+    return boost::none;
+  }
+
+  vector<DNSRecord> cset;
+  vector<ComboAddress> addresses;
+  if (s_doIPv4 && g_recCache->get(d_now.tv_sec, next->first, QType::A, MemRecursorCache::None, &cset, d_cacheRemote, d_routingTag) > 0) {
+    collectAddresses<ARecordContent>(cset, addresses);
+  }
+  if (s_doIPv6 && g_recCache->get(d_now.tv_sec, next->first, QType::AAAA, MemRecursorCache::None, &cset, d_cacheRemote, d_routingTag) > 0) {
+    collectAddresses<AAAARecordContent>(cset, addresses);
+  }
+
+  for (const auto& address : addresses) {
+    if (isThrottled(d_now.tv_sec, address) || isThrottled(d_now.tv_sec, address, qname, qtype) || (s_dontQuery && s_dontQuery->match(&address))) {
+      continue;
+    }
+    if (DNSFilterEngine::Policy policy; d_wantsRPZ && dfe.getProcessingPolicy(address, d_discardedPolicies, policy)) {
+      continue;
+    }
+    HedgeTarget hedge{next->first, address, getHedgeDelayMsec(tns->second)};
+    LOG(prefix << qname << ": Will hedge to " << next->first << " (" << address.toString() << ") after " << hedge.d_afterMsec << "ms" << endl);
+    return hedge;
+  }
+  return boost::none;
+}
+
+// Accounts for the hedged query sent along with the last UDP query, if any. answeredBy is updated if the answer came from the hedge target
+void SyncRes::accountHedge(const std::string& prefix, const DNSName& qname, const LWResult& lwr, const HedgeTarget& hedge, ComboAddress& answeredBy)
+{
+  if (!lwr.d_hedged) {
+    return;
+  }
+  d_hedgedqueries++;
+  d_outqueries++;
+  t_Counters.at(rec::Counter::outqueries)++;
+  if (lwr.d_hedgeWon) {
+    LOG(prefix << qname << ": Answer came from hedged query to " << hedge.d_nsName << " (" << hedge.d_address.toString() << ")" << endl);
+    answeredBy = hedge.d_address;
+    // the hedged query left d_afterMsec after the first one
+    auto usec = static_cast<int>(lwr.d_usec) - static_cast<int>(hedge.d_afterMsec * 1000);
+    s_nsSpeeds.lock()->find_or_enter(hedge.d_nsName, d_now).submit(hedge.d_address, std::max(usec, 1), d_now);
+  }
+}
+
+bool SyncRes::nsAddressesInCache(const DNSName& nsName)
+{
+  return (s_doIPv4 && g_recCache->get(d_now.tv_sec, nsName, QType::A, MemRecursorCache::None, nullptr, d_cacheRemote, d_routingTag) > 0) || (s_doIPv6 && g_recCache->get(d_now.tv_sec, nsName, QType::AAAA, MemRecursorCache::None, nullptr, d_cacheRemote, d_routingTag) > 0);
+}
+
+/* If the first nameserver we are going to try has no address in the cache, we are about to resolve it ourselves.
+   Push background tasks resolving the addresses of (at most s_gluelessnsprefetch of) the other glueless nameservers,
+   so other threads can resolve them in the meantime should the first one fail. Returns the names pushed. */
+std::vector<DNSName> SyncRes::prefetchGluelessNS(const std::string& prefix, const DNSName& qname, const vector<std::pair<DNSName, float>>& rnameservers)
+{
+  std::vector<DNSName> prefetched;
+  if (d_cacheonly || rnameservers.size() < 2 || rnameservers.front().first.empty() || rnameservers.front().first == qname || nsAddressesInCache(rnameservers.front().first)) {
+    return prefetched;
+  }
+  for (auto tns = rnameservers.cbegin() + 1; tns != rnameservers.cend() && prefetched.size() < s_gluelessnsprefetch; ++tns) {
+    if (tns->first.empty() || tns->first == qname || nsAddressesInCache(tns->first)) {
+      continue;
+    }
+    if (s_nonresolvingnsmaxfails > 0 && s_nonresolving.lock()->value(tns->first) >= s_nonresolvingnsmaxfails) {
+      continue;
+    }
+    if (pushResolveTask(tns->first, s_doIPv4 ? QType::A : QType::AAAA, d_now.tv_sec, d_now.tv_sec + 60, false)) {
+      LOG(prefix << qname << ": Prefetching addresses of glueless NS " << tns->first << endl);
+      t_Counters.at(rec::Counter::gluelessNSPrefetches)++;
+    }
+    // A task not pushed because the same one was pushed recently may have completed by now
+    prefetched.push_back(tns->first);
+  }
+  return prefetched;
+}
+
+/* If tns has no address in the cache but one of the prefetched nameservers further down the list has by now, swap
+   them so we continue with the one we can query right away instead of resolving tns ourselves. */
+void SyncRes::usePrefetchedNS(const std::string& prefix, const DNSName& qname, vector<std::pair<DNSName, float>>& rnameservers, vector<std::pair<DNSName, float>>::const_iterator tns, const std::vector<DNSName>& prefetched)
+{
+  auto wasPrefetched = [&prefetched](const DNSName& name) {
+    return std::find(prefetched.cbegin(), prefetched.cend(), name) != prefetched.cend();
+  };
+  if (tns->first.empty() || tns->first == qname) {
+    return;
+  }
+  if (nsAddressesInCache(tns->first)) {
+    if (wasPrefetched(tns->first)) {
+      t_Counters.at(rec::Counter::gluelessNSPrefetchHits)++;
+    }
+    return;
+  }
+  for (auto iter = tns + 1; iter != rnameservers.cend(); ++iter) {
+    if (wasPrefetched(iter->first) && nsAddressesInCache(iter->first)) {
+      LOG(prefix << qname << ": Addresses of prefetched NS " << iter->first << " are available, trying it before " << tns->first << endl);
+      std::iter_swap(rnameservers.begin() + (tns - rnameservers.cbegin()), rnameservers.begin() + (iter - rnameservers.cbegin()));
+      t_Counters.at(rec::Counter::gluelessNSPrefetchHits)++;
+      return;
+    }
+  }
+}
+
 bool SyncRes::validationEnabled()
 {
   return g_dnssecmode != DNSSECMode::Off && g_dnssecmode != DNSSECMode::ProcessNoValidate;
@@ -5440,7 +5591,7 @@ void SyncRes::checkTotalTime(const DNSName& qname, QType qtype, boost::optional<
   }
 }
 
-bool SyncRes::doResolveAtThisIP(const std::string& prefix, const DNSName& qname, const QType qtype, LWResult& lwr, boost::optional<Netmask>& ednsmask, const DNSName& auth, bool const sendRDQuery, const bool wasForwarded, const DNSName& nsName, const ComboAddress& remoteIP, bool doTCP, bool doDoT, bool& truncated, bool& spoofed, boost::optional<EDNSExtendedError>& extendedError, bool dontThrottle)
+bool SyncRes::doResolveAtThisIP(const std::string& prefix, const DNSName& qname, const QType qtype, LWResult& lwr, boost::optional<Netmask>& ednsmask, const DNSName& auth, bool const sendRDQuery, const bool wasForwarded, const DNSName& nsName, const ComboAddress& remoteIP, bool doTCP, bool doDoT, bool& truncated, bool& spoofed, boost::optional<EDNSExtendedError>& extendedError, bool dontThrottle, const HedgeTarget* hedge)
 {
   checkTotalTime(qname, qtype, extendedError);
 
@@ -5460,7 +5611,7 @@ bool SyncRes::doResolveAtThisIP(const std::string& prefix, const DNSName& qname,
     auto match = d_eventTrace.add(RecEventTrace::AuthRequest, qname.toLogString() + '/' + qtype.toString(), true, 0);
     updateQueryCounts(prefix, qname, remoteIP, doTCP, doDoT);
     resolveret = asyncresolveWrapper(remoteIP, d_doDNSSEC, qname, auth, qtype.getCode(),
-                                     doTCP, sendRDQuery, &d_now, ednsmask, &lwr, &chained, nsName); // <- we go out on the wire!
+                                     doTCP, sendRDQuery, &d_now, ednsmask, &lwr, &chained, nsName, hedge); // <- we go out on the wire!
     d_eventTrace.add(RecEventTrace::AuthRequest, static_cast<int64_t>(lwr.d_rcode), false, match);
     ednsStats(ednsmask, qname, prefix);
     if (resolveret == LWResult::Result::ECSMissing) {
@@ -5469,7 +5620,7 @@ bool SyncRes::doResolveAtThisIP(const std::string& prefix, const DNSName& qname,
       updateQueryCounts(prefix, qname, remoteIP, doTCP, doDoT);
       match = d_eventTrace.add(RecEventTrace::AuthRequest, qname.toLogString() + '/' + qtype.toString(), true, 0);
       resolveret = asyncresolveWrapper(remoteIP, d_doDNSSEC, qname, auth, qtype.getCode(),
-                                       doTCP, sendRDQuery, &d_now, ednsmask, &lwr, &chained, nsName); // <- we go out on the wire!
+                                       doTCP, sendRDQuery, &d_now, ednsmask, &lwr, &chained, nsName, hedge); // <- we go out on the wire!
       d_eventTrace.add(RecEventTrace::AuthRequest, static_cast<int64_t>(lwr.d_rcode), false, match);
     }
   }
@@ -5526,6 +5677,10 @@ bool SyncRes::doResolveAtThisIP(const std::string& prefix, const DNSName& qname,
       // Use the actual time if we saw a timeout
       if (resolveret == LWResult::Result::Timeout) {
         responseUsec = lwr.d_usec;
+        // back off after an adaptive timeout, so the next one is longer
+        if (s_maxadaptivetimeout > 0) {
+          responseUsec = std::min(2 * responseUsec, g_networkTimeoutMsec * 1000);
+        }
       }
 
       s_nsSpeeds.lock()->find_or_enter(nsName.empty() ? DNSName(remoteIP.toStringWithPort()) : nsName, d_now).submit(remoteIP, static_cast<int>(responseUsec), d_now);
@@ -5855,6 +6010,11 @@ int SyncRes::doResolveAt(NsSet& nameservers, DNSName auth, bool flawedNSSet, con
       nsLimit = std::max(5, newLimit);
     }
 
+    std::vector<DNSName> prefetchedNS;
+    if (s_gluelessnsprefetch > 0) {
+      prefetchedNS = prefetchGluelessNS(prefix, qname, rnameservers);
+    }
+
     for (auto tns = rnameservers.cbegin();; ++tns) {
       if (addressQueriesForNS >= nsLimit) {
         throw ImmediateServFailException(std::to_string(nsLimit) + " (adjusted max-ns-address-qperq) or more queries with empty results for NS addresses sent resolving " + qname.toLogString());
@@ -5873,6 +6033,10 @@ int SyncRes::doResolveAt(NsSet& nameservers, DNSName auth, bool flawedNSSet, con
         return -1;
       }
 
+      if (!prefetchedNS.empty()) {
+        usePrefetchedNS(prefix, qname, rnameservers, tns, prefetchedNS);
+      }
+
       bool cacheOnly = false;
       // this line needs to identify the 'self-resolving' behaviour
       if (qname == tns->first && (qtype.getCode() == QType::A || qtype.getCode() == QType::AAAA)) {
@@ -5967,6 +6131,7 @@ int SyncRes::doResolveAt(NsSet& nameservers, DNSName auth, bool flawedNSSet, con
           bool spoofed = false;
           bool gotAnswer = false;
           bool doDoT = false;
+          ComboAddress answeredBy = *remoteIP;
 
           if (doDoTtoAuth(tns->first)) {
             remoteIP->setPort(853);
@@ -5981,8 +6146,15 @@ int SyncRes::doResolveAt(NsSet& nameservers, DNSName auth, bool flawedNSSet, con
             submitTryDotTask(*remoteIP, auth, tns->first, d_now.tv_sec);
           }
           if (!forceTCP) {
+            boost::optional<HedgeTarget> hedge;
+            if (!wasForwarded) {
+              hedge = getHedgeTarget(prefix, qname, qtype, rnameservers, tns, luaconfsLocal->dfe);
+            }
             gotAnswer = doResolveAtThisIP(prefix, qname, qtype, lwr, ednsmask, auth, sendRDQuery, wasForwarded,
-                                          tns->first, *remoteIP, false, false, truncated, spoofed, context.extendedError);
+                                          tns->first, *remoteIP, false, false, truncated, spoofed, context.extendedError, false, hedge.get_ptr());
+            if (hedge) {
+              accountHedge(prefix, qname, lwr, *hedge, answeredBy);
+            }
           }
           if (forceTCP || (spoofed || (gotAnswer && truncated))) {
             /* retry, over TCP this time */
@@ -6012,7 +6184,7 @@ int SyncRes::doResolveAt(NsSet& nameservers, DNSName auth, bool flawedNSSet, con
           s_nsSpeeds.lock()->find_or_enter(tns->first.empty() ? DNSName(remoteIP->toStringWithPort()) : tns->first, d_now).submit(*remoteIP, static_cast<int>(lwr.d_usec), d_now);
 
           /* we have received an answer, are we done ? */
-          bool done = processAnswer(depth, prefix, lwr, qname, qtype, auth, wasForwarded, ednsmask, sendRDQuery, nameservers, ret, luaconfsLocal->dfe, &gotNewServers, &rcode, context.state, *remoteIP);
+          bool done = processAnswer(depth, prefix, lwr, qname, qtype, auth, wasForwarded, ednsmask, sendRDQuery, nameservers, ret, luaconfsLocal->dfe, &gotNewServers, &rcode, context.state, answeredBy);
           if (done) {
             return rcode;
           }
@@ -6024,8 +6196,8 @@ int SyncRes::doResolveAt(NsSet& nameservers, DNSName auth, bool flawedNSSet, con
             break;
           }
           /* was lame */
-          if (!shouldNotThrottle(&tns->first, &*remoteIP)) {
-            doThrottle(d_now.tv_sec, *remoteIP, qname, qtype, 60, 100, Throttle::Reason::Lame);
+          if (!shouldNotThrottle(&tns->first, &answeredBy)) {
+            doThrottle(d_now.tv_sec, answeredBy, qname, qtype, 60, 100, Throttle::Reason::Lame);
           }
         }
 
@@ -6117,6 +6289,7 @@ void SyncRes::parseEDNSSubnetAllowlist(const std::string& alist)
       s_ednsdomains.add(DNSName(allow));
     }
   }
+  s_ednsdomains.compile();
 }
 
 void SyncRes::parseEDNSSubnetAddFor(const std::string& subnetlist)
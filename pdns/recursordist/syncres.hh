@@ -224,6 +224,8 @@ public:
   static void submitNSSpeed(const DNSName& server, const ComboAddress& address, int usec, const struct timeval& now);
   static void clearNSSpeeds();
   static float getNSSpeed(const DNSName& server, const ComboAddress& address);
+  static unsigned int getHedgeDelayMsec(float speedUsec);
+  static unsigned int getAdaptiveTimeoutMsec(const DNSName& server, const ComboAddress& address);
 
   struct EDNSStatus
   {
@@ -531,6 +533,10 @@ public:
   static unsigned int s_maxqperq;
   static unsigned int s_maxnsperresolve;
   static unsigned int s_maxnsaddressqperq;
+  static unsigned int s_maxhedgedqperq;
+  static unsigned int s_gluelessnsprefetch;
+  static unsigned int s_minadaptivetimeout;
+  static unsigned int s_maxadaptivetimeout;
   static unsigned int s_maxtotusec;
   static unsigned int s_maxdepth;
   static unsigned int s_maxnegttl;
@@ -597,6 +603,7 @@ public:
   unsigned int d_tcpoutqueries;
   unsigned int d_dotoutqueries;
   unsigned int d_throttledqueries;
+  unsigned int d_hedgedqueries{0};
   unsigned int d_timeouts;
   unsigned int d_unreachables;
   unsigned int d_totUsec;
@@ -638,6 +645,14 @@ private:
   void addAdditionals(QType qtype, const vector<DNSRecord>& start, vector<DNSRecord>& additionals, std::set<std::pair<DNSName, QType>>& uniqueCalls, std::set<std::tuple<DNSName, QType, QType>>& uniqueResults, unsigned int depth, unsigned int additionaldepth, bool& additionalsNotInCache);
   bool addAdditionals(QType qtype, vector<DNSRecord>& ret, unsigned int depth);
 
+  // Where to send a copy of a UDP query if the server it is sent to is slow to answer, see getHedgeTarget()
+  struct HedgeTarget
+  {
+    DNSName d_nsName;
+    ComboAddress d_address;
+    unsigned int d_afterMsec;
+  };
+
   void updateQueryCounts(const string& prefix, const DNSName& qname, const ComboAddress& address, bool doTCP, bool doDoT);
   static bool doDoTtoAuth(const DNSName& nameServer);
   int doResolveAt(NsSet& nameservers, DNSName auth, bool flawedNSSet, const DNSName& qname, QType qtype, vector<DNSRecord>& ret,
@@ -646,7 +661,7 @@ private:
   void ednsStats(boost::optional<Netmask>& ednsmask, const DNSName& qname, const string& prefix);
   void incTimeoutStats(const ComboAddress& remoteIP);
   void checkTotalTime(const DNSName& qname, QType qtype, boost::optional<EDNSExtendedError>& extendedError) const;
-  bool doResolveAtThisIP(const std::string& prefix, const DNSName& qname, QType qtype, LWResult& lwr, boost::optional<Netmask>& ednsmask, const DNSName& auth, bool sendRDQuery, bool wasForwarded, const DNSName& nsName, const ComboAddress& remoteIP, bool doTCP, bool doDoT, bool& truncated, bool& spoofed, boost::optional<EDNSExtendedError>& extendedError, bool dontThrottle = false);
+  bool doResolveAtThisIP(const std::string& prefix, const DNSName& qname, QType qtype, LWResult& lwr, boost::optional<Netmask>& ednsmask, const DNSName& auth, bool sendRDQuery, bool wasForwarded, const DNSName& nsName, const ComboAddress& remoteIP, bool doTCP, bool doDoT, bool& truncated, bool& spoofed, boost::optional<EDNSExtendedError>& extendedError, bool dontThrottle = false, const HedgeTarget* hedge = nullptr);
   bool processAnswer(unsigned int depth, const string& prefix, LWResult& lwr, const DNSName& qname, QType qtype, DNSName& auth, bool wasForwarded, const boost::optional<Netmask>& ednsmask, bool sendRDQuery, NsSet& nameservers, std::vector<DNSRecord>& ret, const DNSFilterEngine& dfe, bool* gotNewServers, int* rcode, vState& state, const ComboAddress& remoteIP);
 
   int doResolve(const DNSName& qname, QType qtype, vector<DNSRecord>& ret, unsigned int depth, set<GetBestNSAnswer>& beenthere, Context& context);
@@ -671,6 +686,11 @@ private:
   bool nameserverIPBlockedByRPZ(const DNSFilterEngine& dfe, const ComboAddress&);
   void checkMaxQperQ(const DNSName& qname) const;
   bool throttledOrBlocked(const std::string& prefix, const ComboAddress& remoteIP, const DNSName& qname, QType qtype, bool pierceDontQuery);
+  boost::optional<HedgeTarget> getHedgeTarget(const std::string& prefix, const DNSName& qname, QType qtype, const vector<std::pair<DNSName, float>>& rnameservers, vector<std::pair<DNSName, float>>::const_iterator tns, const DNSFilterEngine& dfe);
+  void accountHedge(const std::string& prefix, const DNSName& qname, const LWResult& lwr, const HedgeTarget& hedge, ComboAddress& answeredBy);
+  bool nsAddressesInCache(const DNSName& nsName);
+  std::vector<DNSName> prefetchGluelessNS(const std::string& prefix, const DNSName& qname, const vector<std::pair<DNSName, float>>& rnameservers);
+  void usePrefetchedNS(const std::string& prefix, const DNSName& qname, vector<std::pair<DNSName, float>>& rnameservers, vector<std::pair<DNSName, float>>::const_iterator tns, const std::vector<DNSName>& prefetched);
 
   vector<ComboAddress> retrieveAddressesForNS(const std::string& prefix, const DNSName& qname, vector<std::pair<DNSName, float>>::const_iterator& tns, unsigned int depth, set<GetBestNSAnswer>& beenthere, const vector<std::pair<DNSName, float>>& rnameservers, NsSet& nameservers, bool& sendRDQuery, bool& pierceDontQuery, bool& flawedNSSet, bool cacheOnly, unsigned int& nretrieveAddressesForNS);
 
@@ -685,7 +705,7 @@ private:
 
   bool doSpecialNamesResolve(const DNSName& qname, QType qtype, QClass qclass, vector<DNSRecord>& ret);
 
-  LWResult::Result asyncresolveWrapper(const ComboAddress& address, bool ednsMANDATORY, const DNSName& domain, const DNSName& auth, int type, bool doTCP, bool sendRDQuery, struct timeval* now, boost::optional<Netmask>& srcmask, LWResult* res, bool* chained, const DNSName& nsName) const;
+  LWResult::Result asyncresolveWrapper(const ComboAddress& address, bool ednsMANDATORY, const DNSName& domain, const DNSName& auth, int type, bool doTCP, bool sendRDQuery, struct timeval* now, boost::optional<Netmask>& srcmask, LWResult* res, bool* chained, const DNSName& nsName, const HedgeTarget* hedge = nullptr) const;
 
   boost::optional<Netmask> getEDNSSubnetMask(const DNSName& name, const ComboAddress& rem);
 
@@ -834,6 +834,112 @@ BOOST_AUTO_TEST_CASE(test_multiple_filter_policies_order)
   }
 }
 
+BOOST_AUTO_TEST_CASE(test_filter_policies_zone_copy)
+{
+  /* enough entries to be spread over several shards */
+  const size_t count = 5000;
+  auto zone = std::make_shared<DNSFilterEngine::Zone>();
+  zone->setName("Unit test policy 0");
+  for (size_t idx = 0; idx < count; idx++) {
+    zone->addQNameTrigger(DNSName("name" + std::to_string(idx) + ".example."), DNSFilterEngine::Policy(DNSFilterEngine::PolicyKind::Drop, DNSFilterEngine::PolicyType::QName));
+  }
+  zone->addClientTrigger(Netmask("192.0.2.0/24"), DNSFilterEngine::Policy(DNSFilterEngine::PolicyKind::Drop, DNSFilterEngine::PolicyType::ClientIP));
+  BOOST_CHECK_EQUAL(zone->size(), count + 1);
+
+  /* modifying a copy must not affect the original zone, which might be in use */
+  auto copy = std::make_shared<DNSFilterEngine::Zone>(*zone);
+  BOOST_CHECK(copy->rmQNameTrigger(DNSName("name42.example."), DNSFilterEngine::Policy(DNSFilterEngine::PolicyKind::Drop, DNSFilterEngine::PolicyType::QName)));
+  BOOST_CHECK(!copy->rmQNameTrigger(DNSName("name42.example."), DNSFilterEngine::Policy(DNSFilterEngine::PolicyKind::Drop, DNSFilterEngine::PolicyType::QName)));
+  copy->addQNameTrigger(DNSName("added.example."), DNSFilterEngine::Policy(DNSFilterEngine::PolicyKind::NXDOMAIN, DNSFilterEngine::PolicyType::QName));
+  BOOST_CHECK(copy->rmClientTrigger(Netmask("192.0.2.0/24"), DNSFilterEngine::Policy(DNSFilterEngine::PolicyKind::Drop, DNSFilterEngine::PolicyType::ClientIP)));
+  BOOST_CHECK_EQUAL(copy->size(), count);
+  BOOST_CHECK_EQUAL(zone->size(), count + 1);
+
+  DNSFilterEngine::Policy pol;
+  BOOST_CHECK(zone->findExactQNamePolicy(DNSName("name42.example."), pol));
+  BOOST_CHECK(!copy->findExactQNamePolicy(DNSName("name42.example."), pol));
+  BOOST_CHECK(!zone->findExactQNamePolicy(DNSName("added.example."), pol));
+  BOOST_CHECK(copy->findExactQNamePolicy(DNSName("added.example."), pol));
+  BOOST_CHECK(pol.d_kind == DNSFilterEngine::PolicyKind::NXDOMAIN);
+  BOOST_CHECK(zone->findClientPolicy(ComboAddress("192.0.2.1"), pol));
+  BOOST_CHECK(!copy->findClientPolicy(ComboAddress("192.0.2.1"), pol));
+  for (size_t idx = 0; idx < count; idx++) {
+    DNSName name("name" + std::to_string(idx) + ".example.");
+    BOOST_CHECK(zone->findExactQNamePolicy(name, pol));
+    BOOST_CHECK_EQUAL(copy->findExactQNamePolicy(name, pol), idx != 42);
+  }
+
+  /* clearing the copy leaves the original alone as well */
+  copy->clear();
+  BOOST_CHECK_EQUAL(copy->size(), 0U);
+  BOOST_CHECK_EQUAL(zone->size(), count + 1);
+  BOOST_CHECK(zone->findExactQNamePolicy(DNSName("name4999.example."), pol));
+}
+
+BOOST_AUTO_TEST_CASE(test_filter_policies_index_updates)
+{
+  DNSFilterEngine dfe;
+  const std::unordered_map<std::string, bool> noDiscarded;
+  const DNSName sub("www.sub.example.com.");
+
+  auto zone1 = std::make_shared<DNSFilterEngine::Zone>();
+  zone1->setName("Unit test policy 0");
+  zone1->addQNameTrigger(DNSName("*.example.com."), DNSFilterEngine::Policy(DNSFilterEngine::PolicyKind::Drop, DNSFilterEngine::PolicyType::QName));
+  zone1->addNSTrigger(DNSName("*.example.net."), DNSFilterEngine::Policy(DNSFilterEngine::PolicyKind::Drop, DNSFilterEngine::PolicyType::NSDName));
+  auto zone2 = std::make_shared<DNSFilterEngine::Zone>();
+  zone2->setName("Unit test policy 1");
+  zone2->addQNameTrigger(sub, DNSFilterEngine::Policy(DNSFilterEngine::PolicyKind::NXDOMAIN, DNSFilterEngine::PolicyType::QName));
+  zone2->addNSTrigger(DNSName("ns.example.net."), DNSFilterEngine::Policy(DNSFilterEngine::PolicyKind::NXDOMAIN, DNSFilterEngine::PolicyType::NSDName));
+  dfe.addZone(zone1);
+  dfe.addZone(zone2);
+
+  /* the wildcard from the first zone wins over the exact match from the second one */
+  auto matchingPolicy = dfe.getQueryPolicy(sub, noDiscarded, DNSFilterEngine::maximumPriority);
+  BOOST_CHECK(matchingPolicy.d_kind == DNSFilterEngine::PolicyKind::Drop);
+  BOOST_CHECK_EQUAL(matchingPolicy.getTrigger(), DNSName("*.example.com."));
+  BOOST_CHECK_EQUAL(matchingPolicy.getHit(), sub.toStringNoDot());
+  /* unless the first zone is disabled, or has a lower priority than the current policy */
+  matchingPolicy = dfe.getQueryPolicy(sub, {{zone1->getName(), true}}, DNSFilterEngine::maximumPriority);
+  BOOST_CHECK(matchingPolicy.d_kind == DNSFilterEngine::PolicyKind::NXDOMAIN);
+  BOOST_CHECK_EQUAL(matchingPolicy.getTrigger(), sub);
+  matchingPolicy = dfe.getQueryPolicy(sub, noDiscarded, 0);
+  BOOST_CHECK(matchingPolicy.d_type == DNSFilterEngine::PolicyType::None);
+  /* a wildcard does not match the name it is for */
+  matchingPolicy = dfe.getQueryPolicy(DNSName("example.com."), noDiscarded, DNSFilterEngine::maximumPriority);
+  BOOST_CHECK(matchingPolicy.d_type == DNSFilterEngine::PolicyType::None);
+  matchingPolicy = dfe.getProcessingPolicy(DNSName("ns.example.net."), noDiscarded, DNSFilterEngine::maximumPriority);
+  BOOST_CHECK(matchingPolicy.d_kind == DNSFilterEngine::PolicyKind::Drop);
+  BOOST_CHECK_EQUAL(matchingPolicy.getTrigger(), DNSName("*.example.net.rpz-nsdname."));
+  BOOST_CHECK_EQUAL(matchingPolicy.getHit(), "ns.example.net");
+
+  /* replace the first zone with a modified copy, as an RPZ update would */
+  auto copy = std::make_shared<DNSFilterEngine::Zone>(*zone1);
+  BOOST_CHECK(copy->rmQNameTrigger(DNSName("*.example.com."), DNSFilterEngine::Policy(DNSFilterEngine::PolicyKind::Drop, DNSFilterEngine::PolicyType::QName)));
+  copy->addQNameTrigger(DNSName("*.sub.example.com."), DNSFilterEngine::Policy(DNSFilterEngine::PolicyKind::NODATA, DNSFilterEngine::PolicyType::QName));
+  BOOST_CHECK(copy->rmNSTrigger(DNSName("*.example.net."), DNSFilterEngine::Policy(DNSFilterEngine::PolicyKind::Drop, DNSFilterEngine::PolicyType::NSDName)));
+  dfe.setZone(0, copy);
+
+  matchingPolicy = dfe.getQueryPolicy(sub, noDiscarded, DNSFilterEngine::maximumPriority);
+  BOOST_CHECK(matchingPolicy.d_kind == DNSFilterEngine::PolicyKind::NODATA);
+  BOOST_CHECK_EQUAL(matchingPolicy.getTrigger(), DNSName("*.sub.example.com."));
+  matchingPolicy = dfe.getQueryPolicy(DNSName("other.example.com."), noDiscarded, DNSFilterEngine::maximumPriority);
+  BOOST_CHECK(matchingPolicy.d_type == DNSFilterEngine::PolicyType::None);
+  matchingPolicy = dfe.getProcessingPolicy(DNSName("ns.example.net."), noDiscarded, DNSFilterEngine::maximumPriority);
+  BOOST_CHECK(matchingPolicy.d_kind == DNSFilterEngine::PolicyKind::NXDOMAIN);
+  BOOST_CHECK_EQUAL(matchingPolicy.getTrigger(), DNSName("ns.example.net.rpz-nsdname."));
+
+  /* modifying a zone in place after it has been added still works */
+  zone2->addQNameTrigger(DNSName("other.example.com."), DNSFilterEngine::Policy(DNSFilterEngine::PolicyKind::Truncate, DNSFilterEngine::PolicyType::QName));
+  matchingPolicy = dfe.getQueryPolicy(DNSName("other.example.com."), noDiscarded, DNSFilterEngine::maximumPriority);
+  BOOST_CHECK(matchingPolicy.d_kind == DNSFilterEngine::PolicyKind::Truncate);
+  /* and setting it again brings the index up to date */
+  dfe.setZone(1, zone2);
+  matchingPolicy = dfe.getQueryPolicy(DNSName("other.example.com."), noDiscarded, DNSFilterEngine::maximumPriority);
+  BOOST_CHECK(matchingPolicy.d_kind == DNSFilterEngine::PolicyKind::Truncate);
+  matchingPolicy = dfe.getQueryPolicy(sub, {{copy->getName(), true}}, DNSFilterEngine::maximumPriority);
+  BOOST_CHECK(matchingPolicy.d_kind == DNSFilterEngine::PolicyKind::NXDOMAIN);
+}
+
 BOOST_AUTO_TEST_CASE(test_mask_to_rpz)
 {
   BOOST_CHECK_EQUAL(DNSFilterEngine::Zone::maskToRPZ(Netmask("::2/127")).toString(), "127.2.zz.");
@@ -4,6 +4,10 @@
 
 #define BOOST_TEST_NO_MAIN
 #include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <sstream>
+#include <thread>
+#include "lock.hh"
 #include "nod.hh"
 #include "pdnsexception.hh"
 using namespace boost;
@@ -63,4 +67,105 @@ BOOST_AUTO_TEST_CASE(test_basic)
   }
 }
 
+BOOST_AUTO_TEST_CASE(test_concurrentSBFSnapshots)
+{
+  const uint32_t numCells = 1U << 20;
+  const std::vector<std::string> items{"abc.com", "xyz.com", "powerdns.com", "example.net"};
+
+  /* a snapshot written by stableBF keeps its layout */
+  bf::stableBF legacy(c_fp_rate, numCells, c_num_dec);
+  for (const auto& item : items) {
+    legacy.add(item);
+  }
+  std::stringstream legacyDump;
+  legacy.dump(legacyDump);
+
+  bf::concurrentStableBF restored(c_fp_rate, 1024, c_num_dec);
+  BOOST_CHECK(restored.getLayout() == bf::concurrentStableBF::Layout::Blocked);
+  restored.restore(legacyDump);
+  BOOST_CHECK(restored.getLayout() == bf::concurrentStableBF::Layout::Spread);
+  for (const auto& item : items) {
+    BOOST_CHECK(restored.test(item));
+  }
+  BOOST_CHECK(!restored.test("not-there.org"));
+
+  /* and is written back identically */
+  std::stringstream legacyAgain;
+  legacy.dump(legacyAgain);
+  std::stringstream restoredDump;
+  restored.dump(restoredDump);
+  BOOST_CHECK_EQUAL(restoredDump.str().substr(0, legacyAgain.str().size()), legacyAgain.str());
+  BOOST_CHECK_EQUAL(restoredDump.str().size(), legacyAgain.str().size() + 1);
+
+  /* the blocked layout survives a snapshot */
+  bf::concurrentStableBF blocked(c_fp_rate, numCells, c_num_dec);
+  for (const auto& item : items) {
+    BOOST_CHECK(!blocked.testAndAdd(item));
+    BOOST_CHECK(blocked.testAndAdd(item));
+  }
+  std::stringstream blockedDump;
+  blocked.dump(blockedDump);
+  const auto blockedStr = blockedDump.str();
+  bf::concurrentStableBF blockedRestored(c_fp_rate, 1024, c_num_dec);
+  blockedRestored.restore(blockedDump);
+  BOOST_CHECK(blockedRestored.getLayout() == bf::concurrentStableBF::Layout::Blocked);
+  for (const auto& item : items) {
+    BOOST_CHECK(blockedRestored.test(item));
+  }
+
+  /* which older versions can still parse */
+  std::stringstream forLegacy(blockedStr);
+  BOOST_CHECK_NO_THROW(legacy.restore(forLegacy));
+
+  /* truncated snapshots are refused */
+  std::stringstream truncated(blockedStr.substr(0, blockedStr.size() / 2));
+  BOOST_CHECK_THROW(blockedRestored.restore(truncated), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(test_concurrentSBFThroughput)
+{
+  const uint32_t numCells = c_num_cells;
+  const size_t numThreads = 4;
+  const size_t perThread = 100000;
+  std::vector<std::vector<std::string>> names(numThreads);
+  for (size_t thread = 0; thread < numThreads; ++thread) {
+    for (size_t idx = 0; idx < perThread; ++idx) {
+      // half of the names are shared by all threads
+      names.at(thread).push_back(DNSName("name" + std::to_string(idx % 2 == 0 ? idx : thread * perThread + idx) + ".example.com.").toDNSStringLC());
+    }
+  }
+
+  auto run = [&](auto&& testAndAdd) {
+    std::atomic<size_t> seen{0};
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (size_t thread = 0; thread < numThreads; ++thread) {
+      threads.emplace_back([&, thread]() {
+        size_t count = 0;
+        for (const auto& name : names.at(thread)) {
+          count += testAndAdd(name) ? 1 : 0;
+        }
+        seen += count;
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return std::pair(seen.load(), static_cast<double>(numThreads * perThread) / elapsed.count());
+  };
+
+  LockGuarded<bf::stableBF> locked(bf::stableBF(c_fp_rate, numCells, c_num_dec));
+  auto [lockedSeen, lockedRate] = run([&](const std::string& name) { return locked.lock()->testAndAdd(name); });
+
+  bf::concurrentStableBF concurrent(c_fp_rate, numCells, c_num_dec);
+  auto [concurrentSeen, concurrentRate] = run([&](const std::string& name) { return concurrent.testAndAdd(name); });
+
+  BOOST_TEST_MESSAGE("SBF testAndAdd with " << numThreads << " threads: locked " << static_cast<uint64_t>(lockedRate) << "/s, concurrent " << static_cast<uint64_t>(concurrentRate) << "/s");
+
+  /* the shared names were seen by most threads */
+  BOOST_CHECK_GE(concurrentSeen, numThreads * perThread / 4);
+  BOOST_CHECK_GE(lockedSeen, numThreads * perThread / 4);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -47,4 +47,22 @@ BOOST_AUTO_TEST_CASE(test_resolve_queue_rate_limit)
   BOOST_CHECK_EQUAL(getTaskSize(), 1U);
 }
 
+BOOST_AUTO_TEST_CASE(test_cache_warming_slots)
+{
+  std::vector<std::pair<DNSName, uint16_t>> names{{DNSName("a"), QType::A}, {DNSName("b"), QType::AAAA}, {DNSName("c"), QType::MX}};
+  BOOST_CHECK(startCacheWarming(std::move(names), 2));
+
+  std::vector<std::pair<DNSName, uint16_t>> more{{DNSName("d"), QType::A}};
+  BOOST_CHECK(!startCacheWarming(std::move(more), 2));
+
+  // no more concurrent resolves than asked for
+  BOOST_CHECK_EQUAL(claimCacheWarmingSlots(), 2U);
+  BOOST_CHECK_EQUAL(claimCacheWarmingSlots(), 0U);
+
+  auto status = getCacheWarmingStatus();
+  BOOST_CHECK_EQUAL(status.total, 3U);
+  BOOST_CHECK_EQUAL(status.done, 0U);
+  BOOST_CHECK_EQUAL(status.running, 2U);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -1054,6 +1054,100 @@ BOOST_AUTO_TEST_CASE(test_RecursorCache_Wipe)
   BOOST_CHECK_EQUAL(MRC.ecsIndexSize(), 0U);
 }
 
+BOOST_AUTO_TEST_CASE(test_RecursorCacheLocklessReads)
+{
+  MemRecursorCache::resetStaticsForTests();
+  MemRecursorCache::s_locklessReads = true;
+  MemRecursorCache MRC;
+
+  const DNSName power("powerdns.com.");
+  const DNSName authZone("powerdns.com.");
+  std::vector<DNSRecord> records;
+  MemRecursorCache::AuthRecsVec authRecords;
+  std::vector<std::shared_ptr<const RRSIGRecordContent>> signatures;
+  time_t now = time(nullptr);
+  std::vector<DNSRecord> retrieved;
+  ComboAddress who("192.0.2.1");
+
+  time_t ttl = 10;
+  time_t ttd = now + ttl;
+  DNSRecord dr1;
+  ComboAddress dr1Content("192.0.2.1");
+  dr1.d_name = power;
+  dr1.d_type = QType::A;
+  dr1.d_class = QClass::IN;
+  dr1.setContent(std::make_shared<ARecordContent>(dr1Content));
+  dr1.d_ttl = static_cast<uint32_t>(ttd);
+  dr1.d_place = DNSResourceRecord::ANSWER;
+  records.push_back(dr1);
+
+  MRC.replace(now, power, QType(QType::A), records, signatures, authRecords, false, authZone, boost::none, boost::none, vState::Insecure);
+  BOOST_CHECK_EQUAL(MRC.size(), 1U);
+
+  /* the first lookup takes the lock and publishes the entry */
+  auto acquired = MRC.stats().second;
+  BOOST_CHECK_EQUAL(MRC.get(now, power, QType(QType::A), MemRecursorCache::None, &retrieved, who), ttl);
+  BOOST_REQUIRE_EQUAL(retrieved.size(), 1U);
+  BOOST_CHECK_EQUAL(getRR<ARecordContent>(retrieved.at(0))->getCA().toString(), dr1Content.toString());
+  /* stats() acquires every shard lock once */
+  BOOST_CHECK_EQUAL(MRC.stats().second, acquired + 1 + 1024);
+  acquired = MRC.stats().second;
+
+  /* the second one does not */
+  vState state = vState::Indeterminate;
+  bool wasAuth = true;
+  DNSName fromAuthZone;
+  BOOST_CHECK_EQUAL(MRC.get(now, DNSName("PowerDNS.com."), QType(QType::A), MemRecursorCache::None, &retrieved, who, boost::none, nullptr, nullptr, nullptr, &state, &wasAuth, &fromAuthZone), ttl);
+  BOOST_CHECK_EQUAL(MRC.stats().second, acquired + 1024);
+  acquired = MRC.stats().second;
+  BOOST_REQUIRE_EQUAL(retrieved.size(), 1U);
+  BOOST_CHECK_EQUAL(retrieved.at(0).d_name, DNSName("PowerDNS.com."));
+  BOOST_CHECK_EQUAL(getRR<ARecordContent>(retrieved.at(0))->getCA().toString(), dr1Content.toString());
+  BOOST_CHECK_EQUAL(state, vState::Insecure);
+  BOOST_CHECK_EQUAL(wasAuth, false);
+  BOOST_CHECK_EQUAL(fromAuthZone, authZone);
+
+  /* non-auth data is not returned when auth data is required, and other types are not found */
+  BOOST_CHECK_EQUAL(MRC.get(now, power, QType(QType::A), MemRecursorCache::RequireAuth, &retrieved, who), -1);
+  BOOST_CHECK_EQUAL(MRC.get(now, power, QType(QType::AAAA), MemRecursorCache::None, &retrieved, who), -1);
+
+  /* a replacement invalidates the published entry */
+  ComboAddress dr2Content("192.0.2.2");
+  dr1.setContent(std::make_shared<ARecordContent>(dr2Content));
+  records.clear();
+  records.push_back(dr1);
+  MRC.replace(now, power, QType(QType::A), records, signatures, authRecords, true, authZone, boost::none, boost::none, vState::Secure);
+  for (size_t idx = 0; idx < 2; idx++) {
+    BOOST_CHECK_EQUAL(MRC.get(now, power, QType(QType::A), MemRecursorCache::RequireAuth, &retrieved, who, boost::none, nullptr, nullptr, nullptr, &state), ttl);
+    BOOST_REQUIRE_EQUAL(retrieved.size(), 1U);
+    BOOST_CHECK_EQUAL(getRR<ARecordContent>(retrieved.at(0))->getCA().toString(), dr2Content.toString());
+    BOOST_CHECK_EQUAL(state, vState::Secure);
+  }
+
+  /* expired entries are not served */
+  BOOST_CHECK_EQUAL(MRC.get(now + ttl + 1, power, QType(QType::A), MemRecursorCache::None, &retrieved, who), -1);
+
+  /* pruning keeps the entries that were used */
+  MRC.doPrune(now, 100);
+  BOOST_CHECK_EQUAL(MRC.size(), 1U);
+  acquired = MRC.stats().second;
+  BOOST_CHECK_EQUAL(MRC.get(now, power, QType(QType::A), MemRecursorCache::None, &retrieved, who), ttl);
+  BOOST_CHECK_EQUAL(MRC.stats().second, acquired + 1024);
+
+  /* ECS-specific entries are not published, and hide the published generic one */
+  MRC.replace(now, power, QType(QType::A), records, signatures, authRecords, true, authZone, Netmask("192.0.2.0/24"));
+  for (size_t idx = 0; idx < 2; idx++) {
+    BOOST_CHECK_EQUAL(MRC.get(now, power, QType(QType::A), MemRecursorCache::None, &retrieved, who, boost::none, nullptr, nullptr, nullptr, &state), ttl);
+    BOOST_CHECK_EQUAL(state, vState::Indeterminate);
+  }
+
+  /* wiping removes the published entry */
+  BOOST_CHECK_EQUAL(MRC.doWipeCache(power, false), 2U);
+  BOOST_CHECK_EQUAL(MRC.get(now, power, QType(QType::A), MemRecursorCache::None, &retrieved, who), -1);
+
+  MemRecursorCache::resetStaticsForTests();
+}
+
 BOOST_AUTO_TEST_CASE(test_RecursorCacheTagged)
 {
   MemRecursorCache::resetStaticsForTests();
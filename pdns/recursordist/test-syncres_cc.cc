@@ -151,6 +151,10 @@ void initSR(bool debug)
 
   SyncRes::s_maxqperq = 50;
   SyncRes::s_maxnsaddressqperq = 10;
+  SyncRes::s_maxhedgedqperq = 0;
+  SyncRes::s_gluelessnsprefetch = 0;
+  SyncRes::s_minadaptivetimeout = 50;
+  SyncRes::s_maxadaptivetimeout = 0;
   SyncRes::s_maxtotusec = 1000 * 7000;
   SyncRes::s_maxdepth = 40;
   SyncRes::s_maxnegttl = 3600;
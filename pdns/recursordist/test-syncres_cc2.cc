@@ -1477,6 +1477,211 @@ BOOST_AUTO_TEST_CASE(test_ns_speed)
   BOOST_CHECK(lines1 == lines2);
 }
 
+BOOST_AUTO_TEST_CASE(test_hedged_query)
+{
+  std::unique_ptr<SyncRes> sr;
+  initSR(sr);
+
+  primeHints();
+
+  const DNSName target("powerdns.com.");
+  const DNSName ns1("pdns-public-ns1.powerdns.com.");
+  const DNSName ns2("pdns-public-ns2.powerdns.com.");
+  const ComboAddress ns1Address("192.0.2.1:53");
+  const ComboAddress ns2Address("192.0.2.2:53");
+
+  std::map<ComboAddress, uint64_t> nsCounts;
+  boost::optional<ComboAddress> hedgeAddress;
+  unsigned int hedgeAfterMsec = 0;
+  bool hedgeWins = false;
+
+  sr->setAsyncCallback([&](const ComboAddress& address, const DNSName& domain, int /* type */, bool /* doTCP */, bool /* sendRDQuery */, int /* EDNS0Level */, struct timeval* /* now */, boost::optional<Netmask>& /* srcmask */, const ResolveContext& context, LWResult* res, bool* /* chained */) {
+    if (isRootServer(address)) {
+      BOOST_CHECK(!context.d_hedgeAddress);
+      setLWResult(res, 0, false, false, true);
+      addRecordToLW(res, domain, QType::NS, ns1.toString(), DNSResourceRecord::AUTHORITY, 172800);
+      addRecordToLW(res, domain, QType::NS, ns2.toString(), DNSResourceRecord::AUTHORITY, 172800);
+      addRecordToLW(res, ns1, QType::A, "192.0.2.1", DNSResourceRecord::ADDITIONAL, 3600);
+      addRecordToLW(res, ns2, QType::A, "192.0.2.2", DNSResourceRecord::ADDITIONAL, 3600);
+      return LWResult::Result::Success;
+    }
+
+    nsCounts[address]++;
+    hedgeAddress = context.d_hedgeAddress;
+    hedgeAfterMsec = context.d_hedgeAfterMsec;
+    setLWResult(res, 0, true, false, true);
+    addRecordToLW(res, domain, QType::A, "192.0.2.254");
+    if (hedgeWins && context.d_hedgeAddress) {
+      /* pretend the first server did not answer in time, and the hedged query to the other one did */
+      res->d_hedged = true;
+      res->d_hedgeWon = true;
+    }
+    return LWResult::Result::Success;
+  });
+
+  struct timeval now = sr->getNow();
+  SyncRes::submitNSSpeed(ns1, ns1Address, 1000, now);
+  SyncRes::submitNSSpeed(ns2, ns2Address, 100000, now);
+
+  /* hedging is disabled by default */
+  vector<DNSRecord> ret;
+  int res = sr->beginResolve(target, QType(QType::A), QClass::IN, ret);
+  BOOST_CHECK_EQUAL(res, RCode::NoError);
+  BOOST_CHECK_EQUAL(ret.size(), 1U);
+  BOOST_CHECK_EQUAL(nsCounts[ns1Address], 1U);
+  BOOST_CHECK(!hedgeAddress);
+
+  /* the next server in speed order is the hedge target, its address being in the cache */
+  SyncRes::s_maxhedgedqperq = 1;
+  g_recCache->doWipeCache(target, false, QType::A);
+  ret.clear();
+  res = sr->beginResolve(target, QType(QType::A), QClass::IN, ret);
+  BOOST_CHECK_EQUAL(res, RCode::NoError);
+  BOOST_CHECK_EQUAL(ret.size(), 1U);
+  BOOST_CHECK_EQUAL(nsCounts[ns1Address], 2U);
+  BOOST_CHECK_EQUAL(nsCounts[ns2Address], 0U);
+  BOOST_REQUIRE(hedgeAddress);
+  BOOST_CHECK_EQUAL(hedgeAddress->toStringWithPort(), ns2Address.toStringWithPort());
+  BOOST_CHECK_GE(hedgeAfterMsec, 20U);
+  BOOST_CHECK_LE(hedgeAfterMsec, g_networkTimeoutMsec / 2);
+
+  /* when the hedged query wins, the hedge target is credited with the answer */
+  hedgeWins = true;
+  g_recCache->doWipeCache(target, false, QType::A);
+  ret.clear();
+  res = sr->beginResolve(target, QType(QType::A), QClass::IN, ret);
+  BOOST_CHECK_EQUAL(res, RCode::NoError);
+  BOOST_CHECK_EQUAL(ret.size(), 1U);
+  BOOST_CHECK_EQUAL(nsCounts[ns2Address], 0U);
+  BOOST_CHECK_LT(SyncRes::getNSSpeed(ns2, ns2Address), 100000);
+
+  /* the budget for this resolution is used up */
+  g_recCache->doWipeCache(target, false, QType::A);
+  ret.clear();
+  res = sr->beginResolve(target, QType(QType::A), QClass::IN, ret);
+  BOOST_CHECK_EQUAL(res, RCode::NoError);
+  BOOST_CHECK(!hedgeAddress);
+}
+
+BOOST_AUTO_TEST_CASE(test_hedge_delay)
+{
+  BOOST_CHECK_EQUAL(SyncRes::getHedgeDelayMsec(0), 20U);
+  BOOST_CHECK_EQUAL(SyncRes::getHedgeDelayMsec(5000), 20U);
+  BOOST_CHECK_EQUAL(SyncRes::getHedgeDelayMsec(40000), 80U);
+  BOOST_CHECK_EQUAL(SyncRes::getHedgeDelayMsec(1e9), g_networkTimeoutMsec / 2);
+}
+
+BOOST_AUTO_TEST_CASE(test_adaptive_timeout)
+{
+  std::unique_ptr<SyncRes> sr;
+  initSR(sr);
+
+  const DNSName server("ns.example.net.");
+  const ComboAddress address("192.0.2.1:53");
+  const ComboAddress unknown("192.0.2.2:53");
+  struct timeval now{};
+  Utility::gettimeofday(&now, nullptr);
+
+  SyncRes::submitNSSpeed(server, address, 5000, now);
+  // disabled by default
+  BOOST_CHECK_EQUAL(SyncRes::getAdaptiveTimeoutMsec(server, address), 0U);
+
+  SyncRes::s_minadaptivetimeout = 10;
+  SyncRes::s_maxadaptivetimeout = 1000;
+  BOOST_CHECK_EQUAL(SyncRes::getAdaptiveTimeoutMsec(server, unknown), 0U);
+  // 5ms plus four times the initial variation of half that
+  BOOST_CHECK_EQUAL(SyncRes::getAdaptiveTimeoutMsec(server, address), 15U);
+
+  // a steady server needs less margin
+  for (int count = 0; count < 20; ++count) {
+    SyncRes::submitNSSpeed(server, address, 5000, now);
+  }
+  BOOST_CHECK_EQUAL(SyncRes::getAdaptiveTimeoutMsec(server, address), 10U);
+
+  // a jittery one more
+  for (int count = 0; count < 20; ++count) {
+    SyncRes::submitNSSpeed(server, address, count % 2 == 0 ? 5000 : 50000, now);
+  }
+  auto timeout = SyncRes::getAdaptiveTimeoutMsec(server, address);
+  BOOST_CHECK_GT(timeout, 50U);
+  BOOST_CHECK_LT(timeout, 1000U);
+
+  SyncRes::submitNSSpeed(server, address, 10000000, now);
+  BOOST_CHECK_EQUAL(SyncRes::getAdaptiveTimeoutMsec(server, address), 1000U);
+}
+
+BOOST_AUTO_TEST_CASE(test_glueless_ns_prefetch)
+{
+  std::unique_ptr<SyncRes> sr;
+  initSR(sr);
+
+  primeHints();
+
+  const DNSName target("powerdns.com.");
+  const DNSName ns1("pdns-public-ns1.powerdns.org.");
+  const DNSName ns2("pdns-public-ns2.powerdns.org.");
+  const DNSName ns3("pdns-public-ns3.powerdns.org.");
+  size_t ns2Queries = 0;
+
+  sr->setAsyncCallback([&](const ComboAddress& address, const DNSName& domain, int /* type */, bool /* doTCP */, bool /* sendRDQuery */, int /* EDNS0Level */, struct timeval* /* now */, boost::optional<Netmask>& /* srcmask */, const ResolveContext& /* context */, LWResult* res, bool* /* chained */) {
+    if (isRootServer(address)) {
+      if (domain == target) {
+        setLWResult(res, 0, false, false, true);
+        addRecordToLW(res, domain, QType::NS, ns1.toString(), DNSResourceRecord::AUTHORITY, 172800);
+        addRecordToLW(res, domain, QType::NS, ns2.toString(), DNSResourceRecord::AUTHORITY, 172800);
+        addRecordToLW(res, domain, QType::NS, ns3.toString(), DNSResourceRecord::AUTHORITY, 172800);
+        return LWResult::Result::Success;
+      }
+      if (domain == ns1) {
+        /* while we are busy failing to resolve ns1, the background task resolving ns3 completes */
+        time_t now = sr->getNow().tv_sec;
+        std::vector<DNSRecord> records;
+        addRecordToList(records, ns3, QType::A, "192.0.2.3", DNSResourceRecord::ANSWER, now + 3600);
+        g_recCache->replace(now, ns3, QType(QType::A), records, {}, {}, false, g_rootdnsname, boost::optional<Netmask>());
+        setLWResult(res, RCode::NXDomain, true, false, true);
+        addRecordToLW(res, "org.", QType::SOA, "a.root-servers.net. nstld.verisign-grs.com. 2017032800 1800 900 604800 86400", DNSResourceRecord::AUTHORITY, 86400);
+        return LWResult::Result::Success;
+      }
+      if (domain == ns2) {
+        ns2Queries++;
+      }
+      return LWResult::Result::Timeout;
+    }
+    if (address == ComboAddress("192.0.2.3:53")) {
+      setLWResult(res, 0, true, false, true);
+      addRecordToLW(res, domain, QType::A, "192.0.2.254");
+      return LWResult::Result::Success;
+    }
+    return LWResult::Result::Timeout;
+  });
+
+  struct timeval now = sr->getNow();
+  SyncRes::submitNSSpeed(ns1, ComboAddress("192.0.2.1:53"), 1000, now);
+  SyncRes::submitNSSpeed(ns2, ComboAddress("192.0.2.2:53"), 2000, now);
+  SyncRes::submitNSSpeed(ns3, ComboAddress("192.0.2.3:53"), 3000, now);
+  SyncRes::s_gluelessnsprefetch = 2;
+  const auto hits = t_Counters.at(rec::Counter::gluelessNSPrefetchHits);
+
+  vector<DNSRecord> ret;
+  int res = sr->beginResolve(target, QType(QType::A), QClass::IN, ret);
+  BOOST_CHECK_EQUAL(res, RCode::NoError);
+  BOOST_REQUIRE_EQUAL(ret.size(), 1U);
+  BOOST_CHECK_EQUAL(ret[0].d_name, target);
+  /* ns3 was used as soon as ns1 failed, instead of resolving ns2 first */
+  BOOST_CHECK_EQUAL(ns2Queries, 0U);
+  BOOST_CHECK_EQUAL(t_Counters.at(rec::Counter::gluelessNSPrefetchHits), hits + 1);
+
+  /* the IPv4 addresses of ns2 and ns3 were pushed to the task queue, next to the usual AAAA tasks */
+  std::set<DNSName> prefetched;
+  while (getTaskSize() > 0) {
+    auto task = taskQueuePop();
+    if (task.d_qtype == QType::A) {
+      prefetched.insert(task.d_qname);
+    }
+  }
+  BOOST_CHECK(prefetched == std::set<DNSName>({ns2, ns3}));
+}
+
 BOOST_AUTO_TEST_CASE(test_flawed_nsset)
 {
   std::unique_ptr<SyncRes> sr;
@@ -9,7 +9,9 @@
 #include "dnsrecords.hh"
 #include "iputils.hh"
 #include <fstream>
+#include <random>
 #include "uuid-utils.hh"
+#include "zoneparser-tng.hh"
 #include "dnssecinfra.hh"
 #include "lock.hh"
 #include "dns_random.hh"
@@ -621,6 +623,138 @@ struct BigDNSPacketRefTest
 };
 
 
+struct TypicalAnswerTest
+{
+  TypicalAnswerTest() :
+    d_cname(DNSRecordContent::make(QType::CNAME, 1, "www.example.com.cdn.example.net.")),
+    d_a1(DNSRecordContent::make(QType::A, 1, "192.0.2.1")),
+    d_a2(DNSRecordContent::make(QType::A, 1, "192.0.2.2")),
+    d_ns1(DNSRecordContent::make(QType::NS, 1, "ns1.example.net.")),
+    d_ns2(DNSRecordContent::make(QType::NS, 1, "ns2.example.net."))
+  {
+  }
+
+  string getName() const
+  {
+    return "write typical answer";
+  }
+
+  void operator()() const
+  {
+    vector<uint8_t> packet;
+    DNSPacketWriter pw(packet, d_qname, QType::A);
+    pw.startRecord(d_qname, QType::CNAME, 3600, 1, DNSResourceRecord::ANSWER);
+    d_cname->toPacket(pw);
+    pw.startRecord(d_target, QType::A, 300, 1, DNSResourceRecord::ANSWER);
+    d_a1->toPacket(pw);
+    pw.startRecord(d_target, QType::A, 300, 1, DNSResourceRecord::ANSWER);
+    d_a2->toPacket(pw);
+    pw.startRecord(d_zone, QType::NS, 3600, 1, DNSResourceRecord::AUTHORITY);
+    d_ns1->toPacket(pw);
+    pw.startRecord(d_zone, QType::NS, 3600, 1, DNSResourceRecord::AUTHORITY);
+    d_ns2->toPacket(pw);
+    pw.commit();
+  }
+
+  const DNSName d_qname{"www.example.com"};
+  const DNSName d_target{"www.example.com.cdn.example.net"};
+  const DNSName d_zone{"example.net"};
+  shared_ptr<const DNSRecordContent> d_cname;
+  shared_ptr<const DNSRecordContent> d_a1;
+  shared_ptr<const DNSRecordContent> d_a2;
+  shared_ptr<const DNSRecordContent> d_ns1;
+  shared_ptr<const DNSRecordContent> d_ns2;
+};
+
+struct LargeReferralTest
+{
+  explicit LargeReferralTest(unsigned int nsCount)
+  {
+    for (unsigned int idx = 0; idx < nsCount; idx++) {
+      d_nsNames.emplace_back("ns" + std::to_string(idx % 4) + ".provider-" + std::to_string(idx / 4) + ".example.net");
+      d_nsRecords.push_back(DNSRecordContent::make(QType::NS, 1, d_nsNames.back().toString()));
+    }
+    d_a = DNSRecordContent::make(QType::A, 1, "192.0.2.1");
+    d_aaaa = DNSRecordContent::make(QType::AAAA, 1, "2001:db8::1");
+  }
+
+  string getName() const
+  {
+    return "write referral with " + std::to_string(d_nsNames.size()) + " nameservers";
+  }
+
+  void operator()() const
+  {
+    vector<uint8_t> packet;
+    DNSPacketWriter pw(packet, DNSName("www.example.com"), QType::A);
+    for (const auto& nsRecord : d_nsRecords) {
+      pw.startRecord(d_zone, QType::NS, 3600, 1, DNSResourceRecord::AUTHORITY);
+      nsRecord->toPacket(pw);
+    }
+    for (const auto& nsName : d_nsNames) {
+      pw.startRecord(nsName, QType::A, 3600, 1, DNSResourceRecord::ADDITIONAL);
+      d_a->toPacket(pw);
+      pw.startRecord(nsName, QType::AAAA, 3600, 1, DNSResourceRecord::ADDITIONAL);
+      d_aaaa->toPacket(pw);
+    }
+    pw.commit();
+  }
+
+  const DNSName d_zone{"example.com"};
+  vector<DNSName> d_nsNames;
+  vector<shared_ptr<const DNSRecordContent>> d_nsRecords;
+  shared_ptr<const DNSRecordContent> d_a;
+  shared_ptr<const DNSRecordContent> d_aaaa;
+};
+
+struct AXFRMessageTest
+{
+  AXFRMessageTest()
+  {
+    /* a mix of the usual record types, more than enough to fill a 64 KiB message */
+    const DNSName zone("example.com");
+    for (unsigned int idx = 0; idx < 4000; idx++) {
+      DNSName name = DNSName("host-" + std::to_string(idx)) + zone;
+      switch (idx % 4) {
+      case 0:
+        d_records.emplace_back(name, QType::A, DNSRecordContent::make(QType::A, 1, "192.0.2." + std::to_string(idx % 256)));
+        break;
+      case 1:
+        d_records.emplace_back(name, QType::MX, DNSRecordContent::make(QType::MX, 1, "10 mail-" + std::to_string(idx % 8) + ".example.com."));
+        break;
+      case 2:
+        d_records.emplace_back(name, QType::CNAME, DNSRecordContent::make(QType::CNAME, 1, "host-" + std::to_string(idx - 2) + ".example.com."));
+        break;
+      default:
+        d_records.emplace_back(name, QType::NS, DNSRecordContent::make(QType::NS, 1, "ns" + std::to_string(idx % 2) + ".example.net."));
+        break;
+      }
+    }
+  }
+
+  string getName() const
+  {
+    return "write 64KiB AXFR message";
+  }
+
+  void operator()() const
+  {
+    vector<uint8_t> packet;
+    DNSPacketWriter pw(packet, DNSName("example.com"), QType::AXFR);
+    for (const auto& [name, qtype, content] : d_records) {
+      pw.startRecord(name, qtype, 3600, 1, DNSResourceRecord::ANSWER);
+      content->toPacket(pw);
+      if (pw.size() > std::numeric_limits<uint16_t>::max()) {
+        pw.rollback();
+        break;
+      }
+      pw.commit();
+    }
+  }
+
+  vector<std::tuple<DNSName, uint16_t, shared_ptr<const DNSRecordContent>>> d_records;
+};
+
 struct TCacheComp
 {
   bool operator()(const pair<DNSName, QType>& a, const pair<DNSName, QType>& b) const
@@ -704,6 +838,59 @@ struct ParsePacketBareTest
 };
 
 
+struct ViewPacketTest
+{
+  explicit ViewPacketTest(const vector<uint8_t>& packet, const std::string& name)
+    : d_packet(packet), d_name(name)
+  {}
+
+  string getName() const
+  {
+    return "view '"+d_name+"'";
+  }
+
+  void operator()() const
+  {
+    DNSMessageView view(false, std::string_view(reinterpret_cast<const char*>(d_packet.data()), d_packet.size()));
+
+    struct {
+            vector<DNSResourceRecord> d_result;
+            bool d_aabit;
+            int d_rcode;
+    } lwr;
+    for (const auto& record : view.getRecords()) {
+      DNSResourceRecord rr;
+      rr.qtype=record.d_type;
+      rr.qname=view.getName(record.d_nameOffset);
+
+      rr.ttl=record.d_ttl;
+      rr.content=view.getContent(record)->getZoneRepresentation();  // this should be the serialised form
+      lwr.d_result.push_back(rr);
+    }
+  }
+  const vector<uint8_t>& d_packet;
+  std::string d_name;
+};
+
+struct ViewPacketBareTest
+{
+  explicit ViewPacketBareTest(const vector<uint8_t>& packet, const std::string& name)
+    : d_packet(packet), d_name(name)
+  {}
+
+  string getName() const
+  {
+    return "view '"+d_name+"' bare";
+  }
+
+  void operator()() const
+  {
+    DNSMessageView view(false, std::string_view(reinterpret_cast<const char*>(d_packet.data()), d_packet.size()));
+  }
+  const vector<uint8_t>& d_packet;
+  std::string d_name;
+};
+
 struct SimpleCompressTest
 {
   explicit SimpleCompressTest(const std::string& name)
@@ -770,6 +957,94 @@ struct DNSNameRootTest
 
 };
 
+struct DNSNameCopyTest
+{
+  explicit DNSNameCopyTest(const string& name) :
+    d_name(name)
+  {
+  }
+
+  string getName() const
+  {
+    return "DNSName copy " + d_name.toLogString();
+  }
+
+  void operator()() const
+  {
+    DNSName copy(d_name);
+    g_ret = copy.empty();
+  }
+
+private:
+  const DNSName d_name;
+};
+
+struct DNSNameCompareTest
+{
+  DNSNameCompareTest(const string& lhs, const string& rhs) :
+    d_lhs(lhs), d_rhs(rhs)
+  {
+  }
+
+  string getName() const
+  {
+    return "DNSName compare " + d_lhs.toLogString() + " " + d_rhs.toLogString();
+  }
+
+  void operator()() const
+  {
+    g_ret = d_lhs == d_rhs;
+    g_ret = d_lhs.canonCompare(d_rhs);
+    g_ret = d_lhs < d_rhs;
+  }
+
+private:
+  const DNSName d_lhs;
+  const DNSName d_rhs;
+};
+
+struct DNSNameHashTest
+{
+  explicit DNSNameHashTest(const string& name) :
+    d_name(name)
+  {
+  }
+
+  string getName() const
+  {
+    return "DNSName hash " + d_name.toLogString();
+  }
+
+  void operator()() const
+  {
+    g_ret = d_name.hash() != 0;
+  }
+
+private:
+  const DNSName d_name;
+};
+
+struct DNSNameLowerCaseTest
+{
+  explicit DNSNameLowerCaseTest(const string& name) :
+    d_name(name)
+  {
+  }
+
+  string getName() const
+  {
+    return "DNSName makeLowerCase " + d_name.toLogString();
+  }
+
+  void operator()() const
+  {
+    g_ret = d_name.makeLowerCase().empty();
+  }
+
+private:
+  const DNSName d_name;
+};
+
 struct SuffixMatchNodeTest
 {
   SuffixMatchNodeTest()
@@ -798,6 +1073,49 @@ private:
   SuffixMatchNode d_smn;
 };
 
+struct SuffixMatchNodeLargeTest
+{
+  SuffixMatchNodeLargeTest(size_t count, bool compiled) :
+    d_compiled(compiled)
+  {
+    for (size_t idx = 0; idx < count; idx++) {
+      d_smn.add(DNSName("domain" + std::to_string(idx) + ".zone" + std::to_string(idx % 1000) + ".example"));
+    }
+    if (compiled) {
+      d_smn.compile();
+    }
+    for (size_t idx = 0; idx < 100; idx++) {
+      d_exist.emplace_back("www.domain" + std::to_string(idx * 997) + ".zone" + std::to_string((idx * 997) % 1000) + ".example");
+      d_does_not_exist.emplace_back("www.domain" + std::to_string(idx * 997) + ".zone" + std::to_string((idx * 997 + 1) % 1000) + ".example");
+    }
+  }
+
+  string getName() const
+  {
+    return std::string(d_compiled ? "Compiled" : "") + "SuffixMatchNode with " + std::to_string(d_exist.size() + d_does_not_exist.size()) + " lookups";
+  }
+
+  void operator()() const
+  {
+    for (const auto& name : d_exist) {
+      if (!d_smn.check(name)) {
+        throw std::runtime_error("Entry not found in SuffixMatchNodeLargeTest");
+      }
+    }
+    for (const auto& name : d_does_not_exist) {
+      if (d_smn.check(name)) {
+        throw std::runtime_error("Non-existent entry found in SuffixMatchNodeLargeTest");
+      }
+    }
+  }
+
+private:
+  std::vector<DNSName> d_exist;
+  std::vector<DNSName> d_does_not_exist;
+  SuffixMatchNode d_smn;
+  bool d_compiled;
+};
+
 struct IEqualsTest
 {
   string getName() const
@@ -929,6 +1247,134 @@ struct NetmaskTreeTest
   }
 };
 
+struct NetmaskGroupLookupTest
+{
+  NetmaskGroupLookupTest(size_t count, bool compiled) :
+    d_compiled(compiled)
+  {
+    std::mt19937 gen(42);
+    for (size_t idx = 0; idx < count; idx++) {
+      if (idx % 2 == 0) {
+        ComboAddress address(std::to_string(gen() % 256) + "." + std::to_string(gen() % 256) + "." + std::to_string(gen() % 256) + "." + std::to_string(gen() % 256));
+        d_nmg.addMask(Netmask(address, 16 + gen() % 17));
+      }
+      else {
+        ComboAddress address((boost::format("2001:db8:%x:%x:%x::") % (gen() % 65536) % (gen() % 65536) % (gen() % 65536)).str());
+        d_nmg.addMask(Netmask(address, 32 + gen() % 33));
+      }
+    }
+    if (compiled) {
+      /* large groups are usually not compiled because of the memory it takes, force it */
+      d_nmg.compile(std::numeric_limits<size_t>::max());
+    }
+    for (size_t idx = 0; idx < 100; idx++) {
+      d_addresses.emplace_back(std::to_string(gen() % 256) + "." + std::to_string(gen() % 256) + "." + std::to_string(gen() % 256) + "." + std::to_string(gen() % 256));
+      d_addresses.emplace_back((boost::format("2001:db8:%x:%x:%x::%x") % (gen() % 65536) % (gen() % 65536) % (gen() % 65536) % (gen() % 65536)).str());
+    }
+  }
+
+  string getName() const
+  {
+    return std::string(d_compiled ? "Compiled" : "") + "NetmaskGroup with " + std::to_string(d_nmg.size()) + " masks, " + std::to_string(d_addresses.size()) + " lookups";
+  }
+
+  void operator()() const
+  {
+    size_t matches = 0;
+    for (const auto& address : d_addresses) {
+      if (d_nmg.match(address)) {
+        matches++;
+      }
+    }
+    if (matches == d_addresses.size()) {
+      throw std::runtime_error("Every address matched in NetmaskGroupLookupTest");
+    }
+  }
+
+private:
+  std::vector<ComboAddress> d_addresses;
+  NetmaskGroup d_nmg;
+  bool d_compiled;
+};
+
+struct ZoneParserTest
+{
+  ZoneParserTest(size_t records, size_t threads) :
+    d_records(records), d_threads(threads)
+  {
+    char path[] = "/tmp/pdns-speedtest-zone.XXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0) {
+      throw std::runtime_error("Unable to create a temporary file: " + stringerror());
+    }
+    close(fd);
+    d_path = path;
+
+    std::ofstream ofs(d_path);
+    ofs << "$TTL 3600\n@ IN SOA ns1 hostmaster 1 3600 600 86400 300\n";
+    for (size_t idx = 1; idx < records; idx++) {
+      switch (idx % 4) {
+      case 0:
+        ofs << "host" << idx << " IN A 192.0.2." << (idx % 256) << "\n";
+        break;
+      case 1:
+        ofs << " 300 IN AAAA 2001:db8::" << std::hex << (idx % 65536) << std::dec << "\n";
+        break;
+      case 2:
+        ofs << " IN MX 10 mail" << idx << "\n";
+        break;
+      default:
+        ofs << "alias" << idx << " IN CNAME host" << (idx - 3) << "\n";
+      }
+    }
+  }
+  ZoneParserTest(const ZoneParserTest&) = delete;
+  ZoneParserTest(ZoneParserTest&&) = delete;
+  ZoneParserTest& operator=(const ZoneParserTest&) = delete;
+  ZoneParserTest& operator=(ZoneParserTest&&) = delete;
+
+  ~ZoneParserTest()
+  {
+    if (!d_path.empty()) {
+      unlink(d_path.c_str());
+    }
+  }
+
+  string getName() const
+  {
+    return "zone parsing, " + std::to_string(d_records) + " records, " + std::to_string(d_threads) + " thread(s)";
+  }
+
+  /* doRun() measures CPU time, which says nothing about the benefit of parsing on several threads */
+  void reportThroughput() const
+  {
+    DTime dt;
+    dt.set();
+    (*this)();
+    const double delta = dt.udiff() / 1000000.0;
+    cerr << (boost::format("'%s' %.02f seconds: %.1f records/s") % getName() % delta % (d_records / delta)) << endl;
+  }
+
+  void operator()() const
+  {
+    ZoneParserTNG zpt(d_path, ZoneName("example.com"));
+    zpt.setParallelThreads(d_threads);
+    DNSResourceRecord rr;
+    size_t count = 0;
+    while (zpt.get(rr)) {
+      count++;
+    }
+    if (count != d_records) {
+      throw std::runtime_error("Parsed " + std::to_string(count) + " records instead of " + std::to_string(d_records));
+    }
+  }
+
+private:
+  std::string d_path;
+  size_t d_records;
+  size_t d_threads;
+};
+
 struct UUIDGenTest
 {
   string getName() const { return "UUIDGenTest"; }
@@ -1240,17 +1686,24 @@ int main()
 
     doRun(EmptyQueryTest());
     doRun(TypicalRefTest());
+    doRun(TypicalAnswerTest());
     doRun(BigRefTest());
     doRun(BigDNSPacketRefTest());
+    doRun(LargeReferralTest(13));
+    doRun(LargeReferralTest(100));
+    doRun(AXFRMessageTest());
 
     auto packet = makeEmptyQuery();
     doRun(ParsePacketTest(packet, "empty-query"));
+    doRun(ViewPacketTest(packet, "empty-query"));
 
     packet = makeTypicalReferral();
     cerr<<"typical referral size: "<<packet.size()<<endl;
     doRun(ParsePacketBareTest(packet, "typical-referral"));
+    doRun(ViewPacketBareTest(packet, "typical-referral"));
 
     doRun(ParsePacketTest(packet, "typical-referral"));
+    doRun(ViewPacketTest(packet, "typical-referral"));
 
     doRun(SimpleCompressTest("www.france.ds9a.nl"));
 
@@ -1324,10 +1777,26 @@ int main()
 
     doRun(DNSNameParseTest());
     doRun(DNSNameRootTest());
+    doRun(DNSNameCopyTest("www.powerdns.com"));
+    doRun(DNSNameCopyTest("a-rather-long-label.with-more-labels.example"));
+    doRun(DNSNameCompareTest("www.PowerDNS.com", "WWW.powerdns.COM"));
+    doRun(DNSNameCompareTest("a-rather-long-label.with-more-labels.under.a-very-long-domain-name.example", "A-Rather-Long-Label.With-More-Labels.Under.A-Very-Long-Domain-Name.Example"));
+    doRun(DNSNameHashTest("www.PowerDNS.com"));
+    doRun(DNSNameHashTest("a-rather-long-label.with-more-labels.under.a-very-long-domain-name.example"));
+    doRun(DNSNameLowerCaseTest("WWW.PowerDNS.COM"));
+    doRun(DNSNameLowerCaseTest("A-Rather-Long-Label.With-More-Labels.Under.A-Very-Long-Domain-Name.Example"));
 
     doRun(SuffixMatchNodeTest());
+    doRun(SuffixMatchNodeLargeTest(1000000, false));
+    doRun(SuffixMatchNodeLargeTest(1000000, true));
 
     doRun(NetmaskTreeTest());
+    doRun(NetmaskGroupLookupTest(1000, false));
+    doRun(NetmaskGroupLookupTest(1000, true));
+    doRun(NetmaskGroupLookupTest(1000000, false));
+    doRun(NetmaskGroupLookupTest(1000000, true));
+    ZoneParserTest(1000000, 1).reportThroughput();
+    ZoneParserTest(1000000, 4).reportThroughput();
 
     doRun(UUIDGenTest());
 
@@ -793,6 +793,57 @@ int TCPNameserver::doAXFR(const ZoneName &targetZone, std::unique_ptr<DNSPacket>
   const bool rectify = !(presignedZone || ::arg().mustDo("disable-axfr-rectify"));
   set<DNSName> qnames, nsset, terms;
 
+  typedef map<DNSName, NSECXEntry, CanonDNSNameCompare> nsecxrepo_t;
+  nsecxrepo_t nsecxrepo;
+
+  ChunkedSigningPipe csp(targetZone, (securedZone && !presignedZone), ::arg().asNum("signing-threads", 1), ::arg().mustDo("workaround-11804") ? 1 : 100);
+
+  // Records of zones we do not have to sign or chain are sent as soon as they are read from
+  // the backend, instead of being collected first. Only SVCB and HTTPS records are kept
+  // aside, as filling their automatic hints requires more lookups once the listing is done.
+  const bool streaming = !securedZone && di.kind != DomainInfo::Producer && ::arg().mustDo("outgoing-axfr-streaming");
+  uint64_t recordsSubmitted = 0;
+  uint64_t recordsSent = 0;
+  uint64_t peakRecords = 0;
+  // signatures are counted as sent too, so this is only an estimate for signed zones
+  auto recordsInPipe = [&]() -> uint64_t {
+    return recordsSubmitted > recordsSent ? recordsSubmitted - recordsSent : 0;
+  };
+
+  auto sendReadyChunks = [&]() {
+    for(;;) {
+      outpacket->getRRS() = csp.getChunk();
+      if(outpacket->getRRS().empty()) {
+        break;
+      }
+      recordsSent += outpacket->getRRS().size();
+      if(haveTSIGDetails && !tsigkeyname.empty())
+        outpacket->setTSIGDetails(trc, tsigkeyname, tsigsecret, trc.d_mac, true);
+      sendPacket(outpacket, outsock, false);
+      trc.d_mac=outpacket->d_trc.d_mac;
+      outpacket=getFreshAXFRPacket(q);
+    }
+  };
+
+  auto submitRecord = [&](const DNSZoneRecord& rec) {
+    ++recordsSubmitted;
+    if(csp.submit(rec)) {
+      sendReadyChunks();
+    }
+  };
+
+  auto addRecord = [&](const DNSZoneRecord& rec) {
+    if (!streaming || rec.dr.d_type == QType::SVCB || rec.dr.d_type == QType::HTTPS) {
+      zrrs.push_back(rec);
+      return;
+    }
+    if (rec.dr.d_type == 0 || rec.dr.d_type == QType::SOA) {
+      return; // same as below, skip empty non-terminals and the SOA
+    }
+    submitRecord(rec);
+    peakRecords = std::max(peakRecords, zrrs.size() + recordsInPipe());
+  };
+
   // Catalog zone start
   if (di.kind == DomainInfo::Producer) {
     // Ignore all records except NS at apex
@@ -863,6 +914,12 @@ int TCPNameserver::doAXFR(const ZoneName &targetZone, std::unique_ptr<DNSPacket>
               g_log << Logger::Error << logPrefix << zrr.dr.d_name.toLogString() << ": error resolving AAAA record for ALIAS target " << zrr.dr.getContent()->getZoneRepresentation() << ", continuing AXFR" << endl;
             }
           }
+          else if (streaming) {
+            // Records have already been sent, a SERVFAIL in the middle of the transfer would not make
+            // sense to the secondary. Closing the connection without the final SOA tells it the transfer failed.
+            g_log << Logger::Warning << logPrefix << zrr.dr.d_name.toLogString() << ": error resolving for ALIAS " << zrr.dr.getContent()->getZoneRepresentation() << ", aborting streamed AXFR by closing the connection" << endl;
+            throw NetworkError("streamed AXFR of zone '" + targetZone.toLogString() + "' aborted");
+          }
           else {
             g_log << Logger::Warning << logPrefix << zrr.dr.d_name.toLogString() << ": error resolving for ALIAS " << zrr.dr.getContent()->getZoneRepresentation() << ", aborting AXFR" << endl;
             outpacket->setRcode(RCode::ServFail);
@@ -873,12 +930,12 @@ int TCPNameserver::doAXFR(const ZoneName &targetZone, std::unique_ptr<DNSPacket>
         for (auto& ip: ips) {
           zrr.dr.d_type = ip.dr.d_type;
           zrr.dr.setContent(ip.dr.getContent());
-          zrrs.push_back(zrr);
+          addRecord(zrr);
         }
         continue;
       }
 
-      if (rectify) {
+      if (rectify && !streaming) { // without signing, rectify only matters for what we keep in memory
         if (zrr.dr.d_type) {
           qnames.insert(zrr.dr.d_name);
           if(zrr.dr.d_type == QType::NS && zrr.dr.d_name!=target)
@@ -888,7 +945,7 @@ int TCPNameserver::doAXFR(const ZoneName &targetZone, std::unique_ptr<DNSPacket>
           continue;
         }
       }
-      zrrs.push_back(zrr);
+      addRecord(zrr);
     } else {
       if (zrr.dr.d_type)
         g_log<<Logger::Warning<<logPrefix<<"zone contains out-of-zone data '"<<zrr.dr.d_name<<"|"<<DNSRecordContent::NumberToType(zrr.dr.d_type)<<"', ignoring"<<endl;
@@ -1021,11 +1078,6 @@ send:
 
   /* now write all other records */
 
-  typedef map<DNSName, NSECXEntry, CanonDNSNameCompare> nsecxrepo_t;
-  nsecxrepo_t nsecxrepo;
-
-  ChunkedSigningPipe csp(targetZone, (securedZone && !presignedZone), ::arg().asNum("signing-threads", 1), ::arg().mustDo("workaround-11804") ? 1 : 100);
-
   DNSName keyname;
   unsigned int udiff;
   DTime dt;
@@ -1053,21 +1105,9 @@ send:
     if(loopZRR.dr.d_type == QType::SOA)
       continue; // skip SOA - would indicate end of AXFR
 
-    if(csp.submit(loopZRR)) {
-      for(;;) {
-        outpacket->getRRS() = csp.getChunk();
-        if(!outpacket->getRRS().empty()) {
-          if(haveTSIGDetails && !tsigkeyname.empty())
-            outpacket->setTSIGDetails(trc, tsigkeyname, tsigsecret, trc.d_mac, true);
-          sendPacket(outpacket, outsock, false);
-          trc.d_mac=outpacket->d_trc.d_mac;
-          outpacket=getFreshAXFRPacket(q);
-        }
-        else
-          break;
-      }
-    }
+    submitRecord(loopZRR);
   }
+  peakRecords = std::max(peakRecords, zrrs.size() + nsecxrepo.size() + recordsInPipe());
   /*
   udiff=dt.udiffNoReset();
   cerr<<"Starting NSEC: "<<csp.d_signed/(udiff/1000000.0)<<" sigs/s, "<<csp.d_signed<<" / "<<udiff/1000000.0<<endl;
@@ -1106,20 +1146,7 @@ send:
           zrr.dr.d_type = QType::NSEC3;
           zrr.dr.d_place = DNSResourceRecord::ANSWER;
           zrr.auth=true;
-          if(csp.submit(zrr)) {
-            for(;;) {
-              outpacket->getRRS() = csp.getChunk();
-              if(!outpacket->getRRS().empty()) {
-                if(haveTSIGDetails && !tsigkeyname.empty())
-                  outpacket->setTSIGDetails(trc, tsigkeyname, tsigsecret, trc.d_mac, true);
-                sendPacket(outpacket, outsock, false);
-                trc.d_mac=outpacket->d_trc.d_mac;
-                outpacket=getFreshAXFRPacket(q);
-              }
-              else
-                break;
-            }
-          }
+          submitRecord(zrr);
         }
       }
     }
@@ -1140,20 +1167,7 @@ send:
       zrr.dr.d_type = QType::NSEC;
       zrr.dr.d_place = DNSResourceRecord::ANSWER;
       zrr.auth=true;
-      if(csp.submit(zrr)) {
-        for(;;) {
-          outpacket->getRRS() = csp.getChunk();
-          if(!outpacket->getRRS().empty()) {
-            if(haveTSIGDetails && !tsigkeyname.empty())
-              outpacket->setTSIGDetails(trc, tsigkeyname, tsigsecret, trc.d_mac, true);
-            sendPacket(outpacket, outsock, false);
-            trc.d_mac=outpacket->d_trc.d_mac;
-            outpacket=getFreshAXFRPacket(q);
-          }
-          else
-            break;
-        }
-      }
+      submitRecord(zrr);
     }
   }
   /*
@@ -1194,7 +1208,12 @@ send:
   sendPacket(outpacket, outsock);
 
   DLOG(g_log<<logPrefix<<"last packet - close"<<endl);
-  g_log<<Logger::Notice<<logPrefix<<"AXFR finished"<<endl;
+  g_log<<Logger::Notice<<logPrefix<<"AXFR finished, at most "<<peakRecords<<" records were held in memory"<<(streaming ? " (streamed)" : "")<<endl;
+
+  auto* peakStat = S.getPointer("xfr-out-peak-records");
+  uint64_t previousPeak = *peakStat;
+  while (peakRecords > previousPeak && !peakStat->compare_exchange_weak(previousPeak, peakRecords)) {
+  }
 
   return 1;
 }
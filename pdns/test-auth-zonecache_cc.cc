@@ -247,4 +247,117 @@ BOOST_AUTO_TEST_CASE(test_netmask)
   }
 }
 
+BOOST_AUTO_TEST_CASE(test_closest_entry)
+{
+  AuthZoneCache cache;
+  cache.setRefreshInterval(3600);
+
+  vector<std::tuple<ZoneName, domainid_t>> zone_indices{
+    {ZoneName("example.org."), 1},
+    {ZoneName("sub.sub.example.org."), 2},
+    {ZoneName("bug.less..inner"), 3},
+  };
+  cache.setReplacePending();
+  cache.replace(zone_indices);
+  auto tree = cache.getLocalSuffixTree();
+
+  domainid_t zoneId{0};
+  ZoneName zone("a.b.c.sub.example.org.");
+  BOOST_REQUIRE(cache.getClosestEntry(tree, zone, zoneId, ""));
+  BOOST_CHECK_EQUAL(zone, ZoneName("example.org."));
+  BOOST_CHECK_EQUAL(zoneId, 1);
+
+  zone = ZoneName("www.sub.sub.example.org.");
+  BOOST_REQUIRE(cache.getClosestEntry(tree, zone, zoneId, ""));
+  BOOST_CHECK_EQUAL(zone, ZoneName("sub.sub.example.org."));
+  BOOST_CHECK_EQUAL(zoneId, 2);
+
+  zone = ZoneName("example.com.");
+  BOOST_CHECK(!cache.getClosestEntry(tree, zone, zoneId, ""));
+
+  // Only the variant of bug.less exists, it is not visible outside its view
+  zone = ZoneName("www.bug.less.");
+  BOOST_CHECK(!cache.getClosestEntry(tree, zone, zoneId, ""));
+  cache.addToView("inner", ZoneName("bug.less..inner"));
+  zone = ZoneName("www.bug.less.");
+  BOOST_REQUIRE(cache.getClosestEntry(tree, zone, zoneId, "inner"));
+  BOOST_CHECK_EQUAL(zone, ZoneName("bug.less..inner"));
+  BOOST_CHECK_EQUAL(zoneId, 3);
+
+  // Changes are picked up by existing readers
+  cache.add(ZoneName("sub.example.org."), 4);
+  zone = ZoneName("a.b.c.sub.example.org.");
+  BOOST_REQUIRE(cache.getClosestEntry(tree, zone, zoneId, ""));
+  BOOST_CHECK_EQUAL(zone, ZoneName("sub.example.org."));
+  BOOST_CHECK_EQUAL(zoneId, 4);
+
+  cache.remove(ZoneName("sub.example.org."));
+  zone = ZoneName("a.b.c.sub.example.org.");
+  BOOST_REQUIRE(cache.getClosestEntry(tree, zone, zoneId, ""));
+  BOOST_CHECK_EQUAL(zone, ZoneName("example.org."));
+  BOOST_CHECK_EQUAL(zoneId, 1);
+
+  cache.add(ZoneName("."), 5);
+  zone = ZoneName("example.com.");
+  BOOST_REQUIRE(cache.getClosestEntry(tree, zone, zoneId, ""));
+  BOOST_CHECK_EQUAL(zone, ZoneName("."));
+  BOOST_CHECK_EQUAL(zoneId, 5);
+
+  cache.clear();
+  zone = ZoneName("example.org.");
+  BOOST_CHECK(!cache.getClosestEntry(tree, zone, zoneId, ""));
+}
+
+BOOST_AUTO_TEST_CASE(test_closest_entry_after_add)
+{
+  AuthZoneCache cache;
+  cache.setRefreshInterval(3600);
+
+  cache.setReplacePending();
+  cache.replace({{ZoneName("example.org."), 1}});
+  auto tree = cache.getLocalSuffixTree();
+
+  // zones added one by one are found before the next replace() rebuilds the tree
+  const size_t count = 10000;
+  vector<std::tuple<ZoneName, domainid_t>> zone_indices{{ZoneName("example.org."), 1}};
+  for (size_t idx = 0; idx < count; idx++) {
+    ZoneName added("zone" + std::to_string(idx) + ".example.org.");
+    cache.add(added, static_cast<domainid_t>(idx + 2));
+    zone_indices.emplace_back(added, static_cast<domainid_t>(idx + 2));
+  }
+  cache.add(ZoneName("bug.less..inner"), 3);
+  zone_indices.emplace_back(ZoneName("bug.less..inner"), 3);
+  cache.addToView("inner", ZoneName("bug.less..inner"));
+  cache.remove(ZoneName("zone0.example.org."));
+  zone_indices.erase(zone_indices.begin() + 1);
+
+  auto check = [&]() {
+    domainid_t zoneId{0};
+    ZoneName zone("www.zone42.example.org.");
+    BOOST_REQUIRE(cache.getClosestEntry(tree, zone, zoneId, ""));
+    BOOST_CHECK_EQUAL(zone, ZoneName("zone42.example.org."));
+    BOOST_CHECK_EQUAL(zoneId, 44);
+
+    zone = ZoneName("www.zone0.example.org.");
+    BOOST_REQUIRE(cache.getClosestEntry(tree, zone, zoneId, ""));
+    BOOST_CHECK_EQUAL(zone, ZoneName("example.org."));
+    BOOST_CHECK_EQUAL(zoneId, 1);
+
+    zone = ZoneName("www.bug.less.");
+    BOOST_CHECK(!cache.getClosestEntry(tree, zone, zoneId, ""));
+    zone = ZoneName("www.bug.less.");
+    BOOST_REQUIRE(cache.getClosestEntry(tree, zone, zoneId, "inner"));
+    BOOST_CHECK_EQUAL(zone, ZoneName("bug.less..inner"));
+    BOOST_CHECK_EQUAL(zoneId, 3);
+
+    zone = ZoneName("example.com.");
+    BOOST_CHECK(!cache.getClosestEntry(tree, zone, zoneId, ""));
+  };
+  check();
+
+  cache.setReplacePending();
+  cache.replace(zone_indices);
+  check();
+}
+
 BOOST_AUTO_TEST_SUITE_END();
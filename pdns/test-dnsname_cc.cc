@@ -8,6 +8,8 @@
 
 #include <cmath>
 #include <numeric>
+#include <random>
+#include <thread>
 #include <unordered_set>
 
 #include "dnsname.hh"
@@ -252,6 +254,66 @@ BOOST_AUTO_TEST_CASE(test_chopping) {
   BOOST_CHECK_EQUAL(w.toString(), "a.root-servers.net.");
 }
 
+#if defined(DNSNAME_INLINE_STORAGE)
+BOOST_AUTO_TEST_CASE(test_inlineStorage) {
+  BOOST_CHECK_EQUAL(sizeof(DNSNameStorage), 64U);
+
+  /* grow a name label by label, well past what fits inside the object, then shrink it back */
+  DNSName name(".");
+  std::vector<std::string> labels;
+  for (size_t idx = 0; idx < 20; ++idx) {
+    labels.push_back("label" + std::to_string(idx));
+    name.prependRawLabel(labels.back());
+    BOOST_CHECK_EQUAL(name.getStorage().isInline(), name.wirelength() <= DNSNameStorage::s_inlineCapacity);
+    BOOST_CHECK_EQUAL(name.getStorage().c_str()[name.wirelength()], '\0');
+
+    DNSName copy(name);
+    BOOST_CHECK_EQUAL(copy, name);
+    DNSName moved(std::move(copy));
+    BOOST_CHECK_EQUAL(moved, name);
+    BOOST_CHECK(copy.empty()); // NOLINT(bugprone-use-after-move,hicpp-invalid-access-moved)
+    copy = moved;
+    BOOST_CHECK_EQUAL(copy, name);
+    copy = std::move(moved);
+    BOOST_CHECK_EQUAL(copy, name);
+    BOOST_CHECK_EQUAL(copy.toString(), name.toString());
+    BOOST_CHECK_EQUAL(DNSName(name.toString()), name);
+  }
+  BOOST_CHECK(!name.getStorage().isInline());
+
+  DNSName longParent(name);
+  longParent.chopOff();
+  BOOST_CHECK(name.isPartOf(longParent));
+  BOOST_CHECK_EQUAL(name.makeRelative(longParent), DNSName("label19"));
+  BOOST_CHECK_EQUAL((DNSName("label19") + longParent), name);
+
+  for (auto label = labels.rbegin(); label != labels.rend(); ++label) {
+    BOOST_CHECK_EQUAL(name.getRawLabel(0), *label);
+    BOOST_CHECK(name.chopOff());
+    BOOST_CHECK_EQUAL(name.getStorage().c_str()[name.wirelength()], '\0');
+  }
+  BOOST_CHECK(name.isRoot());
+
+  DNSNameStorage storage(3, 'a');
+  storage.append("bcd", 3);
+  storage.replace(1, 2, DNSNameStorage("XYZ", 3));
+  BOOST_CHECK_EQUAL(std::string_view(storage), "aXYZbcd");
+  storage.erase(4);
+  BOOST_CHECK_EQUAL(std::string_view(storage), "aXYZ");
+  BOOST_CHECK_EQUAL(storage.compare(1, 3, DNSNameStorage("XYZ", 3)), 0);
+  BOOST_CHECK_THROW(storage.at(4), std::out_of_range);
+  storage.resize(200, 'z');
+  BOOST_CHECK(!storage.isInline());
+  BOOST_CHECK_EQUAL(storage.size(), 200U);
+  BOOST_CHECK_EQUAL(storage.at(199), 'z');
+  storage = storage; // NOLINT(clang-diagnostic-self-assign-overloaded)
+  BOOST_CHECK_EQUAL(storage.size(), 200U);
+  storage.clear();
+  BOOST_CHECK(storage.empty());
+  BOOST_CHECK_EQUAL(storage.c_str()[0], '\0');
+}
+#endif
+
 BOOST_AUTO_TEST_CASE(test_Append) {
   DNSName dn("www."), powerdns("powerdns.com.");
   DNSName tot=dn+powerdns;
@@ -369,6 +431,65 @@ BOOST_AUTO_TEST_CASE(test_hash) {
   BOOST_CHECK(stdev < 10);
 }
 
+BOOST_AUTO_TEST_CASE(test_wordAtATimeHelpers) {
+  /* every byte value that could be mishandled around 'A'..'Z', and the same ones with the high bit set */
+  const std::string interesting("@AMZ[`amz{\x00\x7f\x80\xc0\xc1\xda\xdb\xe1\xfa\xff.-_09");
+  std::mt19937 gen(42); // NOLINT(cert-msc32-c,cert-msc51-cpp): we want reproducible tests
+  std::uniform_int_distribution<size_t> lenDist(0, 300);
+  std::uniform_int_distribution<size_t> charDist(0, interesting.size() - 1);
+
+  auto scalarLower = [](std::string str) {
+    for (auto& chr : str) {
+      chr = static_cast<char>(dns_tolower(chr));
+    }
+    return str;
+  };
+
+  for (size_t iteration = 0; iteration < 10000; ++iteration) {
+    std::string lhs(lenDist(gen), '\0');
+    for (auto& chr : lhs) {
+      chr = interesting.at(charDist(gen));
+    }
+    std::string rhs(lhs);
+    /* flip the case of, or replace, a few random bytes */
+    for (size_t changes = iteration % 4; changes > 0 && !rhs.empty(); --changes) {
+      auto& chr = rhs.at(gen() % rhs.size());
+      if (iteration % 8 < 4 && ((chr >= 'a' && chr <= 'z') || (chr >= 'A' && chr <= 'Z'))) {
+        chr = static_cast<char>(chr ^ 0x20);
+      }
+      else {
+        chr = interesting.at(charDist(gen));
+      }
+    }
+
+    const auto lhsLower = scalarLower(lhs);
+    const auto rhsLower = scalarLower(rhs);
+
+    std::string inPlace(lhs);
+    dns_tolower_inplace(reinterpret_cast<unsigned char*>(inPlace.data()), inPlace.size()); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    BOOST_CHECK_EQUAL(inPlace, lhsLower);
+
+    BOOST_CHECK_EQUAL(burtleCI(lhs, iteration), burtle(reinterpret_cast<const unsigned char*>(lhsLower.data()), lhsLower.size(), iteration)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+
+    int expected = 0;
+    for (size_t idx = 0; idx < std::min(lhs.size(), rhs.size()) && expected == 0; ++idx) {
+      expected = static_cast<int>(static_cast<unsigned char>(lhsLower.at(idx))) - static_cast<int>(static_cast<unsigned char>(rhsLower.at(idx)));
+    }
+    if (expected == 0 && lhs.size() != rhs.size()) {
+      expected = lhs.size() < rhs.size() ? -1 : 1;
+    }
+    BOOST_CHECK_EQUAL(pdns_ilexicographical_compare_three_way(lhs, rhs), expected);
+    BOOST_CHECK_EQUAL(pdns_iequals(lhs, rhs), lhsLower == rhsLower);
+  }
+
+  /* and on whole names, where the label lengths are part of the comparison */
+  BOOST_CHECK(DNSName("AbcdefghijklmnopqrstuvwxyZ.Example.COM") == DNSName("abcdefghijklmnopqrstuvwxyz.example.com"));
+  BOOST_CHECK(DNSName("abcdefghijklmnopqrstuvwxy[.example.com") != DNSName("abcdefghijklmnopqrstuvwxy{.example.com"));
+  BOOST_CHECK(DNSName("abcdefghijklmnopqrstuvwxy@.example.com") != DNSName("abcdefghijklmnopqrstuvwxy`.example.com"));
+  BOOST_CHECK(DNSName("\\192.example.com") != DNSName("\\224.example.com"));
+  BOOST_CHECK_EQUAL(DNSName("wWw.PowerDNS.cOm").makeLowerCase().toString(), "www.powerdns.com.");
+}
+
 BOOST_AUTO_TEST_CASE(test_hashContainer) {
   std::unordered_set<DNSName> s;
   s.insert(DNSName("www.powerdns.com"));
@@ -388,6 +509,82 @@ BOOST_AUTO_TEST_CASE(test_hashContainer) {
 }
 
 
+BOOST_AUTO_TEST_CASE(test_internedNames) {
+  BOOST_CHECK_EQUAL(sizeof(InternedDNSName), sizeof(void*));
+  BOOST_CHECK(InternedDNSName()->empty());
+  BOOST_CHECK(InternedDNSName(DNSName())->empty());
+
+  /* without interning, every handle gets its own copy */
+  {
+    InternedDNSName first(DNSName("ns1.example.net"));
+    InternedDNSName second(DNSName("ns1.example.net"));
+    BOOST_CHECK(&*first != &*second);
+    BOOST_CHECK(first == second);
+    BOOST_CHECK_EQUAL(InternedDNSName::getInternedCount(), 0U);
+  }
+
+  InternedDNSName::setInterning(true);
+  {
+    InternedDNSName first(DNSName("ns1.example.net"));
+    InternedDNSName second(DNSName("ns1.example.net"));
+    InternedDNSName upper(DNSName("NS1.example.net"));
+    BOOST_CHECK_EQUAL(&*first, &*second);
+    BOOST_CHECK(&*first != &*upper);
+    BOOST_CHECK_EQUAL(upper->toString(), "NS1.example.net.");
+    BOOST_CHECK(first == upper);
+    BOOST_CHECK_EQUAL(InternedDNSName::getInternedCount(), 2U);
+    BOOST_CHECK_LT(first.sizeEstimate(), InternedDNSName(DNSName("ns2.example.net")).sizeEstimate());
+
+    InternedDNSName copy(first);
+    InternedDNSName moved(std::move(second));
+    BOOST_CHECK_EQUAL(&*copy, &*moved);
+    first = InternedDNSName();
+    copy = upper;
+    BOOST_CHECK_EQUAL(InternedDNSName::getInternedCount(), 2U);
+    moved = InternedDNSName();
+    BOOST_CHECK_EQUAL(InternedDNSName::getInternedCount(), 1U);
+
+    /* record contents parsed from a packet or from text share their targets */
+    auto fromText = std::dynamic_pointer_cast<const NSRecordContent>(DNSRecordContent::make(QType::NS, QClass::IN, "ns.example.org."));
+    BOOST_REQUIRE(fromText);
+    vector<uint8_t> packet;
+    DNSPacketWriter writer(packet, DNSName("example.org"), QType::NS);
+    writer.getHeader()->qr = 1;
+    writer.startRecord(DNSName("example.org"), QType::NS);
+    fromText->toPacket(writer);
+    writer.commit();
+    MOADNSParser parser(false, reinterpret_cast<const char*>(packet.data()), packet.size()); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    BOOST_REQUIRE_EQUAL(parser.d_answers.size(), 1U);
+    auto fromPacket = getRR<NSRecordContent>(parser.d_answers.at(0));
+    BOOST_REQUIRE(fromPacket);
+    BOOST_CHECK_EQUAL(&fromText->getNS(), &fromPacket->getNS());
+    BOOST_CHECK_EQUAL(fromPacket->getNS().toString(), "ns.example.org.");
+  }
+  BOOST_CHECK_EQUAL(InternedDNSName::getInternedCount(), 0U);
+
+  /* names are released and re-interned concurrently */
+  std::atomic<size_t> mismatches{0};
+  std::vector<std::thread> threads;
+  for (size_t idx = 0; idx < 4; ++idx) {
+    threads.emplace_back([&mismatches] {
+      for (size_t iteration = 0; iteration < 20000; ++iteration) {
+        const auto name = "ns" + std::to_string(iteration % 16) + ".example.net.";
+        InternedDNSName interned(DNSName{name});
+        InternedDNSName copy(interned);
+        if (copy->toString() != name) {
+          ++mismatches;
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  BOOST_CHECK_EQUAL(mismatches.load(), 0U);
+  BOOST_CHECK_EQUAL(InternedDNSName::getInternedCount(), 0U);
+  InternedDNSName::setInterning(false);
+}
+
 BOOST_AUTO_TEST_CASE(test_QuestionHash) {
   vector<unsigned char> packet(sizeof(dnsheader));
 
@@ -668,6 +865,49 @@ BOOST_AUTO_TEST_CASE(test_suffixmatch_tree) {
   BOOST_CHECK_EQUAL(count, 0U);
 }
 
+BOOST_AUTO_TEST_CASE(test_suffixmatch_compiled) {
+  SuffixMatchTree<DNSName> smt;
+  const std::vector<DNSName> names{DNSName("ezdns.it."), DNSName("org."), DNSName("news.bbc.co.uk."), DNSName("a.powerdns.com."), DNSName("b.powerdns.com."), DNSName("example.net."), DNSName("net."), DNSName("www.sub.domain.fr.")};
+  for (const auto& name : names) {
+    smt.add(name, DNSName(name));
+  }
+
+  const std::vector<DNSName> lookups{DNSName("www.ezdns.it."), DNSName("www.powerdns.com."), DNSName("www.powerdns.oRG."), DNSName("NEWS.bbc.co.uk."), DNSName("www.www.www.news.bbc.co.uk."), DNSName("images.bbc.co.uk."), DNSName("uk."), DNSName("a.powerdns.com."), DNSName("c.powerdns.com."), DNSName("www.example.net."), DNSName("example.com."), DNSName("domain.fr."), DNSName("sub.domain.fr."), DNSName("x.www.sub.domain.fr."), g_rootdnsname, DNSName()};
+
+  auto check = [&lookups](const SuffixMatchTree<DNSName>& tree) {
+    CompiledSuffixMatchTree<DNSName> compiled(tree);
+    for (const auto& name : lookups) {
+      const auto* expected = tree.lookup(name);
+      const auto* got = compiled.lookup(name);
+      BOOST_REQUIRE_EQUAL(got == nullptr, expected == nullptr);
+      if (expected != nullptr) {
+        BOOST_CHECK_EQUAL(*got, *expected);
+      }
+    }
+  };
+
+  check(smt);
+  smt.add(g_rootdnsname, DNSName(g_rootdnsname));
+  check(smt);
+  smt.remove(DNSName("net."));
+  smt.remove(g_rootdnsname);
+  check(smt);
+  check(SuffixMatchTree<DNSName>());
+
+  SuffixMatchNode smn;
+  smn.add(DNSName("powerdns.com."));
+  smn.compile();
+  BOOST_CHECK(smn.check(DNSName("www.PowerDNS.com.")));
+  BOOST_CHECK(!smn.check(DNSName("powerdns.net.")));
+  /* the compiled form is dropped on changes */
+  smn.add(DNSName("powerdns.net."));
+  BOOST_CHECK(smn.check(DNSName("powerdns.net.")));
+  smn.compile();
+  BOOST_CHECK(smn.check(DNSName("powerdns.net.")));
+  smn.remove(DNSName("powerdns.com."));
+  BOOST_CHECK(!smn.check(DNSName("www.powerdns.com.")));
+}
+
 
 BOOST_AUTO_TEST_CASE(test_concat) {
   DNSName first("www."), second("powerdns.com.");
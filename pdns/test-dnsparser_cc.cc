@@ -616,4 +616,135 @@ BOOST_AUTO_TEST_CASE(test_clearDNSPacketUnsafeRecordTypes) {
 
 }
 
+BOOST_AUTO_TEST_CASE(test_DNSMessageView) {
+  const DNSName name("powerdns.com.");
+  const DNSName mxname("mx.powerdns.com.");
+  const ComboAddress v4("192.0.2.1");
+
+  vector<uint8_t> packet;
+  DNSPacketWriter pwR(packet, name, QType::MX, QClass::IN, 0);
+  pwR.getHeader()->qr = 1;
+  pwR.getHeader()->aa = 1;
+
+  pwR.startRecord(name, QType::MX, 3600, QClass::IN, DNSResourceRecord::ANSWER);
+  pwR.xfr16BitInt(10);
+  pwR.xfrName(mxname, true);
+  pwR.commit();
+  pwR.startRecord(name, QType::NS, 7200, QClass::IN, DNSResourceRecord::AUTHORITY);
+  pwR.xfrName(DNSName("ns1.powerdns.com."), true);
+  pwR.commit();
+  pwR.startRecord(mxname, QType::A, 300, QClass::IN, DNSResourceRecord::ADDITIONAL);
+  pwR.xfrIP(v4.sin4.sin_addr.s_addr);
+  pwR.commit();
+  pwR.addOpt(1232, 0, 0);
+  pwR.commit();
+
+  const std::string_view wire(reinterpret_cast<const char*>(packet.data()), packet.size());
+  DNSMessageView view(false, wire);
+  MOADNSParser mdp(false, std::string(wire));
+
+  BOOST_CHECK_EQUAL(view.getHeader().aa, 1U);
+  BOOST_CHECK_EQUAL(view.getHeader().ancount, 1U);
+  BOOST_CHECK_EQUAL(view.getHeader().nscount, 1U);
+  BOOST_CHECK_EQUAL(view.getHeader().arcount, 2U);
+  BOOST_CHECK(view.hasQuestion());
+  BOOST_CHECK_EQUAL(view.getQName(), name);
+  BOOST_CHECK(view.isQName(DNSName("PowerDNS.COM.")));
+  BOOST_CHECK(!view.isQName(mxname));
+  BOOST_CHECK(!view.isQName(DNSName("com.")));
+  BOOST_CHECK(!view.isQName(DNSName()));
+  BOOST_CHECK_EQUAL(view.getQType(), QType::MX);
+  BOOST_CHECK_EQUAL(view.getQClass(), QClass::IN);
+  BOOST_CHECK(view.hasEDNS());
+
+  BOOST_REQUIRE_EQUAL(view.getRecords().size(), mdp.d_answers.size());
+  for (size_t idx = 0; idx < mdp.d_answers.size(); idx++) {
+    const auto& expected = mdp.d_answers.at(idx);
+    const auto& record = view.getRecords().at(idx);
+    BOOST_CHECK(view.nameEquals(record.d_nameOffset, expected.d_name));
+    BOOST_CHECK(!view.nameEquals(record.d_nameOffset, DNSName("example.net.")));
+    BOOST_CHECK_EQUAL(record.d_type, expected.d_type);
+    BOOST_CHECK_EQUAL(record.d_class, expected.d_class);
+    BOOST_CHECK_EQUAL(record.d_ttl, expected.d_ttl);
+    BOOST_CHECK_EQUAL(record.d_contentLength, expected.d_clen);
+    BOOST_CHECK_EQUAL(record.d_place, expected.d_place);
+
+    const auto dnsRecord = view.getRecord(record);
+    BOOST_CHECK_EQUAL(dnsRecord.d_name, expected.d_name);
+    BOOST_CHECK_EQUAL(dnsRecord.d_type, expected.d_type);
+    BOOST_CHECK_EQUAL(dnsRecord.d_clen, expected.d_clen);
+    BOOST_CHECK_EQUAL(dnsRecord.getContent()->getZoneRepresentation(), expected.getContent()->getZoneRepresentation());
+    BOOST_CHECK_EQUAL(view.getContent(record)->getZoneRepresentation(), expected.getContent()->getZoneRepresentation());
+  }
+  BOOST_CHECK_EQUAL(view.getRawContent(view.getRecords().at(2)), std::string_view(reinterpret_cast<const char*>(&v4.sin4.sin_addr.s_addr), 4));
+}
+
+BOOST_AUTO_TEST_CASE(test_DNSMessageView_ManyRecords) {
+  const DNSName name("powerdns.com.");
+
+  vector<uint8_t> packet;
+  DNSPacketWriter pwR(packet, name, QType::A, QClass::IN, 0);
+  pwR.getHeader()->qr = 1;
+  for (uint32_t idx = 0; idx < 1000; idx++) {
+    pwR.startRecord(DNSName(std::to_string(idx)) + name, QType::A, idx, QClass::IN, DNSResourceRecord::ANSWER);
+    pwR.xfrIP(htonl(idx));
+    pwR.commit();
+  }
+
+  DNSMessageView view(false, std::string_view(reinterpret_cast<const char*>(packet.data()), packet.size()));
+  BOOST_REQUIRE_EQUAL(view.getRecords().size(), 1000U);
+  for (uint32_t idx = 0; idx < 1000; idx++) {
+    const auto& record = view.getRecords().at(idx);
+    BOOST_CHECK_EQUAL(record.d_ttl, idx);
+    BOOST_CHECK(view.nameEquals(record.d_nameOffset, DNSName(std::to_string(idx)) + name));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_DNSMessageView_Invalid) {
+  const DNSName name("powerdns.com.");
+
+  auto generatePacket = [&name](bool truncated) {
+    vector<uint8_t> packet;
+    DNSPacketWriter pwR(packet, name, QType::A, QClass::IN, 0);
+    pwR.getHeader()->qr = 1;
+    pwR.getHeader()->tc = truncated;
+    for (uint32_t idx = 0; idx < 3; idx++) {
+      pwR.startRecord(name, QType::A, 3600, QClass::IN, DNSResourceRecord::ANSWER);
+      pwR.xfrIP(htonl(idx));
+      pwR.commit();
+    }
+    return packet;
+  };
+
+  {
+    /* cut in the middle of the last record */
+    auto packet = generatePacket(false);
+    packet.resize(packet.size() - 2);
+    BOOST_CHECK_THROW(DNSMessageView(false, std::string_view(reinterpret_cast<const char*>(packet.data()), packet.size())), MOADNSException);
+  }
+
+  {
+    /* same but with the TC bit set, we keep what we could parse */
+    auto packet = generatePacket(true);
+    packet.resize(packet.size() - 2);
+    DNSMessageView view(false, std::string_view(reinterpret_cast<const char*>(packet.data()), packet.size()));
+    MOADNSParser mdp(false, reinterpret_cast<const char*>(packet.data()), packet.size());
+    BOOST_CHECK_EQUAL(view.getRecords().size(), 2U);
+    BOOST_CHECK_EQUAL(view.getHeader().ancount, mdp.d_header.ancount);
+  }
+
+  {
+    /* compression pointer to itself */
+    auto packet = generatePacket(false);
+    const size_t firstRecord = sizeof(dnsheader) + name.wirelength() + 4;
+    packet.at(firstRecord) = 0xc0;
+    packet.at(firstRecord + 1) = firstRecord;
+    BOOST_CHECK_THROW(DNSMessageView(false, std::string_view(reinterpret_cast<const char*>(packet.data()), packet.size())), MOADNSException);
+  }
+
+  {
+    BOOST_CHECK_THROW(DNSMessageView(false, std::string_view("tooshort")), MOADNSException);
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -13,6 +13,7 @@
 
 #include "dnswriter.hh"
 #include "dnsparser.hh"
+#include "dnsrecords.hh"
 
 BOOST_AUTO_TEST_SUITE(test_dnswriter_cc)
 
@@ -81,6 +82,98 @@ BOOST_AUTO_TEST_CASE(test_compressionBoundary) {
   BOOST_CHECK_NO_THROW(MOADNSParser mdp(false, spacket));
 }
 
+BOOST_AUTO_TEST_CASE(test_compressionRollback) {
+  DNSName name("powerdns.com.");
+
+  vector<uint8_t> packet;
+  DNSPacketWriter pwR(packet, name, QType::A, QClass::IN, 0);
+  pwR.getHeader()->qr = 1;
+
+  pwR.startRecord(DNSName("www.PowerDNS.com."), QType::CNAME, 3600, QClass::IN, DNSResourceRecord::ANSWER);
+  pwR.xfrName(DNSName("rolled.back.example.net."), true);
+  pwR.rollback();
+  BOOST_CHECK_EQUAL(pwR.size(), 30U);
+
+  /* the name we rolled back is gone, and should not be used for compression */
+  pwR.startRecord(DNSName("www.PowerDNS.com."), QType::A, 3600, QClass::IN, DNSResourceRecord::ANSWER);
+  pwR.xfrIP('P'<<24 |
+            'Q'<<16 |
+            'R'<<8  |
+            'S');
+  pwR.commit();
+  pwR.startRecord(DNSName("back.example.net."), QType::CNAME, 3600, QClass::IN, DNSResourceRecord::ANSWER);
+  pwR.xfrName(DNSName("WWW.powerdns.COM."), true);
+  pwR.commit();
+  /* 30 + 6 + 10 + 4, then 18 + 10 + 2 */
+  BOOST_CHECK_EQUAL(pwR.size(), 80U);
+
+  string spacket(packet.begin(), packet.end());
+  MOADNSParser mdp(false, spacket);
+  BOOST_REQUIRE_EQUAL(mdp.d_answers.size(), 2U);
+  BOOST_CHECK_EQUAL(mdp.d_answers.at(1).d_name, DNSName("back.example.net."));
+  BOOST_CHECK_EQUAL(getRR<CNAMERecordContent>(mdp.d_answers.at(1))->getTarget(), DNSName("www.powerdns.com."));
+}
+
+BOOST_AUTO_TEST_CASE(test_compressionManyNames) {
+  DNSName name("example.com.");
+
+  vector<uint8_t> packet;
+  DNSPacketWriter pwR(packet, name, QType::AXFR, QClass::IN, 0);
+  pwR.getHeader()->qr = 1;
+
+  vector<DNSName> names;
+  for (size_t idx = 0; idx < 1000; idx++) {
+    names.emplace_back("host-" + std::to_string(idx % 100) + ".sub-" + std::to_string(idx % 7) + ".example.com.");
+    pwR.startRecord(names.back(), QType::CNAME, 3600, QClass::IN, DNSResourceRecord::ANSWER);
+    pwR.xfrName(DNSName("target-" + std::to_string(idx % 13) + ".sub-" + std::to_string(idx % 5) + ".example.com."), true);
+    pwR.commit();
+  }
+
+  string spacket(packet.begin(), packet.end());
+  MOADNSParser mdp(false, spacket);
+  BOOST_REQUIRE_EQUAL(mdp.d_answers.size(), names.size());
+  for (size_t idx = 0; idx < names.size(); idx++) {
+    BOOST_CHECK_EQUAL(mdp.d_answers.at(idx).d_name, names.at(idx));
+    BOOST_CHECK_EQUAL(getRR<CNAMERecordContent>(mdp.d_answers.at(idx))->getTarget(), DNSName("target-" + std::to_string(idx % 13) + ".sub-" + std::to_string(idx % 5) + ".example.com."));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_compressionSmallAndLargePackets) {
+  /* small packets are scanned and larger ones go through the compression table,
+     both should point to the first occurrence of a name */
+  for (size_t count : {3, 30}) {
+    vector<uint8_t> packet;
+    DNSPacketWriter pwR(packet, DNSName("example.com."), QType::A, QClass::IN, 0);
+    pwR.getHeader()->qr = 1;
+
+    /* 12 bytes of header, 13 + 4 for the question */
+    const size_t firstRecord = 29;
+    for (size_t idx = 0; idx < count; idx++) {
+      pwR.startRecord(DNSName("host" + std::to_string(idx % 10) + "-" + std::to_string(idx / 10) + ".example.com."), QType::A, 3600, QClass::IN, DNSResourceRecord::ANSWER);
+      pwR.xfrIP(htonl(0xc0000201));
+      pwR.commit();
+    }
+    const size_t lastRecord = pwR.size();
+    /* 8 + 2 for the name, pointing to the question */
+    BOOST_CHECK_EQUAL(lastRecord, firstRecord + count * (10 + 10 + 4));
+
+    pwR.startRecord(DNSName("HOST1-0.example.COM."), QType::A, 3600, QClass::IN, DNSResourceRecord::ANSWER);
+    pwR.xfrIP(htonl(0xc0000202));
+    pwR.commit();
+    BOOST_CHECK_EQUAL(pwR.size(), lastRecord + 2 + 10 + 4);
+
+    /* the second record */
+    const uint16_t target = firstRecord + 10 + 10 + 4;
+    BOOST_CHECK_EQUAL(static_cast<unsigned int>(packet.at(lastRecord)), 0xc0U | (target >> 8));
+    BOOST_CHECK_EQUAL(static_cast<unsigned int>(packet.at(lastRecord + 1)), target & 0xffU);
+
+    string spacket(packet.begin(), packet.end());
+    MOADNSParser mdp(false, spacket);
+    BOOST_REQUIRE_EQUAL(mdp.d_answers.size(), count + 1);
+    BOOST_CHECK_EQUAL(mdp.d_answers.back().d_name, DNSName("host1-0.example.com."));
+  }
+}
+
 BOOST_AUTO_TEST_CASE(test_xfrSvcParamKeyVals_mandatory) {
   DNSName name("powerdns.com.");
   vector<uint8_t> packet;
@@ -9,6 +9,7 @@
 #endif
 #include <boost/test/unit_test.hpp>
 #include <bitset>
+#include <random>
 #include "iputils.hh"
 
 using namespace boost;
@@ -622,6 +623,133 @@ BOOST_AUTO_TEST_CASE(test_removal) {
   BOOST_CHECK(nmt.empty());
 }
 
+BOOST_AUTO_TEST_CASE(test_CompiledNetmaskTree) {
+  NetmaskTree<int> nmt;
+  std::mt19937 gen(42);
+  std::vector<ComboAddress> addresses;
+
+  auto randomAddress = [&gen](bool v6) {
+    ComboAddress address(v6 ? "::" : "0.0.0.0");
+    auto* bytes = v6 ? reinterpret_cast<uint8_t*>(&address.sin6.sin6_addr.s6_addr) : reinterpret_cast<uint8_t*>(&address.sin4.sin_addr.s_addr);
+    const size_t len = v6 ? 16 : 4;
+    for (size_t idx = 0; idx < len; idx++) {
+      /* restrict the first byte so that prefixes actually overlap */
+      bytes[idx] = idx == 0 ? (gen() % 4) : (gen() % 256);
+    }
+    return address;
+  };
+
+  for (int idx = 0; idx < 5000; idx++) {
+    const bool v6 = idx % 2 == 1;
+    const auto address = randomAddress(v6);
+    const uint8_t bits = gen() % ((v6 ? 128 : 32) + 1);
+    nmt.insert(Netmask(address, bits)).second = idx;
+    addresses.push_back(address);
+  }
+  nmt.insert(Netmask("192.0.2.0/24")).second = -1;
+  nmt.insert(Netmask("192.0.2.1/32")).second = -2;
+  nmt.insert(Netmask("2001:db8::/32")).second = -3;
+
+  CompiledNetmaskTree<int> compiled(nmt);
+  BOOST_CHECK_EQUAL(compiled.size(), nmt.size());
+
+  for (int idx = 0; idx < 20000; idx++) {
+    addresses.push_back(randomAddress(idx % 2 == 1));
+  }
+  addresses.emplace_back("192.0.2.1");
+  addresses.emplace_back("192.0.2.2");
+  addresses.emplace_back("192.0.3.2");
+  addresses.emplace_back("2001:db8::1");
+  addresses.emplace_back("::ffff:192.0.2.1");
+  addresses.emplace_back("255.255.255.255");
+  addresses.emplace_back("ffff:ffff:ffff:ffff:ffff:ffff:ffff:ffff");
+
+  for (const auto& address : addresses) {
+    const auto* expected = nmt.lookup(address);
+    const auto* got = compiled.lookup(address);
+    BOOST_REQUIRE_EQUAL(expected == nullptr, got == nullptr);
+    if (expected != nullptr) {
+      BOOST_CHECK_EQUAL(got->first.toString(), expected->first.toString());
+      BOOST_CHECK_EQUAL(got->second, expected->second);
+    }
+  }
+  BOOST_CHECK_EQUAL(compiled.lookup(ComboAddress("192.0.2.1"))->second, -2);
+  BOOST_CHECK_EQUAL(compiled.lookup(ComboAddress("192.0.2.2"))->second, -1);
+
+  /* a default route covers everything that is not more specific */
+  NetmaskTree<int> defaults;
+  defaults.insert(Netmask("0.0.0.0/0")).second = 4;
+  defaults.insert(Netmask("10.0.0.0/9")).second = 9;
+  CompiledNetmaskTree<int> compiledDefaults(defaults);
+  BOOST_CHECK_EQUAL(compiledDefaults.lookup(ComboAddress("10.127.0.1"))->second, 9);
+  BOOST_CHECK_EQUAL(compiledDefaults.lookup(ComboAddress("10.128.0.1"))->second, 4);
+  BOOST_CHECK_EQUAL(compiledDefaults.lookup(ComboAddress("255.0.0.1"))->second, 4);
+  BOOST_CHECK(compiledDefaults.lookup(ComboAddress("::1")) == nullptr);
+
+  /* NetmaskGroup uses the compiled form until it is modified */
+  NetmaskGroup ng;
+  ng.toMasks("127.0.0.0/8, 10.0.0.0/24, !10.0.0.128/25, ::1");
+  ng.compile();
+  BOOST_CHECK(ng.match(ComboAddress("127.0.0.1")));
+  BOOST_CHECK(ng.match(ComboAddress("10.0.0.1")));
+  BOOST_CHECK(!ng.match(ComboAddress("10.0.0.129")));
+  BOOST_CHECK(ng.match(ComboAddress("::1")));
+  BOOST_CHECK(!ng.match(ComboAddress("::2")));
+  Netmask matched;
+  BOOST_CHECK(!ng.lookup(ComboAddress("10.0.0.129"), &matched));
+  BOOST_CHECK_EQUAL(matched.toString(), "10.0.0.128/25");
+  NetmaskGroup copy(ng);
+  ng.addMask("::2");
+  ng.deleteMask("127.0.0.0/8");
+  BOOST_CHECK(ng.match(ComboAddress("::2")));
+  BOOST_CHECK(!ng.match(ComboAddress("127.0.0.1")));
+  BOOST_CHECK(!copy.match(ComboAddress("::2")));
+  BOOST_CHECK(copy.match(ComboAddress("127.0.0.1")));
+  ng.compile();
+  BOOST_CHECK(ng.match(ComboAddress("::2")));
+  BOOST_CHECK(!ng.match(ComboAddress("127.0.0.1")));
+  ng.clear();
+  BOOST_CHECK(!ng.match(ComboAddress("::2")));
+}
+
+BOOST_AUTO_TEST_CASE(test_CompiledNetmaskTreeMemoryLimit) {
+  /* the two roots, then one node for each of the 15 bytes after the first one */
+  NetmaskTree<bool> single;
+  single.insert(Netmask("2001:db8::1/128")).second = true;
+  CompiledNetmaskTree<bool> compiledSingle(single);
+  BOOST_CHECK_GE(compiledSingle.getMemoryUsage(), 17 * 256 * sizeof(uint32_t));
+  BOOST_CHECK_LT(compiledSingle.getMemoryUsage(), 18 * 256 * sizeof(uint32_t));
+  BOOST_CHECK_THROW(CompiledNetmaskTree<bool>(single, 16 * 256 * sizeof(uint32_t)), std::length_error);
+
+  NetmaskGroup ng;
+  for (unsigned int idx = 0; idx < 100; idx++) {
+    ng.addMask(Netmask(ComboAddress("2001:db8:" + std::to_string(idx) + "::1"), 128));
+  }
+  ng.addMask("192.0.2.0/24");
+
+  /* too large, we keep using the tree */
+  BOOST_CHECK(!ng.compile(64 * 1024));
+  BOOST_CHECK(!ng.isCompiled());
+  BOOST_CHECK(ng.match(ComboAddress("2001:db8:42::1")));
+  BOOST_CHECK(!ng.match(ComboAddress("2001:db8:42::2")));
+  BOOST_CHECK(ng.match(ComboAddress("192.0.2.1")));
+
+  BOOST_CHECK(ng.compile());
+  BOOST_CHECK(ng.isCompiled());
+  BOOST_CHECK(ng.match(ComboAddress("2001:db8:42::1")));
+  BOOST_CHECK(!ng.match(ComboAddress("2001:db8:42::2")));
+  BOOST_CHECK(ng.match(ComboAddress("192.0.2.1")));
+
+  NetmaskTree<bool> tree;
+  for (unsigned int idx = 0; idx < 100; idx++) {
+    tree.insert(Netmask(ComboAddress("2001:db8:" + std::to_string(idx) + "::1"), 128)).second = true;
+  }
+  const size_t limit = 512 * 1024;
+  BOOST_CHECK_THROW(CompiledNetmaskTree<bool>(tree, limit), std::length_error);
+  CompiledNetmaskTree<bool> compiled(tree, 2 * 1024 * 1024);
+  BOOST_CHECK_LE(compiled.getMemoryUsage(), 2U * 1024 * 1024);
+}
+
 BOOST_AUTO_TEST_CASE(test_iterator) {
   NetmaskTree<int> masks_set1;
   std::set<Netmask> masks_set2;
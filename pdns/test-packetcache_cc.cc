@@ -76,6 +76,45 @@ BOOST_AUTO_TEST_CASE(test_AuthQueryCacheSimple) {
 
 }
 
+BOOST_AUTO_TEST_CASE(test_AuthQueryCacheLocal) {
+  AuthQueryCache QC;
+  QC.setMaxEntries(1000000);
+  AuthQueryCache::LocalCache local(16);
+
+  DNSZoneRecord record;
+  record.dr.d_name = DNSName("hello");
+  record.dr.d_type = QType::A;
+  vector<DNSZoneRecord> records{record};
+  vector<DNSZoneRecord> entry;
+
+  uint64_t localHits = S.read("query-cache-local-hit");
+
+  /* an entry inserted through the local cache is served from it */
+  QC.insert(local, DNSName("hello"), QType(QType::A), vector<DNSZoneRecord>(records), 3600, 1);
+  BOOST_CHECK_EQUAL(QC.size(), 1U);
+  BOOST_CHECK(QC.getEntry(local, DNSName("HELLO"), QType(QType::A), entry, 1));
+  BOOST_CHECK_EQUAL(entry.size(), 1U);
+  BOOST_CHECK_EQUAL(S.read("query-cache-local-hit"), localHits + 1);
+  BOOST_CHECK(!QC.getEntry(local, DNSName("hello"), QType(QType::AAAA), entry, 1));
+  BOOST_CHECK(!QC.getEntry(local, DNSName("hello"), QType(QType::A), entry, 2));
+
+  /* a purge of the shared cache invalidates the local copies */
+  BOOST_CHECK_EQUAL(QC.purge("hello"), 1U);
+  BOOST_CHECK(!QC.getEntry(local, DNSName("hello"), QType(QType::A), entry, 1));
+
+  /* an entry found in the shared cache is copied into the local one */
+  QC.insert(DNSName("world"), QType(QType::SOA), vector<DNSZoneRecord>(), 3600, 1);
+  BOOST_CHECK(QC.getEntry(local, DNSName("world"), QType(QType::SOA), entry, 1));
+  BOOST_CHECK(entry.empty());
+  BOOST_CHECK_EQUAL(S.read("query-cache-local-hit"), localHits + 1);
+  BOOST_CHECK(QC.getEntry(local, DNSName("world"), QType(QType::SOA), entry, 1));
+  BOOST_CHECK_EQUAL(S.read("query-cache-local-hit"), localHits + 2);
+
+  BOOST_CHECK_EQUAL(QC.purge(), 1U);
+  BOOST_CHECK(!QC.getEntry(local, DNSName("world"), QType(QType::SOA), entry, 1));
+  BOOST_CHECK_EQUAL(S.read("query-cache-local-hit"), localHits + 2);
+}
+
 static AuthQueryCache* g_QC;
 static AtomicCounter g_QCmissing;
 
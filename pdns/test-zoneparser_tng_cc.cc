@@ -223,4 +223,142 @@ BOOST_AUTO_TEST_CASE(test_tng_upgrade) {
   BOOST_CHECK_EQUAL(rr.content, std::string("192.0.3.4"));
 }
 
+static std::string writeTemporaryZone(const std::string& content)
+{
+  char path[] = "/tmp/pdns-test-zone.XXXXXX";
+  int fd = mkstemp(path);
+  if (fd < 0) {
+    BOOST_FAIL("Unable to generate a temporary file");
+  }
+  close(fd);
+  std::ofstream ofs(path);
+  ofs << content;
+  ofs.close();
+  return path;
+}
+
+struct ParsedZone
+{
+  std::vector<std::tuple<std::string, uint16_t, uint32_t, std::string, std::string>> records;
+  std::string error;
+  std::pair<std::string, int> errorLine;
+};
+
+static ParsedZone parseZoneFile(const std::string& path, size_t threads)
+{
+  ParsedZone result;
+  ZoneParserTNG zoneparser(path, ZoneName("example.com"));
+  zoneparser.setParallelThreads(threads);
+  DNSResourceRecord rr;
+  std::string comment;
+  try {
+    while (zoneparser.get(rr, &comment)) {
+      result.records.emplace_back(rr.qname.toString(), rr.qtype.getCode(), rr.ttl, rr.content, comment);
+    }
+  }
+  catch (const std::exception& e) {
+    result.error = e.what();
+    result.errorLine = zoneparser.getLineNumAndFile();
+  }
+  catch (const PDNSException& e) {
+    result.error = e.reason;
+    result.errorLine = zoneparser.getLineNumAndFile();
+  }
+  return result;
+}
+
+BOOST_AUTO_TEST_CASE(test_tng_parallel) {
+  std::string zone = "$TTL 3600\n"
+                     "@ IN SOA ns1 hostmaster (\n"
+                     "  2024010101 ; serial\n"
+                     "  3600 600 86400\n"
+                     "  300 )\n"
+                     "@ NS ns1\n";
+  for (size_t idx = 0; idx < 60000; idx++) {
+    const auto name = "host" + std::to_string(idx);
+    zone += name + " 300 IN A 192.0.2." + std::to_string(idx % 256) + "\n";
+    zone += "  IN AAAA 2001:db8::" + std::to_string(idx % 65536) + " ; comment " + std::to_string(idx) + "\n";
+    if (idx % 7 == 0) {
+      zone += name + " IN TXT \"some ( text\" ( \"continued\"\n  \"on ) several\"\n  \"lines\" )\n";
+    }
+    if (idx % 1000 == 0) {
+      zone += "$ORIGIN sub" + std::to_string(idx) + ".example.com.\n";
+      zone += "$TTL " + std::to_string(idx + 1) + "\n";
+    }
+    if (idx % 5000 == 0) {
+      zone += "$GENERATE 1-10 gen" + std::to_string(idx) + "-$ CNAME " + name + "\n";
+    }
+    zone += "; a comment line\n\n";
+    zone += name + " MX 10 mail\n";
+  }
+
+  const auto path = writeTemporaryZone(zone);
+  const auto serial = parseZoneFile(path, 1);
+  const auto parallel = parseZoneFile(path, 4);
+  BOOST_CHECK_GT(serial.records.size(), 180000U);
+  BOOST_CHECK(serial.error.empty());
+  BOOST_CHECK(parallel.error.empty());
+  BOOST_REQUIRE_EQUAL(serial.records.size(), parallel.records.size());
+  BOOST_CHECK(serial.records == parallel.records);
+
+  /* a broken record near the end, the records before it are returned first in both cases */
+  zone += "broken IN NOTATYPE 192.0.2.1\n";
+  zone += "after IN A 192.0.2.1\n";
+  const auto brokenPath = writeTemporaryZone(zone);
+  const auto brokenSerial = parseZoneFile(brokenPath, 1);
+  const auto brokenParallel = parseZoneFile(brokenPath, 4);
+  BOOST_CHECK(!brokenSerial.error.empty());
+  BOOST_CHECK_EQUAL(brokenSerial.error, brokenParallel.error);
+  BOOST_CHECK_EQUAL(brokenSerial.errorLine.second, brokenParallel.errorLine.second);
+  BOOST_CHECK(brokenSerial.records == brokenParallel.records);
+
+  unlink(path.c_str());
+  unlink(brokenPath.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(test_tng_parallel_include) {
+  const auto includePath = writeTemporaryZone("included1 IN A 192.0.2.1\n"
+                                              "\n"
+                                              "included2 IN A 192.0.2.2\n");
+  std::string zone = "$TTL 3600\n"
+                     "@ IN SOA ns1 hostmaster 2024010101 3600 600 86400 300\n";
+  for (size_t idx = 0; idx < 100000; idx++) {
+    zone += "host" + std::to_string(idx) + " 300 IN A 192.0.2." + std::to_string(idx % 256) + "\n";
+    if (idx == 90000) {
+      zone += "$INCLUDE " + includePath + "\n";
+    }
+  }
+  zone += "last IN A 192.0.2.3\n";
+  const auto path = writeTemporaryZone(zone);
+
+  auto getLocations = [&path, &includePath](size_t threads) {
+    std::vector<std::pair<std::string, int>> locations;
+    ZoneParserTNG zoneparser(path, ZoneName("example.com"));
+    zoneparser.setParallelThreads(threads);
+    DNSResourceRecord rr;
+    while (zoneparser.get(rr)) {
+      locations.push_back(zoneparser.getLineNumAndFile());
+      if (rr.qname.toString() == "included2.example.com.") {
+        /* the name of the included file and the line in that file */
+        BOOST_CHECK_EQUAL(locations.back().first, includePath);
+        BOOST_CHECK_EQUAL(locations.back().second, 3);
+        BOOST_CHECK_EQUAL(zoneparser.getLineOfFile(), "on line 3 of file '" + includePath + "'");
+      }
+      else if (rr.qname.toString() == "last.example.com.") {
+        BOOST_CHECK_EQUAL(locations.back().first, path);
+        BOOST_CHECK_EQUAL(locations.back().second, 100004);
+      }
+    }
+    return locations;
+  };
+
+  const auto serial = getLocations(1);
+  const auto parallel = getLocations(4);
+  BOOST_CHECK_EQUAL(serial.size(), 100004U);
+  BOOST_CHECK(serial == parallel);
+
+  unlink(path.c_str());
+  unlink(includePath.c_str());
+}
+
 BOOST_AUTO_TEST_SUITE_END();
@@ -548,25 +548,27 @@ bool UeberBackend::getAuth(const ZoneName& target, const QType& qtype, SOAData*
     domainid_t zoneId{UnknownDomainID};
 
     if (cachedOk && g_zoneCache.isEnabled()) {
-      std::string variant = g_zoneCache.getVariantFromView(shorter, view);
-      ZoneName _shorter(shorter.operator const DNSName&(), variant);
-      if (g_zoneCache.getEntry(_shorter, zoneId)) {
-        if (fillSOAFromZoneRecord(_shorter, zoneId, soaData)) {
-          soaData->zonename = _shorter.makeLowerCase();
-          // Need to invoke foundTarget() with the same variant part in the
-          // first two arguments, since they are compared as ZoneName, hence
-          // the use of `shorter' rather than `_shorter' here.
-          if (foundTarget(target, shorter, qtype, soaData, found)) {
-            return true;
-          }
-
-          found = true;
+      // Jump straight to the closest enclosing zone, instead of probing
+      // every intermediate name which does not exist anyway.
+      ZoneName _shorter(shorter);
+      if (!g_zoneCache.getClosestEntry(d_zoneSuffixes, _shorter, zoneId, view)) {
+        // No zone encloses this name.
+        break;
+      }
+      shorter = ZoneName(_shorter.operator const DNSName&(), shorter.getVariant());
+
+      if (fillSOAFromZoneRecord(_shorter, zoneId, soaData)) {
+        soaData->zonename = _shorter.makeLowerCase();
+        // Need to invoke foundTarget() with the same variant part in the
+        // first two arguments, since they are compared as ZoneName, hence
+        // the use of `shorter' rather than `_shorter' here.
+        if (foundTarget(target, shorter, qtype, soaData, found)) {
+          return true;
         }
 
-        continue;
+        found = true;
       }
 
-      // Zone does not exist, try again with a shorter name.
       continue;
     }
 
@@ -733,7 +735,7 @@ enum UeberBackend::CacheResult UeberBackend::cacheHas(const Question& question,
   resourceRecords.clear();
   //  g_log<<Logger::Warning<<"looking up: '"<<q.qname+"'|N|"+q.qtype.getName()+"|"+itoa(q.zoneId)<<endl;
 
-  bool ret = QC.getEntry(question.qname, question.qtype, resourceRecords, question.zoneId); // think about lowercasing here
+  bool ret = QC.getEntry(d_localQueryCache, question.qname, question.qtype, resourceRecords, question.zoneId); // think about lowercasing here
   if (!ret) {
     return CacheResult::Miss;
   }
@@ -752,7 +754,7 @@ void UeberBackend::addNegCache(const Question& question) const
     return;
   }
   // we should also not be storing negative answers if a pipebackend does scopeMask, but we can't pass a negative scopeMask in an empty set!
-  QC.insert(question.qname, question.qtype, vector<DNSZoneRecord>(), d_negcache_ttl, question.zoneId);
+  QC.insert(d_localQueryCache, question.qname, question.qtype, vector<DNSZoneRecord>(), d_negcache_ttl, question.zoneId);
 }
 
 void UeberBackend::addCache(const Question& question, vector<DNSZoneRecord>&& rrs) const
@@ -769,7 +771,7 @@ void UeberBackend::addCache(const Question& question, vector<DNSZoneRecord>&& rr
     }
   }
 
-  QC.insert(question.qname, question.qtype, std::move(rrs), d_cache_ttl, question.zoneId);
+  QC.insert(d_localQueryCache, question.qname, question.qtype, std::move(rrs), d_cache_ttl, question.zoneId);
 }
 
 void UeberBackend::alsoNotifies(const ZoneName& domain, set<string>* ips)
@@ -29,6 +29,8 @@
 
 #include <boost/utility.hpp>
 
+#include "auth-querycache.hh"
+#include "auth-zonecache.hh"
 #include "dnspacket.hh"
 #include "dnsbackend.hh"
 #include "lock.hh"
@@ -152,6 +154,8 @@ private:
   handle d_handle;
   vector<DNSZoneRecord> d_answers;
   vector<DNSZoneRecord>::const_iterator d_cachehandleiter;
+  LocalStateHolder<AuthZoneCache::ZoneSuffixTree> d_zoneSuffixes{g_zoneCache.getLocalSuffixTree()};
+  mutable AuthQueryCache::LocalCache d_localQueryCache;
 
   static std::mutex d_mut;
   static std::condition_variable d_cond;
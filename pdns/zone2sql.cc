@@ -219,6 +219,7 @@ try
 
     ::arg().set("max-generate-steps", "Maximum number of $GENERATE steps when loading a zone from a file")="0";
     ::arg().set("max-include-depth", "Maximum nested $INCLUDE depth when loading a zone from a file")="20";
+    ::arg().set("parsing-threads", "Number of threads to parse large zone files with, 0 for one per CPU")="1";
 
     ::arg().setCmd("help","Provide a helpful message");
     ::arg().setCmd("version","Print the version");
@@ -302,6 +303,7 @@ try
             ZoneParserTNG zpt(domain.filename, domain.name, BP.getDirectory());
             zpt.setMaxGenerateSteps(::arg().asNum("max-generate-steps"));
             zpt.setMaxIncludes(::arg().asNum("max-include-depth"));
+            zpt.setParallelThreads(::arg().asNum("parsing-threads"));
             DNSResourceRecord rr;
             bool seenSOA=false;
             string comment;
@@ -341,6 +343,7 @@ try
 
       ZoneParserTNG zpt(zonefile, zonename);
       zpt.setMaxGenerateSteps(::arg().asNum("max-generate-steps"));
+      zpt.setParallelThreads(::arg().asNum("parsing-threads"));
       DNSResourceRecord rr;
       startNewTransaction();
       string comment;
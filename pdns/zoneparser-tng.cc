@@ -34,10 +34,95 @@
 #include <boost/algorithm/string.hpp>
 #include <system_error>
 #include <cinttypes>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 #include <sys/stat.h>
 
 const static string g_INstr("IN");
 
+/* size of the chunks a file is split into for parallel parsing, and the number of chunks that
+   can be parsed ahead of the one being returned by get(), per thread */
+static constexpr size_t s_parallelChunkSize = 1024 * 1024;
+static constexpr size_t s_parallelChunksPerThread = 2;
+
+/* where a chunk starts, and the state the parser would have at that point */
+struct ZoneParserTNG::ParallelChunk
+{
+  size_t d_offset;
+  size_t d_length;
+  int d_lineno; // number of lines before the chunk
+  ZoneName d_zonename;
+  int d_defaultttl;
+  bool d_havespecificttl;
+};
+
+struct ZoneParserTNG::ParallelState
+{
+  struct Record
+  {
+    DNSName qname;
+    string content;
+    string comment;
+    QType qtype;
+    uint32_t ttl;
+    int lineno;
+    uint32_t file; // index in the filenames of the chunk, 0 being the zone file itself
+  };
+
+  struct Result
+  {
+    std::vector<Record> records;
+    std::vector<string> filenames;
+    std::exception_ptr error;
+    pair<string, int> errorLineNumAndFile;
+    string errorLineOfFile;
+    bool done{false};
+  };
+
+  ParallelState(string data, string filename) :
+    d_data(std::move(data)), d_filename(std::move(filename))
+  {
+  }
+  ParallelState(const ParallelState&) = delete;
+  ParallelState(ParallelState&&) = delete;
+  ParallelState& operator=(const ParallelState&) = delete;
+  ParallelState& operator=(ParallelState&&) = delete;
+
+  ~ParallelState()
+  {
+    {
+      std::lock_guard<std::mutex> lock(d_lock);
+      d_stop = true;
+    }
+    d_cond.notify_all();
+    for (auto& worker : d_workers) {
+      worker.join();
+    }
+  }
+
+  string d_data;
+  string d_filename;
+  std::vector<ParallelChunk> d_chunks;
+  std::vector<Result> d_results;
+  std::vector<std::thread> d_workers;
+  std::mutex d_lock;
+  std::condition_variable d_cond;
+  size_t d_window{0};
+  /* protected by d_lock */
+  size_t d_nextChunk{0};
+  size_t d_currentChunk{0};
+  bool d_stop{false};
+  /* only used by get() */
+  size_t d_currentRecord{0};
+  int d_lineno{0};
+  const string* d_currentFilename{nullptr};
+  bool d_currentDone{false};
+  bool d_failed{false};
+  pair<string, int> d_errorLineNumAndFile;
+  string d_errorLineOfFile;
+};
+
 ZoneParserTNG::ZoneParserTNG(const string& fname, ZoneName zname, string reldir, bool upgradeContent):
   d_reldir(std::move(reldir)), d_zonename(std::move(zname)), d_defaultttl(3600),
   d_templatecounter(0), d_templatestop(0), d_templatestep(0),
@@ -54,6 +139,15 @@ ZoneParserTNG::ZoneParserTNG(const vector<string>& zonedata, ZoneName zname, boo
   d_zonedataline = d_zonedata.begin();
 }
 
+ZoneParserTNG::ZoneParserTNG(const ZoneParserTNG& parent, const ParallelChunk& chunk, std::string_view data):
+  d_reldir(parent.d_reldir), d_zonename(chunk.d_zonename),
+  d_maxGenerateSteps(parent.d_maxGenerateSteps), d_maxIncludes(parent.d_maxIncludes), d_defaultttl(chunk.d_defaultttl),
+  d_templatecounter(0), d_templatestop(0), d_templatestep(0),
+  d_havespecificttl(chunk.d_havespecificttl), d_fromfile(true), d_generateEnabled(parent.d_generateEnabled), d_upgradeContent(parent.d_upgradeContent)
+{
+  d_filestates.emplace(data, parent.d_parallel->d_filename, chunk.d_lineno);
+}
+
 void ZoneParserTNG::stackFile(const std::string& fname)
 {
   if (d_filestates.size() >= d_maxIncludes) {
@@ -94,8 +188,12 @@ void ZoneParserTNG::stackFile(const std::string& fname)
 
 ZoneParserTNG::~ZoneParserTNG()
 {
+  // stop the workers first, they use our settings
+  d_parallel.reset();
   while(!d_filestates.empty()) {
-    fclose(d_filestates.top().d_fp);
+    if (d_filestates.top().d_fp != nullptr) {
+      fclose(d_filestates.top().d_fp);
+    }
     d_filestates.pop();
   }
 }
@@ -321,6 +419,13 @@ ZoneName ZoneParserTNG::getZoneName()
 
 string ZoneParserTNG::getLineOfFile()
 {
+  if (d_parallel) {
+    if (d_parallel->d_failed) {
+      return d_parallel->d_errorLineOfFile;
+    }
+    return "on line "+std::to_string(d_parallel->d_lineno)+" of file '"+(d_parallel->d_currentFilename != nullptr ? *d_parallel->d_currentFilename : d_parallel->d_filename)+"'";
+  }
+
   if (!d_zonedata.empty())
     return "on line "+std::to_string(std::distance(d_zonedata.begin(), d_zonedataline))+" of given string";
 
@@ -332,6 +437,13 @@ string ZoneParserTNG::getLineOfFile()
 
 pair<string,int> ZoneParserTNG::getLineNumAndFile()
 {
+  if (d_parallel) {
+    if (d_parallel->d_failed) {
+      return d_parallel->d_errorLineNumAndFile;
+    }
+    return {d_parallel->d_currentFilename != nullptr ? *d_parallel->d_currentFilename : d_parallel->d_filename, d_parallel->d_lineno};
+  }
+
   if (d_filestates.empty())
     return {"", 0};
   else
@@ -341,6 +453,13 @@ pair<string,int> ZoneParserTNG::getLineNumAndFile()
 // NOLINTNEXTLINE(readability-function-cognitive-complexity)
 bool ZoneParserTNG::get(DNSResourceRecord& rr, std::string* comment)
 {
+  if (d_parallelThreads != 1) {
+    startParallel();
+  }
+  if (d_parallel) {
+    return getParallel(rr, comment);
+  }
+
  retry:;
   if(!getTemplateLine() && !getLine())
     return false;
@@ -688,12 +807,258 @@ bool ZoneParserTNG::getLine()
     return false;
   }
   while(!d_filestates.empty()) {
-    if(stringfgets(d_filestates.top().d_fp, d_line)) {
-      d_filestates.top().d_lineno++;
+    auto& top = d_filestates.top();
+    if (top.d_fp == nullptr) {
+      if (!top.d_data.empty()) {
+        auto end = top.d_data.find('\n');
+        end = end == std::string_view::npos ? top.d_data.size() : end + 1;
+        d_line.assign(top.d_data.data(), end);
+        top.d_data.remove_prefix(end);
+        top.d_lineno++;
+        return true;
+      }
+    }
+    else if(stringfgets(top.d_fp, d_line)) {
+      top.d_lineno++;
       return true;
     }
-    fclose(d_filestates.top().d_fp);
+    else {
+      fclose(top.d_fp);
+    }
     d_filestates.pop();
   }
   return false;
 }
+
+/* whether the line has an unquoted, unescaped c before any comment, following chopComment() and findAndElide() */
+static bool hasUnquoted(std::string_view line, char c)
+{
+  bool inQuote = false;
+  for (size_t pos = 0; pos < line.size(); ++pos) {
+    if (line[pos] == '\\') {
+      pos++;
+    }
+    else if (line[pos] == '"') {
+      inQuote = !inQuote;
+    }
+    else if (!inQuote && line[pos] == ';') {
+      return false;
+    }
+    else if (!inQuote && line[pos] == c) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void ZoneParserTNG::startParallel()
+{
+  size_t threads = d_parallelThreads != 0 ? d_parallelThreads : std::thread::hardware_concurrency();
+  // whatever happens, we only try once
+  d_parallelThreads = 1;
+  if (threads <= 1 || !d_fromfile || d_filestates.size() != 1 || d_filestates.top().d_fp == nullptr || d_filestates.top().d_lineno != 0 || !d_templateparts.empty()) {
+    return;
+  }
+
+  const auto& top = d_filestates.top();
+  const int fd = fileno(top.d_fp);
+  struct stat st = {};
+  if (fstat(fd, &st) == -1 || static_cast<size_t>(st.st_size) < 2 * s_parallelChunkSize) {
+    return;
+  }
+  /* the file is read rather than mapped, since accessing a mapping of a file that has been
+     truncated in the meantime gets us a SIGBUS. pread() leaves the position of top.d_fp alone,
+     so we can still parse it the usual way if it turns out we can't split it */
+  string contents;
+  contents.resize(static_cast<size_t>(st.st_size));
+  size_t size = 0;
+  while (size < contents.size()) {
+    const auto got = pread(fd, &contents.at(size), contents.size() - size, static_cast<off_t>(size));
+    if (got < 0 && errno == EINTR) {
+      continue;
+    }
+    if (got <= 0) {
+      break;
+    }
+    size += static_cast<size_t>(got);
+  }
+  if (size < contents.size()) {
+    // the file was truncated or could not be read, let the usual code deal with it
+    return;
+  }
+  auto state = std::make_unique<ParallelState>(std::move(contents), top.d_filename);
+
+  /* Split the file at lines holding a record with an explicit owner name, outside of parentheses, so
+     that the only state a chunk depends on is the current $ORIGIN and default TTL. We can't know what
+     an $INCLUDE-d file does to that state, and until a default TTL has been set the TTL of a record
+     depends on the previous one, so we don't split after an $INCLUDE or before a default TTL is known. */
+  const std::string_view data(state->d_data);
+  ZoneName zonename = d_zonename;
+  int defaultttl = d_defaultttl;
+  bool havespecificttl = d_havespecificttl;
+  bool inParens = false;
+  bool canSplit = true;
+  size_t chunkStart = 0;
+  int lineno = 0;
+  state->d_chunks.push_back({0, 0, 0, zonename, defaultttl, havespecificttl});
+
+  for (size_t pos = 0; pos < data.size() && canSplit; lineno++) {
+    auto end = data.find('\n', pos);
+    end = end == std::string_view::npos ? data.size() : end + 1;
+    const auto line = data.substr(pos, end - pos);
+    const auto lineStart = pos;
+    pos = end;
+
+    if (inParens) {
+      inParens = line.find(')') == std::string_view::npos || !hasUnquoted(line, ')');
+      continue;
+    }
+    if (line[0] == '$') {
+      string directive(line);
+      boost::trim_right_if(directive, boost::is_any_of(" \t\r\n\x1a"));
+      parts_t parts;
+      vstringtok(parts, directive);
+      if (parts.size() < 2) {
+        canSplit = false;
+        break;
+      }
+      const string command = makeString(directive, parts[0]);
+      try {
+        if (pdns_iequals(command, "$TTL")) {
+          defaultttl = static_cast<int>(makeTTLFromZone(trim_right_copy_if(makeString(directive, parts[1]), boost::is_any_of(";"))));
+          havespecificttl = true;
+        }
+        else if (pdns_iequals(command, "$ORIGIN")) {
+          zonename = ZoneName(makeString(directive, parts[1]));
+        }
+        else if (!pdns_iequals(command, "$GENERATE")) {
+          canSplit = false;
+        }
+      }
+      catch (...) {
+        // let the parser of that chunk report it
+        canSplit = false;
+      }
+      continue;
+    }
+    if (line[0] != ';' && !dns_isspace(line[0]) && havespecificttl && lineStart - chunkStart >= s_parallelChunkSize) {
+      state->d_chunks.back().d_length = lineStart - chunkStart;
+      state->d_chunks.push_back({lineStart, 0, lineno, zonename, defaultttl, havespecificttl});
+      chunkStart = lineStart;
+    }
+    inParens = line.find('(') != std::string_view::npos && hasUnquoted(line, '(') && !hasUnquoted(line, ')');
+  }
+  state->d_chunks.back().d_length = data.size() - chunkStart;
+
+  if (state->d_chunks.size() < 2) {
+    return;
+  }
+
+  state->d_results.resize(state->d_chunks.size());
+  state->d_window = threads * s_parallelChunksPerThread;
+  threads = std::min(threads, state->d_chunks.size());
+  d_parallel = std::move(state);
+  for (size_t idx = 0; idx < threads; idx++) {
+    d_parallel->d_workers.emplace_back([this]() { parseParallelChunks(*d_parallel); });
+  }
+}
+
+void ZoneParserTNG::parseParallelChunks(ParallelState& state) const
+{
+  for (;;) {
+    size_t idx = 0;
+    {
+      std::unique_lock<std::mutex> lock(state.d_lock);
+      state.d_cond.wait(lock, [&state]() {
+        return state.d_stop || state.d_nextChunk >= state.d_chunks.size() || state.d_nextChunk < state.d_currentChunk + state.d_window;
+      });
+      if (state.d_stop || state.d_nextChunk >= state.d_chunks.size()) {
+        return;
+      }
+      idx = state.d_nextChunk++;
+    }
+
+    const auto& chunk = state.d_chunks.at(idx);
+    ParallelState::Result result;
+    ZoneParserTNG parser(*this, chunk, std::string_view(state.d_data).substr(chunk.d_offset, chunk.d_length));
+    result.filenames.push_back(state.d_filename);
+    try {
+      DNSResourceRecord rr;
+      string comment;
+      uint32_t file = 0;
+      while (parser.get(rr, &comment)) {
+        int lineno = chunk.d_lineno;
+        if (!parser.d_filestates.empty()) {
+          /* records from an $INCLUDE-d file report its name and their line in it, as when parsing serially */
+          const auto& top = parser.d_filestates.top();
+          if (top.d_filename != result.filenames.at(file)) {
+            const auto known = std::find(result.filenames.begin(), result.filenames.end(), top.d_filename);
+            file = static_cast<uint32_t>(known - result.filenames.begin());
+            if (known == result.filenames.end()) {
+              result.filenames.push_back(top.d_filename);
+            }
+          }
+          lineno = top.d_lineno;
+        }
+        result.records.push_back({std::move(rr.qname), std::move(rr.content), std::move(comment), rr.qtype, rr.ttl, lineno, file});
+      }
+    }
+    catch (...) {
+      result.error = std::current_exception();
+      result.errorLineNumAndFile = parser.getLineNumAndFile();
+      result.errorLineOfFile = parser.getLineOfFile();
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(state.d_lock);
+      state.d_results.at(idx) = std::move(result);
+      state.d_results.at(idx).done = true;
+    }
+    state.d_cond.notify_all();
+  }
+}
+
+bool ZoneParserTNG::getParallel(DNSResourceRecord& rr, std::string* comment)
+{
+  auto& state = *d_parallel;
+  while (state.d_currentChunk < state.d_chunks.size()) {
+    auto& result = state.d_results.at(state.d_currentChunk);
+    if (!state.d_currentDone) {
+      std::unique_lock<std::mutex> lock(state.d_lock);
+      state.d_cond.wait(lock, [&result]() { return result.done; });
+      state.d_currentDone = true;
+    }
+
+    if (state.d_currentRecord < result.records.size()) {
+      auto& record = result.records.at(state.d_currentRecord++);
+      rr.qname = std::move(record.qname);
+      rr.content = std::move(record.content);
+      rr.qtype = record.qtype;
+      rr.ttl = record.ttl;
+      if (comment != nullptr) {
+        *comment = std::move(record.comment);
+      }
+      state.d_lineno = record.lineno;
+      state.d_currentFilename = &result.filenames.at(record.file);
+      return true;
+    }
+
+    auto error = result.error;
+    {
+      std::lock_guard<std::mutex> lock(state.d_lock);
+      std::vector<ParallelState::Record>().swap(result.records);
+      state.d_currentChunk = error ? state.d_chunks.size() : state.d_currentChunk + 1;
+    }
+    state.d_cond.notify_all();
+    state.d_currentRecord = 0;
+    state.d_currentDone = false;
+
+    if (error) {
+      state.d_failed = true;
+      state.d_errorLineNumAndFile = std::move(result.errorLineNumAndFile);
+      state.d_errorLineOfFile = std::move(result.errorLineOfFile);
+      std::rethrow_exception(error);
+    }
+  }
+  return false;
+}
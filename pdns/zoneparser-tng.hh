@@ -25,6 +25,8 @@
 #include <stdexcept>
 #include <stack>
 #include <deque>
+#include <memory>
+#include <string_view>
 
 #include "namespaces.hh"
 
@@ -58,7 +60,23 @@ public:
     d_defaultttl = ttl;
     d_havespecificttl = true;
   }
+  /* Parse the file on this many threads (0 means one per CPU). The file is read in memory and split
+     at records that do not depend on the previous one, every chunk being parsed by its own parser, and
+     records are still returned in file order. Has to be called before the first call to get(), only
+     applies to files and is ignored for small ones. */
+  void setParallelThreads(size_t threads)
+  {
+    d_parallelThreads = threads;
+  }
 private:
+  struct ParallelState;
+  struct ParallelChunk;
+
+  ZoneParserTNG(const ZoneParserTNG& parent, const ParallelChunk& chunk, std::string_view data);
+  void startParallel();
+  bool getParallel(DNSResourceRecord& rr, std::string* comment);
+  void parseParallelChunks(ParallelState& state) const;
+
   bool getLine();
   bool getTemplateLine();
   void stackFile(const std::string& fname);
@@ -67,7 +85,10 @@ private:
   struct filestate {
     filestate(FILE* fp, string filename) :
       d_fp(fp), d_filename(std::move(filename)) {}
+    filestate(std::string_view data, string filename, int lineno) :
+      d_fp(nullptr), d_data(data), d_filename(std::move(filename)), d_lineno(lineno) {}
     FILE *d_fp;
+    std::string_view d_data; // remaining lines of an in-memory chunk, when d_fp is nullptr
     string d_filename;
     int d_lineno{0};
   };
@@ -82,6 +103,8 @@ private:
   vector<string>::iterator d_zonedataline;
   std::stack<filestate> d_filestates;
   parts_t d_templateparts;
+  std::unique_ptr<ParallelState> d_parallel;
+  size_t d_parallelThreads{1};
   size_t d_maxGenerateSteps{0};
   size_t d_maxIncludes{20};
   int d_defaultttl;
@@ -0,0 +1,141 @@
+import dns
+import dns.zone
+import os
+import socket
+import struct
+import subprocess
+
+from authtests import AuthTest
+
+class AXFRStreamingTest(AuthTest):
+    _backend = 'bind'
+
+    def readAXFR(self, zone, timeout=10.0):
+        """
+        Sends an AXFR query and returns the list of records received and
+        whether the transfer was complete (SOA-wrapped), reading until the
+        final SOA or until the server closes the connection.
+        """
+        query = dns.message.make_query(zone, 'AXFR')
+        wire = query.to_wire()
+        sock = socket.create_connection(("127.0.0.1", self._authPort), timeout=timeout)
+        records = []
+        messages = 0
+        complete = False
+        try:
+            sock.sendall(struct.pack("!H", len(wire)) + wire)
+            soaCount = 0
+            while soaCount < 2:
+                data = self.recvExactly(sock, 2)
+                if data is None:
+                    break
+                (datalen,) = struct.unpack("!H", data)
+                data = self.recvExactly(sock, datalen)
+                if data is None:
+                    break
+                message = dns.message.from_wire(data)
+                self.assertRcodeEqual(message, dns.rcode.NOERROR)
+                messages += 1
+                for rrset in message.answer:
+                    for rdata in rrset:
+                        if rrset.rdtype == dns.rdatatype.SOA:
+                            soaCount += 1
+                        records.append((rrset.name, rrset.rdtype, rdata))
+            complete = soaCount == 2
+        finally:
+            sock.close()
+        return records, messages, complete
+
+    @staticmethod
+    def recvExactly(sock, length):
+        data = b''
+        while len(data) < length:
+            chunk = sock.recv(length - len(data))
+            if not chunk:
+                return None
+            data += chunk
+        return data
+
+    def getStat(self, name):
+        pdnscontrolCmd = [os.environ['PDNSCONTROL'],
+                          '--socket-dir=%s' % os.path.join('configs', self._confdir),
+                          'show',
+                          name]
+        return int(subprocess.check_output(pdnscontrolCmd, stderr=subprocess.STDOUT))
+
+def generateHosts(count):
+    return ''.join(['host%04d.example.org. 3600 IN A 192.0.2.%d\n' % (idx, idx % 250 + 1) for idx in range(count)])
+
+class TestAXFRStreaming(AXFRStreamingTest):
+    _config_template = """
+outgoing-axfr-streaming=yes
+"""
+
+    _hostsCount = 1000
+
+    _zones = {
+        'example.org': """
+example.org.                 3600 IN SOA    {soa}
+example.org.                 3600 IN NS     ns1.example.org.
+example.org.                 3600 IN NS     ns2.example.org.
+ns1.example.org.             3600 IN A      {prefix}.10
+ns2.example.org.             3600 IN A      {prefix}.11
+www.example.org.             3600 IN HTTPS  1 . ipv4hint=auto
+www.example.org.             3600 IN A      192.0.2.80
+sub.example.org.             3600 IN NS     ns.sub.example.org.
+ns.sub.example.org.          3600 IN A      192.0.2.53
+""" + generateHosts(_hostsCount),
+    }
+
+    def testStreamedAXFR(self):
+        records, messages, complete = self.readAXFR('example.org')
+
+        self.assertTrue(complete)
+        self.assertEqual(records[0][1], dns.rdatatype.SOA)
+        self.assertEqual(records[-1][1], dns.rdatatype.SOA)
+        # the records were sent in several chunks
+        self.assertGreater(messages, 2)
+
+        # the automatic hint is filled in
+        zonetext = self._zones['example.org'].format(prefix=self._PREFIX, soa=self._SOA).replace('ipv4hint=auto', 'ipv4hint=192.0.2.80')
+        zone = dns.zone.from_text(zonetext, origin='example.org.', relativize=False)
+        expected = [(name, rdataset.rdtype, rdata) for name, rdataset in zone.iterate_rdatasets() for rdata in rdataset]
+        key = lambda rr: (rr[0], rr[1], rr[2].to_text())
+        self.assertEqual(sorted(records[:-1], key=key), sorted(expected, key=key))
+
+        # and were not all held in memory at once
+        self.assertLess(self.getStat('xfr-out-peak-records'), self._hostsCount)
+
+class TestAXFRStreamingAliasFailure(AXFRStreamingTest):
+    # nothing listens on the resolver address, so the ALIAS target cannot be resolved
+    _config_template = """
+outgoing-axfr-streaming=yes
+outgoing-axfr-expand-alias=yes
+resolver=%s.1:5399
+"""
+
+    _config_params = ['_PREFIX']
+
+    _zones = {
+        'example.org': """
+example.org.                 3600 IN SOA    {soa}
+example.org.                 3600 IN NS     ns1.example.org.
+ns1.example.org.             3600 IN A      {prefix}.10
+zzz.example.org.             3600 IN ALIAS  alias.example.com.
+""" + generateHosts(500),
+    }
+
+    def testAbortedStreamedAXFR(self):
+        records, messages, complete = self.readAXFR('example.org', timeout=30.0)
+
+        # records were sent before the ALIAS was reached, then the connection was
+        # closed without the final SOA, and without a SERVFAIL
+        self.assertFalse(complete)
+        self.assertGreater(len(records), 1)
+        self.assertEqual(records[0][1], dns.rdatatype.SOA)
+        self.assertNotIn(dns.rdatatype.SOA, [rr[1] for rr in records[1:]])
+
+        # the server is still answering
+        query = dns.message.make_query('host0001.example.org', 'A')
+        res = self.sendUDPQuery(query)
+        self.assertRcodeEqual(res, dns.rcode.NOERROR)
@@ -0,0 +1,172 @@
+import dns
+import dns.zone
+import os
+import socket
+import struct
+import subprocess
+
+from authtests import AuthTest
+
+class TestBindCompactStorage(AuthTest):
+    _backend = 'bind'
+    _config_template = """
+bind-compact-storage=yes
+"""
+
+    _zones = {
+        'example.org': """
+example.org.                 3600 IN SOA    {soa}
+example.org.                 3600 IN NS     ns1.example.org.
+example.org.                 3600 IN NS     ns2.example.org.
+example.org.                 3600 IN MX     10 mail.example.org.
+ns1.example.org.             3600 IN A      {prefix}.10
+ns2.example.org.             3600 IN A      {prefix}.11
+mail.example.org.            3600 IN A      192.0.2.25
+mail.example.org.            3600 IN AAAA   2001:db8::25
+www.example.org.             3600 IN CNAME  web.example.org.
+web.example.org.             3600 IN A      192.0.2.80
+web.example.org.             3600 IN A      192.0.2.81
+Z.example.org.               3600 IN TXT    "last"
+a.b.example.org.             3600 IN TXT    "deep"
+\\001.example.org.           3600 IN TXT    "escaped"
+*.wild.example.org.          3600 IN TXT    "wildcard"
+sub.example.org.             3600 IN NS     ns.sub.example.org.
+ns.sub.example.org.          3600 IN A      192.0.2.53
+        """,
+    }
+
+    def getAXFR(self, zone):
+        query = dns.message.make_query(zone, 'AXFR')
+        wire = query.to_wire()
+        sock = socket.create_connection(("127.0.0.1", self._authPort), timeout=2.0)
+        records = []
+        try:
+            sock.sendall(struct.pack("!H", len(wire)) + wire)
+            soaCount = 0
+            while soaCount < 2:
+                data = self.recvExactly(sock, 2)
+                (datalen,) = struct.unpack("!H", data)
+                message = dns.message.from_wire(self.recvExactly(sock, datalen))
+                self.assertRcodeEqual(message, dns.rcode.NOERROR)
+                for rrset in message.answer:
+                    for rdata in rrset:
+                        if rrset.rdtype == dns.rdatatype.SOA:
+                            soaCount += 1
+                        records.append((rrset.name, rrset.rdtype, rdata))
+        finally:
+            sock.close()
+        return records
+
+    @staticmethod
+    def recvExactly(sock, length):
+        data = b''
+        while len(data) < length:
+            chunk = sock.recv(length - len(data))
+            if not chunk:
+                raise AssertionError('Connection closed while reading %d bytes' % (length))
+            data += chunk
+        return data
+
+    def pdnsControl(self, *args):
+        pdnscontrolCmd = [os.environ['PDNSCONTROL'],
+                          '--socket-dir=%s' % os.path.join('configs', self._confdir)] + list(args)
+        print(' '.join(pdnscontrolCmd))
+        return subprocess.check_output(pdnscontrolCmd, stderr=subprocess.STDOUT)
+
+    def reloadZone(self, zone, content):
+        self.generateAuthZone(os.path.join('configs', self._confdir), zone, content)
+        output = self.pdnsControl('bind-reload-now', zone)
+        self.assertIn(b'parsed into memory', output)
+
+    def testCompactStorageIsUsed(self):
+        output = self.pdnsControl('bind-domain-extended-status', 'example.org')
+        self.assertIn(b'Storage: compact', output)
+        self.assertIn(b'Number of records: 17', output)
+
+    def testLookup(self):
+        query = dns.message.make_query('web.example.org', 'A')
+        res = self.sendUDPQuery(query)
+        expected = dns.rrset.from_text('web.example.org.', 3600, dns.rdataclass.IN, 'A', '192.0.2.80', '192.0.2.81')
+        self.assertRcodeEqual(res, dns.rcode.NOERROR)
+        self.assertRRsetInAnswer(res, expected)
+
+        # names are matched case-insensitively, and only the requested type is returned
+        query = dns.message.make_query('MAIL.Example.ORG', 'AAAA')
+        res = self.sendUDPQuery(query)
+        self.assertRcodeEqual(res, dns.rcode.NOERROR)
+        self.assertEqual(len(res.answer), 1)
+        self.assertEqual(res.answer[0].rdtype, dns.rdatatype.AAAA)
+
+        query = dns.message.make_query('\\001.example.org', 'TXT')
+        res = self.sendUDPQuery(query)
+        expected = dns.rrset.from_text('\\001.example.org.', 3600, dns.rdataclass.IN, 'TXT', '"escaped"')
+        self.assertRcodeEqual(res, dns.rcode.NOERROR)
+        self.assertRRsetInAnswer(res, expected)
+
+        query = dns.message.make_query('www.example.org', 'A')
+        res = self.sendUDPQuery(query)
+        self.assertRcodeEqual(res, dns.rcode.NOERROR)
+        self.assertRRsetInAnswer(res, dns.rrset.from_text('www.example.org.', 3600, dns.rdataclass.IN, 'CNAME', 'web.example.org.'))
+        self.assertRRsetInAnswer(res, dns.rrset.from_text('web.example.org.', 3600, dns.rdataclass.IN, 'A', '192.0.2.80', '192.0.2.81'))
+
+        query = dns.message.make_query('anything.wild.example.org', 'TXT')
+        res = self.sendUDPQuery(query)
+        self.assertRcodeEqual(res, dns.rcode.NOERROR)
+        self.assertRRsetInAnswer(res, dns.rrset.from_text('anything.wild.example.org.', 3600, dns.rdataclass.IN, 'TXT', '"wildcard"'))
+
+        query = dns.message.make_query('nonexistent.example.org', 'A')
+        res = self.sendUDPQuery(query)
+        self.assertRcodeEqual(res, dns.rcode.NXDOMAIN)
+
+        query = dns.message.make_query('host.sub.example.org', 'A')
+        res = self.sendUDPQuery(query)
+        self.assertRcodeEqual(res, dns.rcode.NOERROR)
+        self.assertEqual(len(res.answer), 0)
+        self.assertRRsetInAuthority(res, dns.rrset.from_text('sub.example.org.', 3600, dns.rdataclass.IN, 'NS', 'ns.sub.example.org.'))
+
+    def testAXFR(self):
+        records = self.getAXFR('example.org')
+
+        self.assertEqual(records[0][1], dns.rdatatype.SOA)
+        self.assertEqual(records[-1][1], dns.rdatatype.SOA)
+        records = records[:-1]
+
+        zone = dns.zone.from_text(self._zones['example.org'].format(prefix=self._PREFIX, soa=self._SOA), origin='example.org.', relativize=False)
+        expected = sorted([(name, rdataset.rdtype, rdata) for name, rdataset in zone.iterate_rdatasets() for rdata in rdataset], key=lambda rr: (rr[0], rr[1], rr[2].to_text()))
+        self.assertEqual(sorted(records, key=lambda rr: (rr[0], rr[1], rr[2].to_text())), expected)
+
+        # the compact storage lists the names of the zone in canonical order
+        names = [rr[0] for rr in records]
+        self.assertEqual(names, sorted(names))
+
+    def testReload(self):
+        self.reloadZone('example.org', """
+example.org.                 3600 IN SOA    ns1.example.net. hostmaster.example.net. 2 3600 1800 1209600 300
+example.org.                 3600 IN NS     ns1.example.org.
+example.org.                 3600 IN NS     ns2.example.org.
+ns1.example.org.             3600 IN A      {prefix}.10
+ns2.example.org.             3600 IN A      {prefix}.11
+web.example.org.             3600 IN A      192.0.2.82
+new.example.org.             3600 IN A      192.0.2.83
+        """)
+        try:
+            query = dns.message.make_query('web.example.org', 'A')
+            res = self.sendUDPQuery(query)
+            self.assertRcodeEqual(res, dns.rcode.NOERROR)
+            self.assertRRsetInAnswer(res, dns.rrset.from_text('web.example.org.', 3600, dns.rdataclass.IN, 'A', '192.0.2.82'))
+
+            query = dns.message.make_query('new.example.org', 'A')
+            res = self.sendUDPQuery(query)
+            self.assertRcodeEqual(res, dns.rcode.NOERROR)
+            self.assertRRsetInAnswer(res, dns.rrset.from_text('new.example.org.', 3600, dns.rdataclass.IN, 'A', '192.0.2.83'))
+
+            query = dns.message.make_query('mail.example.org', 'A')
+            res = self.sendUDPQuery(query)
+            self.assertRcodeEqual(res, dns.rcode.NXDOMAIN)
+
+            records = self.getAXFR('example.org')
+            # SOA-wrapped
+            self.assertEqual(len(records), 8)
+            self.assertEqual(records[0][2].serial, 2)
+        finally:
+            self.reloadZone('example.org', self._zones['example.org'])
@@ -0,0 +1,90 @@
+import dns
+import dns.flags
+import os
+import subprocess
+
+from authtests import AuthTest
+
+class TestGSQLGetAuth(AuthTest):
+    _backend = 'gsqlite3'
+
+    _config_template = """
+launch=gsqlite3
+gsqlite3-database=configs/auth/powerdns.sqlite
+"""
+
+    _zones = {
+        'example.org': """
+example.org.                 3600 IN SOA    {soa}
+example.org.                 3600 IN NS     ns1.example.org.
+ns1.example.org.             3600 IN A      {prefix}.10
+www.example.org.             3600 IN A      192.0.2.1
+a.b.c.d.e.f.g.h.example.org. 3600 IN A      192.0.2.2
+        """,
+        'sub.example.org': """
+sub.example.org.             3600 IN SOA    {soa}
+sub.example.org.             3600 IN NS     ns1.example.org.
+www.sub.example.org.         3600 IN A      192.0.2.3
+a.b.c.d.e.f.g.h.i.sub.example.org. 3600 IN A 192.0.2.4
+        """,
+    }
+
+    @classmethod
+    def generateAllAuthConfig(cls, confdir):
+        super(TestGSQLGetAuth, cls).generateAllAuthConfig(confdir)
+
+        for zonename, zonecontent in cls._zones.items():
+            cls.generateAuthZone(confdir, zonename, zonecontent)
+            pdnsutilCmd = [os.environ['PDNSUTIL'],
+                           '--config-dir=%s' % confdir,
+                           'load-zone',
+                           zonename,
+                           os.path.join(confdir, '%s.zone' % zonename)]
+
+            print(' '.join(pdnsutilCmd))
+            try:
+                subprocess.check_output(pdnsutilCmd, stderr=subprocess.STDOUT)
+            except subprocess.CalledProcessError as e:
+                raise AssertionError('%s failed (%d): %s' % (pdnsutilCmd, e.returncode, e.output))
+
+    def getBackendQueries(self):
+        pdnscontrolCmd = [os.environ['PDNSCONTROL'],
+                          '--socket-dir=%s' % os.path.join('configs', self._confdir),
+                          'show',
+                          'backend-queries']
+        return int(subprocess.check_output(pdnscontrolCmd, stderr=subprocess.STDOUT))
+
+    def checkAnswer(self, name, address, zone):
+        query = dns.message.make_query(name, 'A')
+        res = self.sendUDPQuery(query)
+        self.assertRcodeEqual(res, dns.rcode.NOERROR)
+        self.assertTrue(res.flags & dns.flags.AA)
+        self.assertRRsetInAnswer(res, dns.rrset.from_text(name, 3600, dns.rdataclass.IN, 'A', address))
+
+        query = dns.message.make_query('nonexistent.' + name, 'A')
+        res = self.sendUDPQuery(query)
+        self.assertRcodeEqual(res, dns.rcode.NXDOMAIN)
+        self.assertEqual(len(res.authority), 1)
+        self.assertEqual(res.authority[0].rdtype, dns.rdatatype.SOA)
+        self.assertEqual(res.authority[0].name, dns.name.from_text(zone))
+
+    def testClosestZone(self):
+        self.checkAnswer('www.example.org.', '192.0.2.1', 'example.org.')
+        self.checkAnswer('www.sub.example.org.', '192.0.2.3', 'sub.example.org.')
+
+    def testMoreLabelsThanOneQuery(self):
+        # the zone is only found in the second batch of names
+        self.checkAnswer('a.b.c.d.e.f.g.h.example.org.', '192.0.2.2', 'example.org.')
+        self.checkAnswer('a.b.c.d.e.f.g.h.i.sub.example.org.', '192.0.2.4', 'sub.example.org.')
+
+    def testBackendQueriesAreCounted(self):
+        before = self.getBackendQueries()
+        query = dns.message.make_query('www.sub.example.org.', 'A')
+        res = self.sendUDPQuery(query)
+        self.assertRcodeEqual(res, dns.rcode.NOERROR)
+        self.assertGreater(self.getBackendQueries(), before)
+
+    def testNoZone(self):
+        query = dns.message.make_query('www.example.net.', 'A')
+        res = self.sendUDPQuery(query)
+        self.assertRcodeEqual(res, dns.rcode.REFUSED)
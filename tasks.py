@@ -983,7 +983,9 @@ backend_regress_tests = dict(
         'bind-dnssec-nsec3-both',
         'bind-dnssec-nsec3-optout-both',
         'bind-dnssec-nsec3-narrow',
-        'bind-dnssec-pkcs11'
+        'bind-dnssec-pkcs11',
+        'bind-compact-both',
+        'bind-dnssec-nsec3-compact-both'
     ],
     geoip = [
         'geoip',